@@ -34,6 +34,10 @@ void export_CtcDeriv(py::module& m, py::class_<DynCtc, pyDynCtc>& dyn_ctc)
     .def(py::init<>(),
       CTCDERIV_CTCDERIV)
 
+    .def("set_fused_sweep", &CtcDeriv::set_fused_sweep,
+      CTCDERIV_VOID_SET_FUSED_SWEEP_BOOL,
+      "fused"_a=true)
+
     .def("contract", (void (CtcDeriv::*)(Tube&,const Tube&,TimePropag))&CtcDeriv::contract,
       CTCDERIV_VOID_CONTRACT_TUBE_TUBE_TIMEPROPAG,
       "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD)
@@ -35,6 +35,17 @@ void export_CtcLohner(py::module& m, py::class_<DynCtc, pyDynCtc>& dyn_ctc)
       CTCLOHNER_CTCLOHNER_FUNCTION_INT_DOUBLE,
       "f"_a, "contractions"_a=5, "eps"_a=0.1)
 
+    .def("set_order", &CtcLohner::set_order,
+      CTCLOHNER_VOID_SET_ORDER_INT,
+      "order"_a)
+
+    .def("order", &CtcLohner::order,
+      CTCLOHNER_INT_ORDER)
+
+    .def("set_adaptive_step", &CtcLohner::set_adaptive_step,
+      CTCLOHNER_VOID_SET_ADAPTIVE_STEP_BOOL_DOUBLE,
+      "adaptive"_a=true, "tol"_a=1e-3)
+
     .def("contract", (void (CtcLohner::*)(TubeVector&,TimePropag) )&CtcLohner::contract,
       CTCLOHNER_VOID_CONTRACT_TUBEVECTOR_TIMEPROPAG,
       "x"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD)
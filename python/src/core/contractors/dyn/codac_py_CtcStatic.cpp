@@ -42,5 +42,12 @@ void export_CtcStatic(py::module& m, py::class_<DynCtc, pyDynCtc>& dyn_ctc)
     .def("contract", (void (CtcStatic::*)(TubeVector&) )&CtcStatic::contract,
       CTCSTATIC_VOID_CONTRACT_TUBEVECTOR,
       "x"_a.noconvert())
+
+    .def("set_nb_threads", &CtcStatic::set_nb_threads,
+      CTCSTATIC_VOID_SET_NB_THREADS_INT,
+      "nb_threads"_a=0)
+
+    .def("nb_threads", &CtcStatic::nb_threads,
+      CTCSTATIC_INT_NB_THREADS)
   ;
 }
\ No newline at end of file
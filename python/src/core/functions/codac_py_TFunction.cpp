@@ -139,6 +139,13 @@ void export_TFunction(py::module& m, py::class_<TFnc>& fnc)
     .def("diff", &TFunction::diff,
       TFUNCTION_CONSTTFUNCTION_DIFF)
 
+    .def("set_nb_threads", &TFunction::set_nb_threads,
+      TFUNCTION_VOID_SET_NB_THREADS_INT,
+      "nb_threads"_a=0)
+
+    .def("nb_threads", &TFunction::nb_threads,
+      TFUNCTION_INT_NB_THREADS)
+
   // Python vector methods
 
     .def("__getitem__", [](TFunction& s, size_t index)
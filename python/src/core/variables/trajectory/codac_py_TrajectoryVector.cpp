@@ -268,6 +268,7 @@ void export_TrajectoryVector(py::module& m)
       {
         if(index >= static_cast<size_t>(s.size()))
           throw py::index_error();
+        s.unshare_timebase(); // the returned component may be modified
         return s[static_cast<int>(index)];
       },
       TRAJECTORYVECTOR_TRAJECTORY_OPERATORB_INT,
@@ -293,6 +294,7 @@ void export_TrajectoryVector(py::module& m)
       {
         if(index >= static_cast<size_t>(s.size()))
           throw py::index_error();
+        s.unshare_timebase();
         s[static_cast<int>(index)] = t;
       },
       TRAJECTORYVECTOR_TRAJECTORY_OPERATORB_INT)
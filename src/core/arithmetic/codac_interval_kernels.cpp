@@ -0,0 +1,370 @@
+/**
+ *  Vectorized arithmetic operations on arrays of intervals
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <cfenv>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include "codac_interval_kernels.h"
+
+#if defined(__AVX__) || defined(__AVX512F__)
+  #include <immintrin.h>
+#endif
+
+// Bounds are computed in the current rounding mode
+// (GCC: -frounding-math is set for this file in CMake)
+#if defined(_MSC_VER)
+  #pragma fenv_access (on)
+#elif defined(__clang__)
+  #pragma STDC FENV_ACCESS ON
+#endif
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // IntervalArray
+
+  IntervalArray::IntervalArray(size_t n, const Interval& x)
+    : lb(n, x.is_empty() ? numeric_limits<double>::quiet_NaN() : x.lb()),
+      ub(n, x.is_empty() ? numeric_limits<double>::quiet_NaN() : x.ub())
+  {
+
+  }
+
+  size_t IntervalArray::size() const
+  {
+    return lb.size();
+  }
+
+  const Interval IntervalArray::get(size_t i) const
+  {
+    assert(i < size());
+    if(std::isnan(lb[i]) || std::isnan(ub[i]))
+      return Interval::EMPTY_SET;
+    return Interval(lb[i], ub[i]);
+  }
+
+  void IntervalArray::set(size_t i, const Interval& x)
+  {
+    assert(i < size());
+    lb[i] = x.is_empty() ? numeric_limits<double>::quiet_NaN() : x.lb();
+    ub[i] = x.is_empty() ? numeric_limits<double>::quiet_NaN() : x.ub();
+  }
+
+  // Packs of doubles, processed by the same instructions
+
+  struct ScalarPack
+  {
+    typedef double type;
+    static constexpr size_t size = 1;
+    static type load(const double *p) { return *p; }
+    static type set1(double x) { return x; }
+    static void store(double *p, type x) { *p = x; }
+    static type zero() { return 0.; }
+    static type add(type x, type y) { return x + y; }
+    static type sub(type x, type y) { return x - y; }
+    static type mul(type x, type y) { return x * y; }
+    static type div(type x, type y) { return x / y; }
+    static type min(type x, type y) { return x < y ? x : y; } // same as SIMD min
+    static type max(type x, type y) { return x > y ? x : y; } // same as SIMD max
+    static type sqrt(type x) { return std::sqrt(x); }
+  };
+
+  #if defined(__AVX__)
+  struct AvxPack
+  {
+    typedef __m256d type;
+    static constexpr size_t size = 4;
+    static type load(const double *p) { return _mm256_loadu_pd(p); }
+    static type set1(double x) { return _mm256_set1_pd(x); }
+    static void store(double *p, type x) { _mm256_storeu_pd(p, x); }
+    static type zero() { return _mm256_setzero_pd(); }
+    static type add(type x, type y) { return _mm256_add_pd(x, y); }
+    static type sub(type x, type y) { return _mm256_sub_pd(x, y); }
+    static type mul(type x, type y) { return _mm256_mul_pd(x, y); }
+    static type div(type x, type y) { return _mm256_div_pd(x, y); }
+    static type min(type x, type y) { return _mm256_min_pd(x, y); }
+    static type max(type x, type y) { return _mm256_max_pd(x, y); }
+    static type sqrt(type x) { return _mm256_sqrt_pd(x); }
+  };
+  #endif
+
+  #if defined(__AVX512F__)
+  struct Avx512Pack
+  {
+    typedef __m512d type;
+    static constexpr size_t size = 8;
+    static type load(const double *p) { return _mm512_loadu_pd(p); }
+    static type set1(double x) { return _mm512_set1_pd(x); }
+    static void store(double *p, type x) { _mm512_storeu_pd(p, x); }
+    static type zero() { return _mm512_setzero_pd(); }
+    static type add(type x, type y) { return _mm512_add_pd(x, y); }
+    static type sub(type x, type y) { return _mm512_sub_pd(x, y); }
+    static type mul(type x, type y) { return _mm512_mul_pd(x, y); }
+    static type div(type x, type y) { return _mm512_div_pd(x, y); }
+    static type min(type x, type y) { return _mm512_min_pd(x, y); }
+    static type max(type x, type y) { return _mm512_max_pd(x, y); }
+    static type sqrt(type x) { return _mm512_sqrt_pd(x); }
+  };
+  #endif
+
+  // Kernels: a bound is computed in the rounding mode towards it,
+  // for operands that are bounded (other ones are computed by the Interval operators)
+
+  static bool bounded(double xl, double xu, double yl, double yu)
+  {
+    return std::isfinite(xl) && std::isfinite(xu) && std::isfinite(yl) && std::isfinite(yu);
+  }
+
+  struct AddKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type yl, typename P::type yu)
+    {
+      return UB ? P::add(xu, yu) : P::add(xl, yl);
+    }
+
+    static bool processed(double xl, double xu, double yl, double yu) { return bounded(xl, xu, yl, yu); }
+    static const Interval eval(const Interval& x, const Interval& y) { return x + y; }
+  };
+
+  struct SubKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type yl, typename P::type yu)
+    {
+      return UB ? P::sub(xu, yl) : P::sub(xl, yu);
+    }
+
+    static bool processed(double xl, double xu, double yl, double yu) { return bounded(xl, xu, yl, yu); }
+    static const Interval eval(const Interval& x, const Interval& y) { return x - y; }
+  };
+
+  struct MulKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type yl, typename P::type yu)
+    {
+      typename P::type a = P::mul(xl, yl), b = P::mul(xl, yu), c = P::mul(xu, yl), d = P::mul(xu, yu);
+      return UB ? P::max(P::max(a, b), P::max(c, d)) : P::min(P::min(a, b), P::min(c, d));
+    }
+
+    static bool processed(double xl, double xu, double yl, double yu) { return bounded(xl, xu, yl, yu); }
+    static const Interval eval(const Interval& x, const Interval& y) { return x * y; }
+  };
+
+  struct DivKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type yl, typename P::type yu)
+    {
+      typename P::type a = P::div(xl, yl), b = P::div(xl, yu), c = P::div(xu, yl), d = P::div(xu, yu);
+      return UB ? P::max(P::max(a, b), P::max(c, d)) : P::min(P::min(a, b), P::min(c, d));
+    }
+
+    static bool processed(double xl, double xu, double yl, double yu) { return bounded(xl, xu, yl, yu) && (yl > 0. || yu < 0.); }
+    static const Interval eval(const Interval& x, const Interval& y) { return x / y; }
+  };
+
+  struct SqrKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type, typename P::type)
+    {
+      if(UB)
+        return P::max(P::mul(xl, xl), P::mul(xu, xu));
+
+      // Distance between the interval and 0
+      typename P::type m = P::max(P::max(xl, P::sub(P::zero(), xu)), P::zero());
+      return P::mul(m, m);
+    }
+
+    static bool processed(double xl, double xu, double, double) { return bounded(xl, xu, xl, xu); }
+    static const Interval eval(const Interval& x, const Interval&) { return ibex::sqr(x); }
+  };
+
+  struct SqrtKernel
+  {
+    template<typename P, bool UB>
+    static typename P::type bound(typename P::type xl, typename P::type xu, typename P::type, typename P::type)
+    {
+      return UB ? P::sqrt(xu) : P::sqrt(xl);
+    }
+
+    static bool processed(double xl, double xu, double, double) { return bounded(xl, xu, xl, xu) && xl >= 0.; }
+    static const Interval eval(const Interval& x, const Interval&) { return ibex::sqrt(x); }
+  };
+
+  // An operand is either an array (B = false) or a single value broadcast to all the elements (B = true)
+
+  template<typename P, bool B>
+  static typename P::type load(const double *p, size_t i)
+  {
+    return B ? P::set1(*p) : P::load(p + i);
+  }
+
+  template<typename K, typename P, bool UB, bool BX, bool BY>
+  static size_t run_packs(const double *xl, const double *xu, const double *yl, const double *yu, double *z, size_t i, size_t n)
+  {
+    for( ; i + P::size <= n ; i += P::size)
+      P::store(z + i, K::template bound<P,UB>(load<P,BX>(xl, i), load<P,BX>(xu, i), load<P,BY>(yl, i), load<P,BY>(yu, i)));
+    return i;
+  }
+
+  template<typename K, bool UB, bool BX, bool BY>
+  static void run_pass(const double *xl, const double *xu, const double *yl, const double *yu, double *z, size_t n)
+  {
+    size_t i = 0;
+
+    #if defined(__AVX512F__)
+      i = run_packs<K,Avx512Pack,UB,BX,BY>(xl, xu, yl, yu, z, i, n);
+    #endif
+
+    #if defined(__AVX__)
+      i = run_packs<K,AvxPack,UB,BX,BY>(xl, xu, yl, yu, z, i, n);
+    #endif
+
+    run_packs<K,ScalarPack,UB,BX,BY>(xl, xu, yl, yu, z, i, n);
+  }
+
+  static const Interval interval(double lb, double ub)
+  {
+    if(std::isnan(lb) || std::isnan(ub))
+      return Interval::EMPTY_SET;
+    return Interval(lb, ub);
+  }
+
+  template<typename K, bool BX, bool BY>
+  static void run_kernel(const double *xl, const double *xu, const double *yl, const double *yu, size_t n, IntervalArray& z)
+  {
+    // Buffers are kept from one call to the other, to avoid allocations
+    static thread_local vector<pair<size_t,Interval> > v_others;
+    static thread_local vector<double> v_lb;
+
+    // Intervals not processed by the kernel are computed first, as z may be an operand
+    v_others.clear();
+    for(size_t i = 0 ; i < n ; i++)
+    {
+      size_t ix = BX ? 0 : i, iy = BY ? 0 : i;
+      if(!K::processed(xl[ix], xu[ix], yl[iy], yu[iy]))
+        v_others.push_back(make_pair(i, K::eval(interval(xl[ix], xu[ix]), interval(yl[iy], yu[iy]))));
+    }
+
+    v_lb.resize(n); // lower bounds of x and y are needed for the upper bounds of z
+    z.ub.resize(n);
+
+    int rounding = fegetround();
+    fesetround(FE_DOWNWARD);
+    run_pass<K,false,BX,BY>(xl, xu, yl, yu, v_lb.data(), n);
+    fesetround(FE_UPWARD);
+    run_pass<K,true,BX,BY>(xl, xu, yl, yu, z.ub.data(), n);
+    fesetround(rounding);
+
+    z.lb.swap(v_lb); // the previous bounds of z are kept as buffer
+    for(const auto& other : v_others)
+      z.set(other.first, other.second);
+  }
+
+  template<typename K>
+  static void run_kernel(const IntervalArray& x, const IntervalArray& y, IntervalArray& z)
+  {
+    assert(x.size() == y.size());
+    run_kernel<K,false,false>(x.lb.data(), x.ub.data(), y.lb.data(), y.ub.data(), x.size(), z);
+  }
+
+  template<typename K>
+  static void run_kernel(const IntervalArray& x, const Interval& y, IntervalArray& z)
+  {
+    IntervalArray y_(1, y);
+    run_kernel<K,false,true>(x.lb.data(), x.ub.data(), y_.lb.data(), y_.ub.data(), x.size(), z);
+  }
+
+  template<typename K>
+  static void run_kernel(const Interval& x, const IntervalArray& y, IntervalArray& z)
+  {
+    IntervalArray x_(1, x);
+    run_kernel<K,true,false>(x_.lb.data(), x_.ub.data(), y.lb.data(), y.ub.data(), y.size(), z);
+  }
+
+  // Bulk operations
+
+  void bulk_add(const IntervalArray& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<AddKernel>(x, y, z);
+  }
+
+  void bulk_add(const IntervalArray& x, const Interval& y, IntervalArray& z)
+  {
+    run_kernel<AddKernel>(x, y, z);
+  }
+
+  void bulk_add(const Interval& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<AddKernel>(x, y, z);
+  }
+
+  void bulk_sub(const IntervalArray& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<SubKernel>(x, y, z);
+  }
+
+  void bulk_sub(const IntervalArray& x, const Interval& y, IntervalArray& z)
+  {
+    run_kernel<SubKernel>(x, y, z);
+  }
+
+  void bulk_sub(const Interval& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<SubKernel>(x, y, z);
+  }
+
+  void bulk_mul(const IntervalArray& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<MulKernel>(x, y, z);
+  }
+
+  void bulk_mul(const IntervalArray& x, const Interval& y, IntervalArray& z)
+  {
+    run_kernel<MulKernel>(x, y, z);
+  }
+
+  void bulk_mul(const Interval& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<MulKernel>(x, y, z);
+  }
+
+  void bulk_div(const IntervalArray& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<DivKernel>(x, y, z);
+  }
+
+  void bulk_div(const IntervalArray& x, const Interval& y, IntervalArray& z)
+  {
+    run_kernel<DivKernel>(x, y, z);
+  }
+
+  void bulk_div(const Interval& x, const IntervalArray& y, IntervalArray& z)
+  {
+    run_kernel<DivKernel>(x, y, z);
+  }
+
+  void bulk_sqr(const IntervalArray& x, IntervalArray& z)
+  {
+    run_kernel<SqrKernel>(x, x, z);
+  }
+
+  void bulk_sqrt(const IntervalArray& x, IntervalArray& z)
+  {
+    run_kernel<SqrtKernel>(x, x, z);
+  }
+}
@@ -0,0 +1,206 @@
+/**
+ *  \file
+ *  Vectorized arithmetic operations on arrays of intervals
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_INTERVAL_KERNELS_H__
+#define __CODAC_INTERVAL_KERNELS_H__
+
+#include <vector>
+#include "codac_Interval.h"
+
+// Bulk operations are processed by SIMD instructions (see the WITH_SIMD CMake option)
+#if defined(__AVX__) || defined(__AVX512F__)
+  #define CODAC_SIMD_KERNELS
+#endif
+
+namespace codac
+{
+  /**
+   * \class IntervalArray
+   * \brief Array of intervals, stored as two arrays of bounds for vectorized computations
+   *
+   * Empty intervals are represented by NaN bounds.
+   */
+  class IntervalArray
+  {
+    public:
+
+      /**
+       * \brief Creates an array of intervals
+       *
+       * \param n the number of intervals
+       * \param x optional value of the intervals
+       */
+      explicit IntervalArray(size_t n = 0, const Interval& x = Interval::ALL_REALS);
+
+      /**
+       * \brief Returns the number of intervals
+       *
+       * \return the size of the array
+       */
+      size_t size() const;
+
+      /**
+       * \brief Returns the ith interval of the array
+       *
+       * \param i the index of the interval
+       * \return the Interval value
+       */
+      const Interval get(size_t i) const;
+
+      /**
+       * \brief Sets the ith interval of the array
+       *
+       * \param i the index of the interval
+       * \param x the Interval value
+       */
+      void set(size_t i, const Interval& x);
+
+      std::vector<double> lb; //!< lower bounds of the intervals
+      std::vector<double> ub; //!< upper bounds of the intervals
+  };
+
+  /// \name Bulk operations
+  /// @{
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]+[y_i]\f$ for each element of the arrays
+     *
+     * \note For all the bulk operations, the rounding mode is switched only twice
+     *       for the whole arrays. Bounded intervals are processed by AVX-512 or AVX
+     *       instructions when the library is compiled for them (see the WITH_SIMD
+     *       CMake option), other ones are computed by the Interval operators.
+     *       Results are the same as for the Interval operators.
+     *
+     * \param x first array
+     * \param y second array, of same size
+     * \param z result, possibly one of the operands
+     */
+    void bulk_add(const IntervalArray& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]+[y]\f$ for each element of the array
+     *
+     * \param x the array
+     * \param y interval operand, for all the elements
+     * \param z result, possibly the first operand
+     */
+    void bulk_add(const IntervalArray& x, const Interval& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x]+[y_i]\f$ for each element of the array
+     *
+     * \param x interval operand, for all the elements
+     * \param y the array
+     * \param z result, possibly the second operand
+     */
+    void bulk_add(const Interval& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]-[y_i]\f$ for each element of the arrays
+     *
+     * \param x first array
+     * \param y second array, of same size
+     * \param z result, possibly one of the operands
+     */
+    void bulk_sub(const IntervalArray& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]-[y]\f$ for each element of the array
+     *
+     * \param x the array
+     * \param y interval operand, for all the elements
+     * \param z result, possibly the first operand
+     */
+    void bulk_sub(const IntervalArray& x, const Interval& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x]-[y_i]\f$ for each element of the array
+     *
+     * \param x interval operand, for all the elements
+     * \param y the array
+     * \param z result, possibly the second operand
+     */
+    void bulk_sub(const Interval& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]\cdot[y_i]\f$ for each element of the arrays
+     *
+     * \param x first array
+     * \param y second array, of same size
+     * \param z result, possibly one of the operands
+     */
+    void bulk_mul(const IntervalArray& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]\cdot[y]\f$ for each element of the array
+     *
+     * \param x the array
+     * \param y interval operand, for all the elements
+     * \param z result, possibly the first operand
+     */
+    void bulk_mul(const IntervalArray& x, const Interval& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x]\cdot[y_i]\f$ for each element of the array
+     *
+     * \param x interval operand, for all the elements
+     * \param y the array
+     * \param z result, possibly the second operand
+     */
+    void bulk_mul(const Interval& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]/[y_i]\f$ for each element of the arrays
+     *
+     * \param x first array
+     * \param y second array, of same size
+     * \param z result, possibly one of the operands
+     */
+    void bulk_div(const IntervalArray& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]/[y]\f$ for each element of the array
+     *
+     * \param x the array
+     * \param y interval operand, for all the elements
+     * \param z result, possibly the first operand
+     */
+    void bulk_div(const IntervalArray& x, const Interval& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x]/[y_i]\f$ for each element of the array
+     *
+     * \param x interval operand, for all the elements
+     * \param y the array
+     * \param z result, possibly the second operand
+     */
+    void bulk_div(const Interval& x, const IntervalArray& y, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=[x_i]^2\f$ for each element of the array
+     *
+     * \param x the array
+     * \param z result, possibly the operand
+     */
+    void bulk_sqr(const IntervalArray& x, IntervalArray& z);
+
+    /**
+     * \brief Computes \f$[z_i]=\sqrt{[x_i]}\f$ for each element of the array
+     *
+     * \param x the array
+     * \param z result, possibly the operand
+     */
+    void bulk_sqrt(const IntervalArray& x, IntervalArray& z);
+
+  /// @}
+}
+
+#endif
@@ -16,6 +16,38 @@ using namespace ibex;
 
 namespace codac
 {
+  // Builds the trajectory of the values f(x(t_i)), at the times of the samples of x
+  template<typename F>
+  static const Trajectory transform_samples(const Trajectory& x, const F& f)
+  {
+    assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
+      && "not supported yet for trajectories defined by a Function");
+
+    const vector<double>& v_t = x.sampled_times();
+    const vector<double>& v_x = x.sampled_values();
+
+    Trajectory y;
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+      y.set(f(v_x[i]), v_t[i]); // values appended by increasing times
+    return y;
+  }
+
+  // Builds the trajectory of the values f(x1(t_i),x2(t_i)),
+  // the two trajectories being sampled at the same times
+  template<typename F>
+  static const Trajectory transform_samples(const Trajectory& x1, const Trajectory& x2, const F& f)
+  {
+    const vector<double>& v_t = x1.sampled_times();
+    const vector<double>& v_x1 = x1.sampled_values();
+    const vector<double>& v_x2 = x2.sampled_values();
+    assert(v_x1.size() == v_x2.size());
+
+    Trajectory y;
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+      y.set(f(v_x1[i], v_x2[i]), v_t[i]); // values appended by increasing times
+    return y;
+  }
+
   const Trajectory operator+(const Trajectory& x)
   {
     return x;
@@ -23,32 +55,14 @@ namespace codac
 
   const Trajectory operator-(const Trajectory& x)
   {
-    assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
-      && "not supported yet for trajectories defined by a Function");
-
-    map<double,double> map_y = x.sampled_map();
-
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = -it->second;
-
-    return Trajectory(map_y);
+    return transform_samples(x, [](double v) { return -v; });
   }
     
   #define macro_scal_unary(f) \
     \
     const Trajectory f(const Trajectory& x) \
     { \
-      assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES \
-        && "not supported yet for trajectories defined by a Function"); \
-      \
-      map<double,double> map_y = x.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second); \
-      \
-      return Trajectory(map_y); \
+      return transform_samples(x, [](double v) { return std::f(v); }); \
     } \
     \
 
@@ -58,16 +72,7 @@ namespace codac
     
   const Trajectory sqr(const Trajectory& x)
   {
-    assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
-      && "not supported yet for trajectories defined by a Function");
-
-    map<double,double> map_y = x.sampled_map();
-
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second,2);
-
-    return Trajectory(map_y);
+    return transform_samples(x, [](double v) { return std::pow(v,2); });
   }
 
   macro_scal_unary(sqrt);
@@ -88,16 +93,7 @@ namespace codac
     \
     const Trajectory f(const Trajectory& x, p param) \
     { \
-      assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES && \
-        "not supported yet for trajectories defined by a Function"); \
-      \
-      map<double,double> map_y = x.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second, param); \
-      \
-      return Trajectory(map_y); \
+      return transform_samples(x, [param](double v) { return std::f(v, param); }); \
     } \
     \
   
@@ -106,15 +102,7 @@ namespace codac
 
   const Trajectory root(const Trajectory& x, int p)
   {
-    assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES &&
-      "not supported yet for trajectories defined by a Function");
-
-    map<double,double> map_y = x.sampled_map();
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second, 1. / p);
-
-    return Trajectory(map_y);
+    return transform_samples(x, [p](double v) { return std::pow(v, 1. / p); });
   }
 
   #define macro_scal_binary_arith(f) \
@@ -130,47 +118,18 @@ namespace codac
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> new_map; \
-      map<double,double>::const_iterator it_x1 = x1_sampled.sampled_map().begin(); \
-      map<double,double>::const_iterator it_x2 = x2_sampled.sampled_map().begin(); \
-      \
-      while(it_x1 != x1_sampled.sampled_map().end()) \
-      { \
-        new_map[it_x1->first] = it_x1->second f it_x2->second; \
-        it_x1++; it_x2++; \
-      } \
       \
-      return Trajectory(new_map); \
+      return transform_samples(x1_sampled, x2_sampled, [](double v1, double v2) { return v1 f v2; }); \
     } \
     \
     const Trajectory operator f(const Trajectory& x1, double x2) \
     { \
-      assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES && \
-        "not supported yet for trajectories defined by a Function"); \
-      \
-      Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = it->second f x2; \
-      \
-      return Trajectory(map_y); \
+      return transform_samples(x1, [x2](double v) { return v f x2; }); \
     } \
     \
     const Trajectory operator f(double x1, const Trajectory& x2) \
     { \
-      assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES && \
-        "not supported yet for trajectories defined by a Function"); \
-      \
-      Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = x1 f it->second; \
-      \
-      return Trajectory(map_y); \
+      return transform_samples(x2, [x1](double v) { return x1 f v; }); \
     } \
     \
 
@@ -192,48 +151,18 @@ namespace codac
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> map_x1 = x1.sampled_map(), map_x2 = x2.sampled_map(); \
-    \
-      map<double,double>::iterator it_x1 = map_x1.begin(); \
-      map<double,double>::iterator it_x2 = map_x2.begin(); \
     \
-      while(it_x1 != map_x1.end()) \
-      { \
-        it_x1->second = std::f(it_x1->second, it_x2->second); \
-        it_x1++; it_x2++; \
-      } \
-    \
-      return Trajectory(map_x1); \
+      return transform_samples(x1_sampled, x2_sampled, [](double v1, double v2) { return std::f(v1, v2); }); \
     } \
     \
     const Trajectory f(const Trajectory& x1, double x2) \
     { \
-      assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES && \
-        "not supported yet for trajectories defined by a Function"); \
-    \
-      Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
-    \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second, x2); \
-    \
-      return Trajectory(map_y); \
+      return transform_samples(x1, [x2](double v) { return std::f(v, x2); }); \
     } \
     \
     const Trajectory f(double x1, const Trajectory& x2) \
     { \
-      assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES && \
-        "not supported yet for trajectories defined by a Function"); \
-    \
-      Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
-    \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(x1, it->second); \
-    \
-      return Trajectory(map_y); \
+      return transform_samples(x2, [x1](double v) { return std::f(x1, v); }); \
     } \
 
   macro_scal_binary_f(atan2);
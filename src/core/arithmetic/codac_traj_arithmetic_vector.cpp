@@ -15,6 +15,15 @@ using namespace ibex;
 
 namespace codac
 {
+  // Times of the samples of the first component, that are also those of
+  // the other components in case of a shared time base
+  static const vector<double> common_sampled_times(const TrajectoryVector& x)
+  {
+    if(x.shared_timebase())
+      return vector<double>(x.sampled_times().data(), x.sampled_times().data() + x.sampled_times().size());
+    return x[0].sampled_times();
+  }
+
   const TrajectoryVector operator+(const TrajectoryVector& x)
   {
     return x;
@@ -23,20 +32,28 @@ namespace codac
   const TrajectoryVector operator-(const TrajectoryVector& x)
   {
     TrajectoryVector y(x);
-    for(int i = 0 ; i < y.size() ; i++)
-      y[i] = -y[i];
+    if(y.shared_timebase()) // processed on the shared values
+      y *= -1.;
+
+    else
+      for(int i = 0 ; i < y.size() ; i++)
+        y[i] = -y[i];
     return y;
   }
 
-  #define macro_vect_binary(f) \
+  #define macro_vect_binary(f, fa, sign) \
     \
     const TrajectoryVector f(const TrajectoryVector& x1, const TrajectoryVector& x2) \
     { \
       assert(x1.size() == x2.size()); \
       assert(x1.tdomain() == x2.tdomain()); \
       TrajectoryVector y(x1); \
-      for(int i = 0 ; i < y.size() ; i++) \
-        y[i] = codac::f(x1[i], x2[i]); \
+      if(y.shared_timebase()) /* processed on the shared values, if possible */ \
+        y.fa(x2); \
+      \
+      else \
+        for(int i = 0 ; i < y.size() ; i++) \
+          y[i] = codac::f(x1[i], x2[i]); \
       return y; \
     } \
     \
@@ -44,8 +61,12 @@ namespace codac
     { \
       assert(x1.size() == x2.size()); \
       TrajectoryVector y(x1); \
-      for(int i = 0 ; i < y.size() ; i++) \
-        y[i] = codac::f(x1[i], x2[i]); \
+      if(y.shared_timebase()) /* processed on the shared values */ \
+        y.fa(x2); \
+      \
+      else \
+        for(int i = 0 ; i < y.size() ; i++) \
+          y[i] = codac::f(x1[i], x2[i]); \
       return y; \
     } \
     \
@@ -53,27 +74,33 @@ namespace codac
     { \
       assert(x1.size() == x2.size()); \
       TrajectoryVector y(x2); \
-      for(int i = 0 ; i < y.size() ; i++) \
-        y[i] = codac::f(x1[i], x2[i]); \
+      if(y.shared_timebase()) /* processed on the shared values, as x2+x1 or (-x2)+x1 */ \
+      { \
+        if(sign < 0.) \
+          y *= -1.; \
+        y += x1; \
+      } \
+      \
+      else \
+        for(int i = 0 ; i < y.size() ; i++) \
+          y[i] = codac::f(x1[i], x2[i]); \
       return y; \
     } \
 
-  macro_vect_binary(operator+);
-  macro_vect_binary(operator-);
+  macro_vect_binary(operator+, operator+=, 1.);
+  macro_vect_binary(operator-, operator-=, -1.);
 
   const TrajectoryVector operator*(double x1, const TrajectoryVector& x2)
   {
     TrajectoryVector y(x2);
-    for(int i = 0 ; i < y.size() ; i++)
-      y[i] *= x1;
+    y *= x1; // also processed on the values of a shared time base
     return y;
   }
 
   const TrajectoryVector operator*(const Trajectory& x1, const TrajectoryVector& x2)
   {
     TrajectoryVector y(x2);
-    for(int i = 0 ; i < y.size() ; i++)
-      y[i] *= x1;
+    y *= x1; // also processed on the values of a shared time base
     return y;
   }
 
@@ -91,14 +118,15 @@ namespace codac
 
     TrajectoryVector x2_(x2);
     // Same sampling for all components of this trajectory
-    for(int i = 0 ; i < x2_.size() ; i++)
-      for(int j = 0 ; j < x2_.size() ; j++)
-        if(i != j)
-          x2_[i].sample(x2_[j]);
+    if(!x2_.shared_timebase())
+      for(int i = 0 ; i < x2_.size() ; i++)
+        for(int j = 0 ; j < x2_.size() ; j++)
+          if(i != j)
+            x2_[i].sample(x2_[j]);
 
     TrajectoryVector result(x2.size());
-    for(auto const& it : x2_[0].sampled_map())
-      result.set(x1*x2_(it.first), it.first);
+    for(double t : common_sampled_times(x2_))
+      result.set(x1*x2_(t), t);
     
     return result;
   }
@@ -106,16 +134,14 @@ namespace codac
   const TrajectoryVector operator/(const TrajectoryVector& x1, double x2)
   {
     TrajectoryVector y(x1);
-    for(int i = 0 ; i < y.size() ; i++)
-      y[i] /= x2;
+    y /= x2; // also processed on the values of a shared time base
     return y;
   }
 
   const TrajectoryVector operator/(const TrajectoryVector& x1, const Trajectory& x2)
   {
     TrajectoryVector y(x1);
-    for(int i = 0 ; i < y.size() ; i++)
-      y[i] /= x2;
+    y /= x2; // also processed on the values of a shared time base
     return y;
   }
 
@@ -143,8 +169,8 @@ namespace codac
     assert(x1.size() == 3 && x2.size() == 3);
 
     TrajectoryVector result(x1.size());
-    for(auto const& it : x1[0].sampled_map())
-      result.set(vecto_product(x1(it.first),x2), it.first);
+    for(double t : common_sampled_times(x1))
+      result.set(vecto_product(x1(t),x2), t);
 
     return result;
   }
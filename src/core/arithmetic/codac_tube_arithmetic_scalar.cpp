@@ -11,12 +11,52 @@
 
 #include "codac_tube_arithmetic.h"
 #include "codac_Slice.h"
+#include "codac_interval_kernels.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  #if defined(CODAC_SIMD_KERNELS)
+
+  // Values of a tube in temporal order (gates and codomains), for bulk operations.
+  // Buffers are kept from one call to the other, to avoid allocations.
+
+  static thread_local IntervalArray values1, values2;
+
+  static void tube_values(const Tube& x, IntervalArray& values)
+  {
+    size_t n = 2 * x.nb_slices() + 1;
+    values.lb.resize(n);
+    values.ub.resize(n);
+    size_t i = 0;
+
+    for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+    {
+      values.set(i++, s->input_gate());
+      values.set(i++, s->codomain());
+    }
+
+    values.set(i, x.last_slice()->output_gate());
+  }
+
+  static void set_tube_values(Tube& x, const IntervalArray& values)
+  {
+    assert(values.size() == (size_t)(2 * x.nb_slices() + 1));
+    size_t i = 0;
+
+    for(Slice *s = x.first_slice() ; s ; s = s->next_slice())
+    {
+      s->set_input_gate(values.get(i++), false);
+      s->set_envelope(values.get(i++), false);
+    }
+
+    x.last_slice()->set_output_gate(values.get(i), false);
+  }
+
+  #endif
+
   const Tube operator+(const Tube& x)
   {
     return x;
@@ -83,11 +123,28 @@ namespace codac
     } \
     \
 
+  #define macro_scal_unary_bulk(f, bulk_f) \
+    \
+    const Tube f(const Tube& x) \
+    { \
+      tube_values(x, values1); \
+      bulk_f(values1, values1); \
+      Tube y(x); \
+      set_tube_values(y, values1); \
+      return y; \
+    } \
+    \
+
   macro_scal_unary(cos);
   macro_scal_unary(sin);
   macro_scal_unary(abs);
+  #if defined(CODAC_SIMD_KERNELS)
+  macro_scal_unary_bulk(sqr, bulk_sqr);
+  macro_scal_unary_bulk(sqrt, bulk_sqrt);
+  #else // without SIMD, the slices are faster processed one by one
   macro_scal_unary(sqr);
   macro_scal_unary(sqrt);
+  #endif
   macro_scal_unary(exp);
   macro_scal_unary(log);
   macro_scal_unary(tan);
@@ -252,10 +309,57 @@ namespace codac
       return y; \
     } \
 
+  #define macro_scal_binary_bulk(f, bulk_f) \
+    \
+    const Tube f(const Tube& x1, const Tube& x2) \
+    { \
+      assert(x1.tdomain() == x2.tdomain()); \
+      \
+      if(!Tube::same_slicing(x1, x2)) /* copies of x1 and x2 are equally resampled */ \
+      { \
+        Tube x1_resampled(x1), x2_resampled(x2); \
+        x1_resampled.sample(x2); \
+        x2_resampled.sample(x1); \
+        return f(x1_resampled, x2_resampled); \
+      } \
+      \
+      tube_values(x1, values1); \
+      tube_values(x2, values2); \
+      bulk_f(values1, values2, values1); \
+      Tube y(x1); \
+      set_tube_values(y, values1); \
+      return y; \
+    } \
+    \
+    const Tube f(const Tube& x1, const Interval& x2) \
+    { \
+      tube_values(x1, values1); \
+      bulk_f(values1, x2, values1); \
+      Tube y(x1); \
+      set_tube_values(y, values1); \
+      return y; \
+    } \
+    \
+    const Tube f(const Interval& x1, const Tube& x2) \
+    { \
+      tube_values(x2, values1); \
+      bulk_f(x1, values1, values1); \
+      Tube y(x2); \
+      set_tube_values(y, values1); \
+      return y; \
+    } \
+
+  #if defined(CODAC_SIMD_KERNELS)
+  macro_scal_binary_bulk(operator+, bulk_add);
+  macro_scal_binary_bulk(operator-, bulk_sub);
+  macro_scal_binary_bulk(operator*, bulk_mul);
+  macro_scal_binary_bulk(operator/, bulk_div);
+  #else // without SIMD, the slices are faster processed one by one
   macro_scal_binary(operator+);
   macro_scal_binary(operator-);
   macro_scal_binary(operator*);
   macro_scal_binary(operator/);
+  #endif
   macro_scal_binary(operator|);
   macro_scal_binary(operator&);
   macro_scal_binary(atan2);
@@ -0,0 +1,428 @@
+/**
+ *  \file
+ *  Lazily evaluated arithmetic expressions of tubes
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBE_EXPR_H__
+#define __CODAC_TUBE_EXPR_H__
+
+#include <cassert>
+#include "codac_Interval.h"
+#include "codac_Tube.h"
+#include "codac_Slice.h"
+#include "codac_Exception.h"
+
+namespace codac
+{
+  /**
+   * \class TubeExpr
+   * \brief Arithmetic expression of tubes, evaluated only when assigned to a Tube
+   *
+   * Expressions are built from the tubes returned by lazy(), combined with the usual
+   * operators and functions. The whole expression is then computed in one pass
+   * over the slices, directly into the destination tube:
+   *
+   * \code
+   * Tube z = sqrt(sqr(lazy(x)) + sqr(lazy(y))); // no temporary tube
+   * z = lazy(z) * 2. + lazy(x); // in place, no allocation
+   * \endcode
+   *
+   * \note The tubes of an expression must share the same slicing, and must not
+   *       be destroyed before the evaluation of the expression.
+   *
+   * \tparam E the type of the expression (CRTP)
+   */
+  template<typename E>
+  class TubeExpr
+  {
+    public:
+
+      /**
+       * \brief Returns this expression with its actual type
+       *
+       * \return the expression
+       */
+      const E& derived() const
+      {
+        return static_cast<const E&>(*this);
+      }
+  };
+
+  /**
+   * \class TubeLeafExpr
+   * \brief Tube involved in an expression, read slice by slice
+   */
+  class TubeLeafExpr : public TubeExpr<TubeLeafExpr>
+  {
+    public:
+
+      /**
+       * \brief Creates a reference to a tube in an expression
+       *
+       * \param x the tube, not copied
+       */
+      explicit TubeLeafExpr(const Tube& x)
+        : m_x(x)
+      {
+
+      }
+
+      /**
+       * \brief Returns a tube of the expression, defining its slicing
+       *
+       * \return a pointer to the tube
+       */
+      const Tube* tube() const
+      {
+        return &m_x;
+      }
+
+      /**
+       * \brief Tests if the tubes of the expression have the slicing of \f$[y](\cdot)\f$
+       *
+       * \param y the tube to be compared with
+       * \return true in case of same slicing
+       */
+      bool same_slicing(const Tube& y) const
+      {
+        return Tube::same_slicing(m_x, y);
+      }
+
+      /**
+       * \brief Moves to the first slice
+       */
+      void first_slice()
+      {
+        m_s = m_x.first_slice();
+      }
+
+      /**
+       * \brief Moves to the next slice
+       */
+      void next_slice()
+      {
+        assert(m_s);
+        m_s = m_s->next_slice();
+      }
+
+      /**
+       * \brief Returns the codomain of the current slice
+       *
+       * \return the value of the expression over the slice
+       */
+      const Interval codomain() const
+      {
+        return m_s->codomain();
+      }
+
+      /**
+       * \brief Returns the input gate of the current slice
+       *
+       * \return the value of the expression at the beginning of the slice
+       */
+      const Interval input_gate() const
+      {
+        return m_s->input_gate();
+      }
+
+      /**
+       * \brief Returns the output gate of the current slice
+       *
+       * \return the value of the expression at the end of the slice
+       */
+      const Interval output_gate() const
+      {
+        return m_s->output_gate();
+      }
+
+    protected:
+
+      const Tube& m_x; //!< tube of the expression
+      const Slice *m_s = nullptr; //!< current slice
+  };
+
+  /**
+   * \class IntervalLeafExpr
+   * \brief Constant interval involved in an expression
+   */
+  class IntervalLeafExpr : public TubeExpr<IntervalLeafExpr>
+  {
+    public:
+
+      /**
+       * \brief Creates a constant in an expression
+       *
+       * \param x the value of the constant
+       */
+      explicit IntervalLeafExpr(const Interval& x)
+        : m_x(x)
+      {
+
+      }
+
+      const Tube* tube() const { return nullptr; }
+      bool same_slicing(const Tube&) const { return true; }
+      void first_slice() { }
+      void next_slice() { }
+      const Interval codomain() const { return m_x; }
+      const Interval input_gate() const { return m_x; }
+      const Interval output_gate() const { return m_x; }
+
+    protected:
+
+      const Interval m_x; //!< value of the constant
+  };
+
+  /**
+   * \class TubeUnaryExpr
+   * \brief Interval function applied on an expression
+   *
+   * \tparam F the type of the interval function
+   * \tparam E the type of the operand
+   */
+  template<typename F, typename E>
+  class TubeUnaryExpr : public TubeExpr<TubeUnaryExpr<F,E>>
+  {
+    public:
+
+      /**
+       * \brief Creates the expression \f$f([x](\cdot))\f$
+       *
+       * \param x the operand
+       * \param f the interval function
+       */
+      TubeUnaryExpr(const E& x, const F& f)
+        : m_x(x), m_f(f)
+      {
+
+      }
+
+      const Tube* tube() const { return m_x.tube(); }
+      bool same_slicing(const Tube& y) const { return m_x.same_slicing(y); }
+      void first_slice() { m_x.first_slice(); }
+      void next_slice() { m_x.next_slice(); }
+      const Interval codomain() const { return m_f(m_x.codomain()); }
+      const Interval input_gate() const { return m_f(m_x.input_gate()); }
+      const Interval output_gate() const { return m_f(m_x.output_gate()); }
+
+    protected:
+
+      E m_x; //!< operand
+      const F m_f; //!< interval function
+  };
+
+  /**
+   * \class TubeBinaryExpr
+   * \brief Interval function applied on two expressions
+   *
+   * \tparam F the type of the interval function
+   * \tparam E1 the type of the first operand
+   * \tparam E2 the type of the second operand
+   */
+  template<typename F, typename E1, typename E2>
+  class TubeBinaryExpr : public TubeExpr<TubeBinaryExpr<F,E1,E2>>
+  {
+    public:
+
+      /**
+       * \brief Creates the expression \f$f([x_1](\cdot),[x_2](\cdot))\f$
+       *
+       * \param x1 the first operand
+       * \param x2 the second operand
+       * \param f the interval function
+       */
+      TubeBinaryExpr(const E1& x1, const E2& x2, const F& f)
+        : m_x1(x1), m_x2(x2), m_f(f)
+      {
+
+      }
+
+      const Tube* tube() const { return m_x1.tube() ? m_x1.tube() : m_x2.tube(); }
+      bool same_slicing(const Tube& y) const { return m_x1.same_slicing(y) && m_x2.same_slicing(y); }
+      void first_slice() { m_x1.first_slice(); m_x2.first_slice(); }
+      void next_slice() { m_x1.next_slice(); m_x2.next_slice(); }
+      const Interval codomain() const { return m_f(m_x1.codomain(), m_x2.codomain()); }
+      const Interval input_gate() const { return m_f(m_x1.input_gate(), m_x2.input_gate()); }
+      const Interval output_gate() const { return m_f(m_x1.output_gate(), m_x2.output_gate()); }
+
+    protected:
+
+      E1 m_x1; //!< first operand
+      E2 m_x2; //!< second operand
+      const F m_f; //!< interval function
+  };
+
+  /**
+   * \brief Makes a tube usable in a lazily evaluated expression
+   *
+   * \param x the tube, that must outlive the expression
+   * \return the expression of \f$[x](\cdot)\f$
+   */
+  inline const TubeLeafExpr lazy(const Tube& x)
+  {
+    return TubeLeafExpr(x);
+  }
+
+  // Definition of Tube from expressions
+
+  template<typename E>
+  Tube::Tube(const TubeExpr<E>& expr)
+    : Tube(*expr.derived().tube())
+  {
+    *this = expr;
+  }
+
+  template<typename E>
+  const Tube& Tube::operator=(const TubeExpr<E>& expr)
+  {
+    E e(expr.derived());
+    assert(e.tube() && "the expression involves at least one tube");
+
+    if(!e.same_slicing(*this))
+    {
+      if(!e.same_slicing(*e.tube()))
+        throw Exception(__func__, "the tubes of the expression must share the same slicing");
+
+      // This tube is not involved in the expression: its slicing is replaced
+      *this = *e.tube();
+    }
+
+    // One pass over the slices: slice k of the operands is only read
+    // before the update of slice k of this tube, that may be one of them
+    Slice *s = first_slice();
+    e.first_slice();
+
+    while(true)
+    {
+      const Interval codomain = e.codomain(), input_gate = e.input_gate();
+      s->set_envelope(codomain, false);
+      s->set_input_gate(input_gate, false);
+
+      if(!s->next_slice())
+        break;
+
+      s = s->next_slice();
+      e.next_slice();
+    }
+
+    s->set_output_gate(e.output_gate(), false);
+    return *this;
+  }
+
+  // Operators and functions on expressions
+
+  #define macro_tube_expr_unary(f) \
+    \
+    template<typename E> \
+    inline auto f(const TubeExpr<E>& x) \
+    { \
+      auto fnc = [](const Interval& x_) { return ibex::f(x_); }; \
+      return TubeUnaryExpr<decltype(fnc),E>(x.derived(), fnc); \
+    } \
+    \
+
+  #define macro_tube_expr_unary_param(f, p) \
+    \
+    template<typename E> \
+    inline auto f(const TubeExpr<E>& x, p param) \
+    { \
+      auto fnc = [param](const Interval& x_) { return ibex::f(x_, param); }; /* param copied */ \
+      return TubeUnaryExpr<decltype(fnc),E>(x.derived(), fnc); \
+    } \
+    \
+
+  #define macro_tube_expr_binary_fnc(f) \
+    [](const Interval& x1_, const Interval& x2_) { return ibex::f(x1_, x2_); }
+
+  #define macro_tube_expr_binary(f) \
+    \
+    template<typename E1, typename E2> \
+    inline auto f(const TubeExpr<E1>& x1, const TubeExpr<E2>& x2) \
+    { \
+      auto fnc = macro_tube_expr_binary_fnc(f); \
+      return TubeBinaryExpr<decltype(fnc),E1,E2>(x1.derived(), x2.derived(), fnc); \
+    } \
+    \
+    template<typename E> \
+    inline auto f(const TubeExpr<E>& x1, const Tube& x2) \
+    { \
+      auto fnc = macro_tube_expr_binary_fnc(f); \
+      return TubeBinaryExpr<decltype(fnc),E,TubeLeafExpr>(x1.derived(), TubeLeafExpr(x2), fnc); \
+    } \
+    \
+    template<typename E> \
+    inline auto f(const Tube& x1, const TubeExpr<E>& x2) \
+    { \
+      auto fnc = macro_tube_expr_binary_fnc(f); \
+      return TubeBinaryExpr<decltype(fnc),TubeLeafExpr,E>(TubeLeafExpr(x1), x2.derived(), fnc); \
+    } \
+    \
+    template<typename E> \
+    inline auto f(const TubeExpr<E>& x1, const Interval& x2) \
+    { \
+      auto fnc = macro_tube_expr_binary_fnc(f); \
+      return TubeBinaryExpr<decltype(fnc),E,IntervalLeafExpr>(x1.derived(), IntervalLeafExpr(x2), fnc); \
+    } \
+    \
+    template<typename E> \
+    inline auto f(const Interval& x1, const TubeExpr<E>& x2) \
+    { \
+      auto fnc = macro_tube_expr_binary_fnc(f); \
+      return TubeBinaryExpr<decltype(fnc),IntervalLeafExpr,E>(IntervalLeafExpr(x1), x2.derived(), fnc); \
+    } \
+    \
+
+  template<typename E>
+  inline const E& operator+(const TubeExpr<E>& x)
+  {
+    return x.derived();
+  }
+
+  template<typename E>
+  inline auto operator-(const TubeExpr<E>& x)
+  {
+    auto fnc = [](const Interval& x_) { return -x_; };
+    return TubeUnaryExpr<decltype(fnc),E>(x.derived(), fnc);
+  }
+
+  macro_tube_expr_unary(cos);
+  macro_tube_expr_unary(sin);
+  macro_tube_expr_unary(abs);
+  macro_tube_expr_unary(sqr);
+  macro_tube_expr_unary(sqrt);
+  macro_tube_expr_unary(exp);
+  macro_tube_expr_unary(log);
+  macro_tube_expr_unary(tan);
+  macro_tube_expr_unary(acos);
+  macro_tube_expr_unary(asin);
+  macro_tube_expr_unary(atan);
+  macro_tube_expr_unary(cosh);
+  macro_tube_expr_unary(sinh);
+  macro_tube_expr_unary(tanh);
+  macro_tube_expr_unary(acosh);
+  macro_tube_expr_unary(asinh);
+  macro_tube_expr_unary(atanh);
+
+  macro_tube_expr_unary_param(pow, int);
+  macro_tube_expr_unary_param(pow, double);
+  macro_tube_expr_unary_param(pow, const Interval&);
+  macro_tube_expr_unary_param(root, int);
+
+  macro_tube_expr_binary(operator+);
+  macro_tube_expr_binary(operator-);
+  macro_tube_expr_binary(operator*);
+  macro_tube_expr_binary(operator/);
+  macro_tube_expr_binary(operator|);
+  macro_tube_expr_binary(operator&);
+  macro_tube_expr_binary(atan2);
+  macro_tube_expr_binary(min);
+  macro_tube_expr_binary(max);
+}
+
+#endif
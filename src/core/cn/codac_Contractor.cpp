@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "codac_Contractor.h"
 #include "codac_CtcEval.h"
 #include "codac_CtcDeriv.h"
@@ -204,12 +205,16 @@ namespace codac
     return true;
   }
 
-  void Contractor::contract()
+  void Contractor::contract(Ctc *static_ctc)
   {
     assert(!m_v_domains.empty() || m_type == Type::T_CN);
+    assert(!static_ctc || m_type == Type::T_IBEX);
 
     if(m_type == Type::T_IBEX)
     {
+      // An equivalent copy of the contractor may be provided (parallel propagation)
+      Ctc& ctc = static_ctc ? *static_ctc : m_static_ctc.get();
+
       // Data may be presented in two ways:
       // - all components in one vector box
       // - a list of heterogeneous components
@@ -217,7 +222,7 @@ namespace codac
       // Case: all components in one vector box
       if(m_v_domains.size() == 1 && m_v_domains[0]->type() == Domain::Type::T_INTERVAL_VECTOR)
       {
-        m_static_ctc.get().contract(m_v_domains[0]->interval_vector());
+        ctc.contract(m_v_domains[0]->interval_vector());
       }
 
       // Case: list of heterogeneous components
@@ -230,7 +235,7 @@ namespace codac
 
           // Building a temporary box for the contraction
           
-            IntervalVector box(m_static_ctc.get().nb_var);
+            IntervalVector box(ctc.nb_var);
 
             int i = 0;
             for(auto& dom : m_v_domains)
@@ -281,11 +286,11 @@ namespace codac
               }
             }
 
-            assert(i == m_static_ctc.get().nb_var);
+            assert(i == ctc.nb_var);
 
           // Contracting
 
-            m_static_ctc.get().contract(box);
+            ctc.contract(box);
             
           // Updating the domains (reverse operation)
 
@@ -337,7 +342,7 @@ namespace codac
               }
             }
 
-            assert(i == m_static_ctc.get().nb_var);
+            assert(i == ctc.nb_var);
 
           if(!at_least_one_slice)
             break;
@@ -408,6 +413,120 @@ namespace codac
       assert(false && "unhandled case");
   }
   
+  const vector<uintptr_t>& Contractor::memory_footprint() const
+  {
+    return m_footprint;
+  }
+
+  /**
+   * \brief Returns the total number of slices of the tubes among the domains
+   */
+  static long nb_slices_of_tubes(const vector<Domain*>& v_domains)
+  {
+    long n = 0;
+    for(const auto& dom : v_domains)
+    {
+      if(dom->type() == Domain::Type::T_TUBE)
+        n += dom->tube().nb_slices();
+
+      else if(dom->type() == Domain::Type::T_TUBE_VECTOR)
+        for(int i = 0 ; i < dom->tube_vector().size() ; i++)
+          n += dom->tube_vector()[i].nb_slices();
+    }
+    return n;
+  }
+
+  void Contractor::update_memory_footprint(bool exclusive_ctc)
+  {
+    m_footprint.clear();
+    m_footprint_nb_slices = 0;
+
+    // Symbolic contractors do not modify their domains
+    if(m_type == Type::T_COMPONENT)
+      return;
+
+    m_footprint_nb_slices = nb_slices_of_tubes(domains());
+
+    for(const auto& dom : domains())
+      dom->memory_footprint(m_footprint);
+
+    if(exclusive_ctc) // the contractor object itself cannot be shared by threads
+    {
+      switch(m_type)
+      {
+        case Type::T_IBEX:
+          m_footprint.push_back(reinterpret_cast<uintptr_t>(&m_static_ctc.get()));
+          break;
+
+        case Type::T_CODAC:
+          m_footprint.push_back(reinterpret_cast<uintptr_t>(&m_dyn_ctc.get()));
+          break;
+
+        default:
+          // Nothing to add
+          break;
+      }
+    }
+
+    sort(m_footprint.begin(), m_footprint.end());
+    m_footprint.erase(unique(m_footprint.begin(), m_footprint.end()), m_footprint.end());
+  }
+
+  bool Contractor::memory_footprint_outdated() const
+  {
+    // Slices are only added by contractions (sampling of tubes)
+    return m_type != Type::T_COMPONENT
+      && nb_slices_of_tubes(domains()) != m_footprint_nb_slices;
+  }
+
+  double Contractor::priority() const
+  {
+    if(m_nb_measures == 0) // contractors never called are run first, to be evaluated
+      return POS_INFINITY;
+
+    // Expected ratio of contraction per second
+    return m_mean_contraction / std::max(m_mean_duration, 1e-9);
+  }
+
+  void Contractor::update_efficiency(double contraction_ratio, double duration)
+  {
+    assert(contraction_ratio >= 0. && contraction_ratio <= 1.);
+    assert(duration >= 0.);
+
+    if(m_nb_measures == 0)
+    {
+      m_mean_contraction = contraction_ratio;
+      m_mean_duration = duration;
+    }
+
+    else // exponential smoothing, as the efficiency decreases along the propagation
+    {
+      const double alpha = 0.3;
+      m_mean_contraction = alpha * contraction_ratio + (1.-alpha) * m_mean_contraction;
+      m_mean_duration = alpha * duration + (1.-alpha) * m_mean_duration;
+    }
+
+    m_nb_measures++;
+  }
+
+  const Contractor::Profile& Contractor::profile() const
+  {
+    return m_profile;
+  }
+
+  void Contractor::add_to_profile(double duration, double contraction_ratio, unsigned long nb_triggers)
+  {
+    m_profile.nb_calls++;
+    m_profile.duration += duration;
+    m_profile.contraction += contraction_ratio;
+    m_profile.nb_triggers += nb_triggers;
+  }
+
+  void Contractor::reset_profile()
+  {
+    m_profile = Profile();
+  }
+
   const string Contractor::name() const
   {
     switch(type())
@@ -442,7 +561,7 @@ namespace codac
   {
     m_name = name;
   }
-  
+
   ostream& operator<<(ostream& str, const Contractor& x)
   {
     str << "Contractor " << x.name() << " (" << x.m_v_domains.size() << " doms)" << flush;
@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <functional>
+#include <cstdint>
 #include "codac_Ctc.h"
 #include "codac_DynCtc.h"
 #include "codac_Domain.h"
@@ -58,7 +59,26 @@ namespace codac
 
       bool operator==(const Contractor& x) const;
 
-      void contract();
+      void contract(Ctc *static_ctc = nullptr);
+
+      const std::vector<std::uintptr_t>& memory_footprint() const;
+      void update_memory_footprint(bool exclusive_ctc);
+      bool memory_footprint_outdated() const;
+
+      double priority() const;
+      void update_efficiency(double contraction_ratio, double duration);
+
+      struct Profile
+      {
+        unsigned long nb_calls = 0; // number of calls
+        double duration = 0.; // cumulated computation time, in seconds
+        double contraction = 0.; // cumulated ratio of volume removed from the domains
+        unsigned long nb_triggers = 0; // number of contractors activated by the contractions
+      };
+
+      const Profile& profile() const;
+      void add_to_profile(double duration, double contraction_ratio, unsigned long nb_triggers);
+      void reset_profile();
 
       const std::string name() const;
       void set_name(const std::string& name);
@@ -79,6 +99,13 @@ namespace codac
       };
 
       std::vector<Domain*> m_v_domains;
+      std::vector<std::uintptr_t> m_footprint; // memory locations modified by the contractor (parallel propagation)
+      long m_footprint_nb_slices = 0; // number of slices of the tube domains when the footprint was computed
+
+      int m_nb_measures = 0; // number of calls measured for scheduling by expected gain
+      double m_mean_contraction = 0.; // smoothed ratio of volume removed from the domains
+      double m_mean_duration = 0.; // smoothed computation time, in seconds
+      Profile m_profile; // cumulated measures, when profiling is enabled in the CN
 
       std::string m_name;
       int m_ctc_id;
@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <atomic>
 #include "codac_ContractorNetwork.h"
 #include "codac_CtcEval.h"
 #include "codac_Exception.h"
@@ -23,6 +24,7 @@ namespace codac
     // Definition
 
     ContractorNetwork::ContractorNetwork()
+      : m_cn_id(new_cn_id())
     {
 
     }
@@ -429,17 +431,45 @@ namespace codac
 
   // Protected methods
 
+    unsigned long ContractorNetwork::new_cn_id()
+    {
+      static atomic<unsigned long> next_id(1); // 0 is reserved for slices not yet added to a CN
+      return next_id++;
+    }
+
     Domain* ContractorNetwork::add_dom(const Domain& ad)
     {
       if(ad.is_empty())
         throw Exception(__func__, "domain already empty when added to the CN");
 
+      // Slices keep a pointer to their Domain in the last CN they have been
+      // added to: most of the domains of large CNs are found without hashing
+      const Slice *s = ad.m_memory_type == Domain::MemoryRef::M_SLICE ? &ad.m_ref_memory_s.get() : nullptr;
+      if(s && s->m_cn_id == m_cn_id)
+        return s->m_cn_domain;
+
       DomainHashcode hash(ad);
-      if(m_map_domains.find(hash) != m_map_domains.end())
-        return m_map_domains[hash];
+      auto it = m_map_domains.find(hash);
+      if(it != m_map_domains.end())
+      {
+        if(s)
+        {
+          s->m_cn_id = m_cn_id;
+          s->m_cn_domain = it->second;
+        }
+
+        return it->second;
+      }
     
       Domain *new_dom = new Domain(ad);
-      m_map_domains[hash] = new_dom;
+      m_map_domains.emplace(hash, new_dom);
+      m_footprints_outdated = true;
+
+      if(s)
+      {
+        s->m_cn_id = m_cn_id;
+        s->m_cn_domain = new_dom;
+      }
 
       // And add possible dependencies
 
@@ -522,13 +552,14 @@ namespace codac
     Contractor* ContractorNetwork::add_ctc(const Contractor& ac)
     {
       ContractorHashcode hash(ac);
-      map<ContractorHashcode,Contractor*>::iterator it = m_map_ctc.find(hash);
+      auto it = m_map_ctc.find(hash);
 
       if(it == m_map_ctc.end())
       {
         // todo: trigger only "contracting" contractors?
         Contractor *new_ctc = new Contractor(ac);
-        m_map_ctc[hash] = new_ctc;
+        m_map_ctc.emplace(hash, new_ctc);
+        m_footprints_outdated = true;
         add_ctc_to_queue(new_ctc, m_deque);
         return new_ctc;
       }
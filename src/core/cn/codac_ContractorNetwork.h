@@ -13,15 +13,19 @@
 #define __CODAC_CONTRACTORNETWORK_H__
 
 #include <deque>
+#include <iostream>
+#include <memory>
 #include <initializer_list>
 #include <unordered_map>
 #include "codac_Ctc.h"
+#include "codac_Function.h"
 #include "codac_DynCtc.h"
 #include "codac_Domain.h"
 #include "codac_CtcDeriv.h"
 #include "codac_Hashcode.h"
 #include "codac_Contractor.h"
 #include "codac_Variable.h"
+#include "codac_ThreadPool.h"
 
 namespace ibex
 {
@@ -49,6 +53,15 @@ namespace codac
   {
     public:
 
+      /**
+       * \brief Defines the order in which active contractors are called
+       */
+      enum class SchedulingPolicy
+      {
+        QUEUE, //!< contractors are called in the order of their activation (default)
+        EXPECTED_GAIN //!< contractors with the best measured contraction per second are called first
+      };
+
       /// \name Definition
       /// @{
 
@@ -312,6 +325,59 @@ namespace codac
       int nb_ctc_in_stack() const;
 
       int iteration_nb() const;
+
+      /**
+       * \brief Sets the policy defining the order in which active contractors are called
+       *
+       * With the `EXPECTED_GAIN` policy, the efficiency of each contractor is measured at each
+       * call: ratio of volume removed from its domains, and computation time. Active contractors
+       * are then called by decreasing ratio of contraction per second, so that cheap and effective
+       * contractors are called first, and expensive contractors with low impact are deferred.
+       * Contractors that have never been called are run first, in order to be evaluated.
+       *
+       * \note This policy reduces the time to reach a fixed point when the contractors of the
+       *       CN have heterogeneous costs, which is useful within contract_during() deadlines.
+       *
+       * \param policy scheduling policy, `QUEUE` by default
+       */
+      void set_scheduling_policy(SchedulingPolicy policy);
+
+      /**
+       * \brief Returns the scheduling policy of the contraction process
+       *
+       * \return the policy
+       */
+      SchedulingPolicy scheduling_policy() const;
+
+      /**
+       * \brief Enables the parallel propagation of the contractions
+       *
+       * Contractors of the queue that do not share memory (domains, slices, gates, or
+       * the contractor object itself) are gathered in batches, in the order of the queue.
+       * The contractors of a batch are run concurrently; the related contractors are then
+       * triggered sequentially, in the order of the batch.
+       *
+       * \note Static contractors of type ibex::CtcFwdBwd (such as CtcFunction) are copied
+       *       for each thread, so that one contractor applied on each slice of tubes can be
+       *       run in parallel. Other contractor objects are not shared by threads. Dynamic
+       *       contractors are assumed not to share internal objects with other contractors.
+       *
+       * \note Batches do not depend on the number of threads: results are the same
+       *       whatever the number of threads. For monotonic contractors and a
+       *       fixed point ratio of 0, the fixed point is the one of the sequential
+       *       propagation.
+       *
+       * \param nb_threads number of threads (if 0, the number of hardware
+       *        threads is used; 1 disables the parallel mode)
+       */
+      void set_nb_threads(int nb_threads = 0);
+
+      /**
+       * \brief Returns the number of threads used for the propagation
+       *
+       * \return the number of threads, 1 if the parallel mode is disabled
+       */
+      int nb_threads() const;
       
 
       /// @}
@@ -367,6 +433,54 @@ namespace codac
       friend std::ostream& operator<<(std::ostream& str, const ContractorNetwork& cn);
 
       /// @}
+      /// \name Profiling
+      /// @{
+
+      /**
+       * \brief Enables or disables the profiling of the contractors
+       *
+       * When enabled, each call of a contractor is measured during the contraction
+       * process: computation time, ratio of volume removed from its domains, and
+       * number of contractors activated by its contractions. Measures are cumulated
+       * over the calls of contract().
+       *
+       * \note When disabled (by default), the contraction process is not slowed down.
+       *
+       * \param enable `true` to enable the profiling
+       */
+      void enable_profiling(bool enable = true);
+
+      /**
+       * \brief Returns `true` if the profiling of the contractors is enabled
+       *
+       * \return profiling mode
+       */
+      bool profiling_enabled() const;
+
+      /**
+       * \brief Resets the cumulated measures of all the contractors
+       */
+      void reset_profiling();
+
+      /**
+       * \brief Displays the contractors ranked by decreasing computation time
+       *
+       * \param str ostream
+       * \param nb_ctc maximal number of contractors to be displayed (all if 0)
+       */
+      void print_profiling(std::ostream& str = std::cout, int nb_ctc = 20) const;
+
+      /**
+       * \brief Exports the measures of all the contractors, ranked by decreasing
+       *        computation time
+       *
+       * The format is deduced from the extension of the file name: `.json` or `.csv`.
+       *
+       * \param file_name name of the file to be written
+       */
+      void export_profiling(const std::string& file_name) const;
+
+      /// @}
 
     protected:
 
@@ -382,6 +496,16 @@ namespace codac
        */
       Domain* add_dom(const Domain& ad);
 
+      /**
+       * \brief Returns a new unique id for a ContractorNetwork object
+       *
+       * Ids are never reused, so that slices cannot refer to the Domain
+       * of a destroyed CN.
+       *
+       * \return the id
+       */
+      static unsigned long new_cn_id();
+
       /**
        * \brief Adds an abstract Contractor to the graph
        *
@@ -409,16 +533,82 @@ namespace codac
        *
        * \param dom pointer to the Domain
        * \param ctc_to_avoid optional pointer to a Contractor to not activate
+       * \return the ratio of the new volume of the domain over its previous volume
        */
-      void trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = nullptr);
+      double trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = nullptr);
 
       void replace_var_by_dom(Domain var, Domain dom);
 
+      /**
+       * \brief Computes the memory footprints of the contractors and the copies of
+       *        static contractors needed by the threads, before a parallel propagation
+       *
+       * \note This is done again during the propagation, if contractors or domains are
+       *       added to the graph, or if the contractions change the slicing of tubes
+       */
+      void prepare_parallel_propagation();
+
+      /**
+       * \brief Runs in parallel a batch of contractors taken from the queue,
+       *        and triggers the contractors related to their domains
+       */
+      void contract_batch();
+
+      /**
+       * \brief Deactivates a contractor that has just been called, triggers the contractors
+       *        related to its domains, and updates its measures if needed
+       *
+       * \param ctc pointer to the Contractor
+       * \param duration computation time of the call, in seconds (if measured)
+       */
+      void propagate_contraction(Contractor *ctc, double duration);
+
+      /**
+       * \brief Returns the contractors of the graph ranked by decreasing computation time
+       *
+       * \return vector of pointers to the contractors
+       */
+      std::vector<const Contractor*> ranked_profiles() const;
+
+      /**
+       * \brief Moves the contractors of the queue into the heap of contractors
+       *        sorted by expected gain (`EXPECTED_GAIN` scheduling policy)
+       */
+      void move_queue_to_heap();
+
+      /**
+       * \brief Moves the contractors of highest expected gain from the heap
+       *        to the back of the queue, in decreasing order of priority
+       *
+       * \param n maximal number of contractors to be moved
+       */
+      void move_heap_to_queue(size_t n);
+
+      /**
+       * \brief Active contractor waiting in the heap, with its priority at activation
+       */
+      struct HeapItem
+      {
+        double priority; //!< expected gain of the contractor
+        unsigned long seq; //!< order of insertion, for contractors of same priority
+        Contractor *ctc; //!< pointer to the contractor
+
+        bool operator<(const HeapItem& x) const
+        {
+          return priority < x.priority || (priority == x.priority && seq < x.seq);
+        }
+      };
+
     protected:
 
-      std::map<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
-      std::map<ContractorHashcode,Contractor*> m_map_ctc; //!< pointers to the abstract Contractor objects the graph is made of
+      std::unordered_map<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
+      std::unordered_map<ContractorHashcode,Contractor*> m_map_ctc; //!< pointers to the abstract Contractor objects the graph is made of
+      const unsigned long m_cn_id; //!< unique id of this CN, used by slices to cache their related Domain
       std::deque<Contractor*> m_deque; //!< queue of active contractors
+      std::vector<HeapItem> m_heap; //!< active contractors sorted by expected gain (during contractions only)
+      unsigned long m_heap_seq = 0; //!< number of insertions in the heap
+      SchedulingPolicy m_scheduling_policy = SchedulingPolicy::QUEUE; //!< order of calls of active contractors
+      bool m_profiling = false; //!< if true, each call of a contractor is measured
 
       int m_iteration_nb = 0;
       float m_fixedpoint_ratio = 0.0001; //!< fixed point ratio for propagation limit
@@ -427,6 +617,15 @@ namespace codac
       CtcDeriv *m_ctc_deriv = nullptr; //!< optional pointer to a CtcDeriv object that can be automatically added in the graph
       std::list<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv;
 
+      std::unique_ptr<ThreadPool> m_thread_pool; //!< threads used for parallel propagation (nullptr in sequential mode)
+      std::map<Ctc*,std::vector<Ctc*> > m_thread_ctc_copies; //!< copies of static contractors, for each thread
+      std::vector<std::unique_ptr<Function> > m_fnc_copies; //!< functions of the copies of static contractors
+      std::vector<std::unique_ptr<Ctc> > m_ctc_copies; //!< copies of static contractors owned by the CN
+      bool m_footprints_outdated = true; //!< true if the graph has changed since the last computation of the footprints
+
+      static const int MAX_BATCH_SIZE = 1024; //!< maximal number of contractors run in parallel at once
+      static const int BATCH_WINDOW = 4096; //!< number of contractors of the queue examined to build a batch
+
       friend class Domain;
       friend class Contractor;
   };
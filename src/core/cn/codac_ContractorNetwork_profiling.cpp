@@ -0,0 +1,187 @@
+/**
+ *  ContractorNetwork class : profiling of the contractors
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  /**
+   * \brief Escapes a string for the JSON format
+   */
+  static string json_string(const string& s)
+  {
+    string output = "\"";
+    for(const char& c : s)
+    {
+      switch(c)
+      {
+        case '"':  output += "\\\""; break;
+        case '\\': output += "\\\\"; break;
+        case '\n': output += "\\n"; break;
+        case '\t': output += "\\t"; break;
+        default:   output += c;
+      }
+    }
+    return output + "\"";
+  }
+
+  /**
+   * \brief Escapes a string for the CSV format
+   */
+  static string csv_string(const string& s)
+  {
+    string output = "\"";
+    for(const char& c : s)
+    {
+      if(c == '"')
+        output += "\"\"";
+      else
+        output += c;
+    }
+    return output + "\"";
+  }
+
+  // Public methods
+
+    // Profiling
+
+    void ContractorNetwork::enable_profiling(bool enable)
+    {
+      m_profiling = enable;
+    }
+
+    bool ContractorNetwork::profiling_enabled() const
+    {
+      return m_profiling;
+    }
+
+    void ContractorNetwork::reset_profiling()
+    {
+      for(auto& ctc : m_map_ctc)
+        ctc.second->reset_profile();
+    }
+
+    void ContractorNetwork::print_profiling(ostream& str, int nb_ctc) const
+    {
+      assert(nb_ctc >= 0);
+      vector<const Contractor*> v_ctc = ranked_profiles();
+      streamsize precision = str.precision();
+
+      double total_duration = 0.;
+      unsigned long total_calls = 0;
+      for(const auto& ctc : v_ctc)
+      {
+        total_duration += ctc->profile().duration;
+        total_calls += ctc->profile().nb_calls;
+      }
+
+      str << "Profiling of " << v_ctc.size() << " contractors: "
+          << total_calls << " calls, " << total_duration << "s" << endl;
+
+      str << setw(6) << "rank" << setw(10) << "id" << "  " << left << setw(20) << "contractor" << right
+          << setw(10) << "calls" << setw(12) << "time (s)" << setw(8) << "time%"
+          << setw(14) << "contraction" << setw(10) << "triggers" << endl;
+
+      int n = nb_ctc == 0 ? v_ctc.size() : std::min((int)v_ctc.size(), nb_ctc);
+      for(int i = 0 ; i < n ; i++)
+      {
+        const Contractor::Profile& p = v_ctc[i]->profile();
+        if(p.nb_calls == 0)
+          break;
+
+        str << setw(6) << i+1 << setw(10) << v_ctc[i]->id() << "  "
+            << left << setw(20) << v_ctc[i]->name() << right
+            << setw(10) << p.nb_calls
+            << setw(12) << setprecision(4) << p.duration
+            << setw(7) << setprecision(3) << (total_duration > 0. ? 100. * p.duration / total_duration : 0.) << "%"
+            << setw(14) << setprecision(4) << p.contraction / p.nb_calls // mean ratio of volume removed per call
+            << setw(10) << p.nb_triggers << endl;
+      }
+
+      str.precision(precision);
+    }
+
+    void ContractorNetwork::export_profiling(const string& file_name) const
+    {
+      bool json_format;
+      if(file_name.size() >= 5 && file_name.substr(file_name.size() - 5) == ".json")
+        json_format = true;
+      else if(file_name.size() >= 4 && file_name.substr(file_name.size() - 4) == ".csv")
+        json_format = false;
+      else
+        throw Exception(__func__, "unknown file format (expected extension: .json or .csv)");
+
+      ofstream file(file_name, ios::out);
+      if(!file.is_open())
+        throw Exception(__func__, "unable to create the file " + file_name);
+
+      file << setprecision(17);
+      vector<const Contractor*> v_ctc = ranked_profiles();
+
+      if(json_format)
+      {
+        file << "[" << endl;
+        for(size_t i = 0 ; i < v_ctc.size() ; i++)
+        {
+          const Contractor::Profile& p = v_ctc[i]->profile();
+          file << "  {\"id\": " << v_ctc[i]->id()
+               << ", \"contractor\": " << json_string(v_ctc[i]->name())
+               << ", \"nb_calls\": " << p.nb_calls
+               << ", \"time\": " << p.duration
+               << ", \"contraction\": " << p.contraction
+               << ", \"nb_triggers\": " << p.nb_triggers
+               << "}" << (i+1 < v_ctc.size() ? "," : "") << endl;
+        }
+        file << "]" << endl;
+      }
+
+      else
+      {
+        file << "id,contractor,nb_calls,time,contraction,nb_triggers" << endl;
+        for(const auto& ctc : v_ctc)
+        {
+          const Contractor::Profile& p = ctc->profile();
+          file << ctc->id() << "," << csv_string(ctc->name()) << ","
+               << p.nb_calls << "," << p.duration << ","
+               << p.contraction << "," << p.nb_triggers << endl;
+        }
+      }
+
+      file.close();
+    }
+
+  // Protected methods
+
+    vector<const Contractor*> ContractorNetwork::ranked_profiles() const
+    {
+      vector<const Contractor*> v_ctc;
+      v_ctc.reserve(m_map_ctc.size());
+      for(const auto& ctc : m_map_ctc)
+        v_ctc.push_back(ctc.second);
+
+      // Ids break ties, so that the ranking does not depend on the hash tables
+      sort(v_ctc.begin(), v_ctc.end(), [](const Contractor *a, const Contractor *b)
+      {
+        if(a->profile().duration != b->profile().duration)
+          return a->profile().duration > b->profile().duration;
+        return a->id() < b->id();
+      });
+
+      return v_ctc;
+    }
+}
@@ -8,7 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
+#include <chrono>
+#include <algorithm>
+#include <unordered_set>
+#include "ibex_CtcFwdBwd.h"
 #include "codac_ContractorNetwork.h"
 #include "codac_Exception.h"
 
@@ -17,6 +20,28 @@ using namespace ibex;
 
 namespace codac
 {
+  /**
+   * \brief Converts the ratio of volumes of a domain (after/before a contraction)
+   *        into the ratio of volume removed by the contraction
+   */
+  static double contraction_ratio(double volume_ratio)
+  {
+    if(std::isnan(volume_ratio)) // for instance, domains of null or unbounded volumes
+      return 0.;
+    return std::max(0., std::min(1., 1. - volume_ratio));
+  }
+
+  /**
+   * \brief Returns the wall-clock time elapsed since t_start, in seconds
+   *
+   * \note CPU time (clock()) is not used, as it is cumulated over the threads
+   *       of a parallel propagation
+   */
+  static double elapsed_time(const chrono::steady_clock::time_point& t_start)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+  }
+
   // Public methods
 
     // Contraction process
@@ -31,7 +56,7 @@ namespace codac
           throw Exception(__func__, "some CN variables are not associated to domains");
       }
 
-      clock_t t_start = clock();
+      const chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
       for(auto& dom : m_map_domains)
         dom.second->set_volume(dom.second->compute_volume());
 
@@ -45,23 +70,62 @@ namespace codac
         cout << endl;
       }
 
-      while(!m_deque.empty()
-        && (double)(clock() - t_start)/CLOCKS_PER_SEC < m_contraction_duration_max)
+      if(m_thread_pool)
+        prepare_parallel_propagation();
+
+      const bool expected_gain = m_scheduling_policy == SchedulingPolicy::EXPECTED_GAIN;
+      const bool measure = expected_gain || m_profiling;
+
+      while((!m_deque.empty() || !m_heap.empty())
+        && elapsed_time(t_start) < m_contraction_duration_max)
       {
-        Contractor *ctc = m_deque.front();
-        m_deque.pop_front();
+        if(expected_gain)
+          move_queue_to_heap(); // newly triggered contractors are sorted
+
+        if(m_thread_pool)
+        {
+          if(expected_gain)
+            move_heap_to_queue(BATCH_WINDOW);
+
+          if(m_footprints_outdated) // the structure of the graph has changed
+            prepare_parallel_propagation();
+
+          contract_batch();
+          continue;
+        }
+
+        Contractor *ctc;
+        if(expected_gain)
+        {
+          pop_heap(m_heap.begin(), m_heap.end());
+          ctc = m_heap.back().ctc;
+          m_heap.pop_back();
+        }
+
+        else
+        {
+          ctc = m_deque.front();
+          m_deque.pop_front();
+        }
+
+        chrono::steady_clock::time_point t_ctc;
+        if(measure)
+          t_ctc = chrono::steady_clock::now();
 
         ctc->contract();
-        if(ctc->type() != Contractor::Type::T_CN)
-          ctc->set_active(false); // Sub CN will be always triggered
-        
-        for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
-          // If the domain has "changed" after the contraction
-          trigger_ctc_related_to_dom(ctc_dom, ctc);
+
+        double duration = 0.;
+        if(measure)
+          duration = chrono::duration<double>(chrono::steady_clock::now() - t_ctc).count();
+
+        propagate_contraction(ctc, duration);
       }
 
+      // Contractors still active (computation time limit) are kept for next calls
+      move_heap_to_queue(m_heap.size());
+
       if(verbose)
-        cout << "  Constraint propagation time: " << (double)(clock() - t_start)/CLOCKS_PER_SEC << "s" << endl;
+        cout << "  Constraint propagation time: " << elapsed_time(t_start) << "s" << endl;
 
       // Emptiness test
       // todo: test only contracted domains?
@@ -73,7 +137,7 @@ namespace codac
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return elapsed_time(t_start);
     }
 
     double ContractorNetwork::contract(const unordered_map<Domain,Domain>& var_dom, bool verbose)
@@ -99,7 +163,7 @@ namespace codac
     double ContractorNetwork::contract_ordered_mode(bool verbose)
     {
       // todo: reset all saved domains' volumes
-      clock_t t_start = clock();
+      const chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
 
       if(verbose)
       {
@@ -109,7 +173,7 @@ namespace codac
         cout << endl;
       }
 
-      map<DomainHashcode,Domain*> involved_domains;
+      unordered_map<DomainHashcode,Domain*> involved_domains;
       for(const auto& ctc : m_deque)
         for(const auto& dom : ctc->domains())
           involved_domains[DomainHashcode(*dom)] = dom;
@@ -157,7 +221,7 @@ namespace codac
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return elapsed_time(t_start);
     }
 
     double ContractorNetwork::contract_during(double dt, bool verbose)
@@ -182,6 +246,7 @@ namespace codac
     void ContractorNetwork::trigger_all_contractors()
     {
       m_deque.clear();
+      m_heap.clear();
 
       for(const auto& ctc : m_map_ctc)
       {
@@ -214,7 +279,7 @@ namespace codac
 
     int ContractorNetwork::nb_ctc_in_stack() const
     {
-      return m_deque.size();
+      return m_deque.size() + m_heap.size();
     }
 
     int ContractorNetwork::iteration_nb() const
@@ -222,6 +287,38 @@ namespace codac
       return m_iteration_nb;
     }
 
+    void ContractorNetwork::set_scheduling_policy(SchedulingPolicy policy)
+    {
+      m_scheduling_policy = policy;
+    }
+
+    ContractorNetwork::SchedulingPolicy ContractorNetwork::scheduling_policy() const
+    {
+      return m_scheduling_policy;
+    }
+
+    void ContractorNetwork::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0);
+
+      m_thread_pool.reset();
+      m_thread_ctc_copies.clear();
+      m_ctc_copies.clear();
+      m_fnc_copies.clear();
+
+      if(nb_threads == 0)
+        nb_threads = ThreadPool::hardware_concurrency();
+
+      if(nb_threads > 1)
+        m_thread_pool = unique_ptr<ThreadPool>(new ThreadPool(nb_threads));
+      m_footprints_outdated = true;
+    }
+
+    int ContractorNetwork::nb_threads() const
+    {
+      return m_thread_pool ? m_thread_pool->nb_threads() : 1;
+    }
+
   // Protected methods
 
     void ContractorNetwork::add_ctc_to_queue(Contractor *ac, deque<Contractor*>& ctc_deque)
@@ -235,6 +332,171 @@ namespace codac
         ctc_deque.push_front(ac); // priority
     }
 
+    void ContractorNetwork::prepare_parallel_propagation()
+    {
+      for(auto& ctc : m_map_ctc)
+      {
+        Contractor *ac = ctc.second;
+
+        // Sub CNs are run alone: their footprints are only used
+        // to detect changes in the slicing of their tubes
+        bool exclusive_ctc = true;
+
+        if(ac->type() == Contractor::Type::T_IBEX)
+        {
+          Ctc *static_ctc = &ac->ibex_ctc();
+          CtcFwdBwd *fwdbwd = dynamic_cast<CtcFwdBwd*>(static_ctc);
+
+          if(fwdbwd && m_thread_ctc_copies.find(static_ctc) == m_thread_ctc_copies.end())
+          {
+            // Functions are copied too, as their evaluation is not thread-safe.
+            // The original object is not used, as it may also be referenced by dynamic contractors.
+            vector<Ctc*>& v_copies = m_thread_ctc_copies[static_ctc];
+            for(int i = 0 ; i < m_thread_pool->nb_threads() ; i++)
+            {
+              m_fnc_copies.push_back(unique_ptr<Function>(new Function(fwdbwd->f)));
+              m_ctc_copies.push_back(unique_ptr<Ctc>(new CtcFwdBwd(*m_fnc_copies.back(), fwdbwd->d)));
+              v_copies.push_back(m_ctc_copies.back().get());
+            }
+          }
+
+          exclusive_ctc = !fwdbwd;
+        }
+
+        ac->update_memory_footprint(exclusive_ctc);
+      }
+
+      m_footprints_outdated = false;
+    }
+
+    void ContractorNetwork::contract_batch()
+    {
+      // Selecting, in the order of the queue, contractors that do not share memory.
+      // Footprints of skipped contractors are also reserved, so that the order
+      // of the queue is kept between contractors that are in conflict.
+
+      vector<Contractor*> v_batch;
+      deque<Contractor*> skipped_ctc;
+      unordered_set<uintptr_t> reserved_memory;
+
+      for(int i = 0 ; i < BATCH_WINDOW && !m_deque.empty() && (int)v_batch.size() < MAX_BATCH_SIZE ; i++)
+      {
+        Contractor *ctc = m_deque.front();
+        m_deque.pop_front();
+
+        if(ctc->type() == Contractor::Type::T_CN) // sub CNs are run alone
+        {
+          if(v_batch.empty())
+            v_batch.push_back(ctc);
+          else
+            skipped_ctc.push_back(ctc);
+          break;
+        }
+
+        bool conflict = false;
+        for(const auto& key : ctc->memory_footprint())
+          if(reserved_memory.find(key) != reserved_memory.end())
+          {
+            conflict = true;
+            break;
+          }
+
+        if(conflict)
+          skipped_ctc.push_back(ctc);
+        else
+          v_batch.push_back(ctc);
+
+        reserved_memory.insert(ctc->memory_footprint().begin(), ctc->memory_footprint().end());
+      }
+
+      // Skipped contractors keep their place at the front of the queue
+      m_deque.insert(m_deque.begin(), skipped_ctc.begin(), skipped_ctc.end());
+
+      // Parallel contractions
+
+      const bool measure = m_scheduling_policy == SchedulingPolicy::EXPECTED_GAIN || m_profiling;
+      vector<double> v_durations(v_batch.size(), 0.);
+
+      m_thread_pool->run(v_batch.size(), [&](int k, int thread_id)
+      {
+        Contractor *ctc = v_batch[k];
+        Ctc *static_ctc = nullptr;
+
+        if(ctc->type() == Contractor::Type::T_IBEX)
+        {
+          auto it = m_thread_ctc_copies.find(&ctc->ibex_ctc());
+          if(it != m_thread_ctc_copies.end())
+            static_ctc = it->second[thread_id];
+        }
+
+        chrono::steady_clock::time_point t_ctc;
+        if(measure)
+          t_ctc = chrono::steady_clock::now();
+
+        ctc->contract(static_ctc);
+
+        if(measure)
+          v_durations[k] = chrono::duration<double>(chrono::steady_clock::now() - t_ctc).count();
+      });
+
+      // Propagation, as if contractors of the batch had been called in sequence
+
+      for(size_t k = 0 ; k < v_batch.size() ; k++)
+      {
+        // Tubes sampled by the contraction have new slices and gates
+        if(v_batch[k]->memory_footprint_outdated())
+          m_footprints_outdated = true;
+
+        propagate_contraction(v_batch[k], v_durations[k]);
+      }
+    }
+
+    void ContractorNetwork::propagate_contraction(Contractor *ctc, double duration)
+    {
+      if(ctc->type() != Contractor::Type::T_CN)
+        ctc->set_active(false); // Sub CN will be always triggered
+
+      size_t nb_active_ctc = m_deque.size();
+      const vector<Domain*> v_domains = ctc->domains();
+
+      double contraction = 0.;
+      for(auto& ctc_dom : v_domains) // for each domain related to this contractor
+        // If the domain has "changed" after the contraction
+        contraction += contraction_ratio(trigger_ctc_related_to_dom(ctc_dom, ctc));
+
+      if(!v_domains.empty())
+        contraction /= v_domains.size();
+
+      if(m_scheduling_policy == SchedulingPolicy::EXPECTED_GAIN && !v_domains.empty())
+        ctc->update_efficiency(contraction, duration);
+
+      if(m_profiling) // activated contractors are pushed in the queue
+        ctc->add_to_profile(duration, contraction, m_deque.size() - nb_active_ctc);
+    }
+
+    void ContractorNetwork::move_queue_to_heap()
+    {
+      // The front of the queue is inserted last: for equal priorities,
+      // the order of the queue is kept
+      for(auto it = m_deque.rbegin() ; it != m_deque.rend() ; ++it)
+      {
+        m_heap.push_back({ (*it)->priority(), m_heap_seq++, *it });
+        push_heap(m_heap.begin(), m_heap.end());
+      }
+
+      m_deque.clear();
+    }
+
+    void ContractorNetwork::move_heap_to_queue(size_t n)
+    {
+      for(size_t i = 0 ; i < n && !m_heap.empty() ; i++)
+      {
+        pop_heap(m_heap.begin(), m_heap.end());
+        m_deque.push_back(m_heap.back().ctc);
+        m_heap.pop_back();
+      }
+    }
+
     void ContractorNetwork::reset_value(Domain *dom)
     {
       dom->reset_value();
@@ -252,11 +514,12 @@ namespace codac
       // todo: }
     }
 
-    void ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
+    double ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
     {
       double current_volume = dom->compute_volume(); // new volume after contraction
+      double volume_ratio = current_volume/dom->get_saved_volume();
 
-      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio)
+      if(volume_ratio < 1.-m_fixedpoint_ratio)
       {
         // We activate each contractor related to these domains, according to graph orientation
 
@@ -295,6 +558,8 @@ namespace codac
           // .
           break;
       }
+
+      return volume_ratio;
     }
 
     void ContractorNetwork::replace_var_by_dom(Domain var, Domain dom)
@@ -335,6 +600,7 @@ namespace codac
 
       Domain* var_ptr = m_map_domains[hashcode];
       var_ptr->set_ref_values(dom);
+      m_footprints_outdated = true; // the domain now refers to other values
       trigger_ctc_related_to_dom(var_ptr);
 
       switch(var.type())
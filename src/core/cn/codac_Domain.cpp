@@ -542,27 +542,14 @@ namespace codac
       }
 
       case Type::T_TUBE:
-      {
-        double vol = tube().volume();
-        vol += tube().first_slice()->input_gate().diam();
-        for(const Slice *s = tube().first_slice() ; s ; s = s->next_slice())
-          vol += s->output_gate().diam();
-        return vol;
-      }
+        // Volumes of tubes are maintained incrementally
+        return tube().volume() + tube().gates_volume();
 
       case Type::T_TUBE_VECTOR:
       {
-        // todo: improve this
         double vol = 0.;
-
         for(int i = 0 ; i < tube_vector().size() ; i++)
-        {
-          vol += tube_vector()[i].volume();
-          vol += tube_vector()[i].first_slice()->input_gate().diam();
-          for(const Slice *s = tube_vector()[i].first_slice() ; s ; s = s->next_slice())
-            vol += s->output_gate().diam();
-        }
-        
+          vol += tube_vector()[i].volume() + tube_vector()[i].gates_volume();
         return vol;
       }
 
@@ -583,6 +570,65 @@ namespace codac
     m_volume = vol;
   }
 
+  void Domain::memory_footprint(vector<uintptr_t>& v_keys) const
+  {
+    auto add_key = [&v_keys](const void *ptr)
+    {
+      v_keys.push_back(reinterpret_cast<uintptr_t>(ptr));
+    };
+
+    auto add_tube_keys = [&add_key](const Tube& x)
+    {
+      // Slices of the tube may be domains of other contractors
+      add_key(&x);
+      add_key(x.first_slice()->m_input_gate);
+      for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+      {
+        add_key(s);
+        add_key(s->m_output_gate);
+      }
+
+      if(x.first_slice()->m_synthesis_reference)
+        add_key(x.first_slice()->m_synthesis_reference);
+    };
+
+    switch(m_type)
+    {
+      case Type::T_INTERVAL:
+        add_key(&interval());
+        break;
+
+      case Type::T_INTERVAL_VECTOR:
+        // Components, that may be domains of other contractors
+        for(int i = 0 ; i < interval_vector().size() ; i++)
+          add_key(&interval_vector()[i]);
+        break;
+
+      case Type::T_SLICE:
+        // Gates are shared with neighbour slices
+        add_key(&slice());
+        add_key(slice().m_input_gate);
+        add_key(slice().m_output_gate);
+
+        // The synthesis tree of the tube is updated when the slice is set
+        if(slice().m_synthesis_reference)
+          add_key(slice().m_synthesis_reference);
+        break;
+
+      case Type::T_TUBE:
+        add_tube_keys(tube());
+        break;
+
+      case Type::T_TUBE_VECTOR:
+        for(int i = 0 ; i < tube_vector().size() ; i++)
+          add_tube_keys(tube_vector()[i]);
+        break;
+
+      default:
+        assert(false && "unhandled case");
+    }
+  }
+
   bool Domain::is_interm_var() const
   {
     switch(m_type)
@@ -917,7 +963,7 @@ namespace codac
     }
   }
   
-  const string Domain::var_name(const map<DomainHashcode,Domain*> m_domains) const
+  const string Domain::var_name(const unordered_map<DomainHashcode,Domain*>& m_domains) const
   {
     string output_name = m_name;
 
@@ -1077,7 +1123,7 @@ namespace codac
     return n;
   }
 
-  const string Domain::dom_name(const map<DomainHashcode,Domain*> m_domains) const
+  const string Domain::dom_name(const unordered_map<DomainHashcode,Domain*>& m_domains) const
   {
     string output_name = var_name(m_domains);
 
@@ -13,6 +13,8 @@
 #define __CODAC_DOMAIN_H__
 
 #include <functional>
+#include <unordered_map>
+#include <cstdint>
 #include "codac_Interval.h"
 #include "codac_Variable.h"
 #include "codac_IntervalVector.h"
@@ -86,6 +88,17 @@ namespace codac
       double get_saved_volume() const;
       void set_volume(double vol);
 
+      /**
+       * \brief Appends the memory locations that can be modified through this domain
+       *
+       * Two domains can be contracted in parallel if they have no location in common.
+       * Locations are the intervals of the domain, the envelopes and gates of the
+       * slices, and the synthesis trees updated by the slices.
+       *
+       * \param v_keys vector of addresses the locations are appended to
+       */
+      void memory_footprint(std::vector<std::uintptr_t>& v_keys) const;
+
       bool is_interm_var() const;
       void reset_value();
 
@@ -103,7 +116,7 @@ namespace codac
       void add_data(double t, const Interval& y, ContractorNetwork& cn);
       void add_data(double t, const IntervalVector& y, ContractorNetwork& cn);
 
-      const std::string dom_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string dom_name(const std::unordered_map<DomainHashcode,Domain*>& m_domains) const;
       void set_name(const std::string& name);
 
       static bool all_dyn(const std::vector<Domain>& v_domains);
@@ -119,7 +132,7 @@ namespace codac
     protected:
 
       Domain(Type type, MemoryRef memory_type);
-      const std::string var_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string var_name(const std::unordered_map<DomainHashcode,Domain*>& m_domains) const;
 
       // Theoretical type of domain
 
@@ -24,49 +24,46 @@ namespace codac
   ContractorHashcode::ContractorHashcode(const Contractor& ctc)
   {
     if(ctc.m_type == Contractor::Type::T_CN)
-    {
-      m_ptr = new std::uintptr_t[1];
-      m_ptr[0] = reinterpret_cast<std::uintptr_t>(&ctc.m_cn_ctc.get());
-    }
+      m_ptr.push_back(reinterpret_cast<std::uintptr_t>(&ctc.m_cn_ctc.get()));
 
     else
     {
-      m_n = ctc.m_v_domains.size()+1;
-      m_ptr = new std::uintptr_t[m_n];
+      size_t n = ctc.m_v_domains.size()+1;
+      m_ptr.resize(n);
 
-      for(size_t i = 0 ; i < m_n-1 ; i++)
+      for(size_t i = 0 ; i < n-1 ; i++)
         m_ptr[i] = DomainHashcode::uintptr(*ctc.m_v_domains[i]);
 
       switch(ctc.m_type)
       {
         case Contractor::Type::T_EQUALITY:
-          m_ptr[m_n-1] = 0; // todo: check this
+          m_ptr[n-1] = 0; // todo: check this
           break;
 
         case Contractor::Type::T_COMPONENT:
-          m_ptr[m_n-1] = 1; // todo: check this
+          m_ptr[n-1] = 1; // todo: check this
           break;
           
         case Contractor::Type::T_IBEX:
-          m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
-          assert(m_ptr[m_n-1] > 4); // reserved codes
+          m_ptr[n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
+          assert(m_ptr[n-1] > 4); // reserved codes
           break;
 
         case Contractor::Type::T_CODAC:
 
           if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcEval))
-            m_ptr[m_n-1] = 2;
+            m_ptr[n-1] = 2;
 
           else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDeriv))
-            m_ptr[m_n-1] = 3;
+            m_ptr[n-1] = 3;
 
           else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDist))
-            m_ptr[m_n-1] = 4;
+            m_ptr[n-1] = 4;
 
           else
           {
-            m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
-            assert(m_ptr[m_n-1] > 4); // reserved codes
+            m_ptr[n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
+            assert(m_ptr[n-1] > 4); // reserved codes
           }
 
           break;
@@ -75,19 +72,26 @@ namespace codac
           assert(false && "unhandled case");
       }
     }
+
+    // Combination of the hash values of each address
+    m_hash = m_ptr.size();
+    for(const auto& ptr : m_ptr)
+      m_hash ^= DomainHashcode::hash_ptr(ptr) + 0x9e3779b9 + (m_hash << 6) + (m_hash >> 2);
   }
 
   bool ContractorHashcode::operator<(const ContractorHashcode& a) const
   {
-    for(size_t i = 0 ; i < std::min(m_n, a.m_n) ; i++)
-    {
-      if(m_ptr[i] == a.m_ptr[i])
-        continue;
+    return m_ptr < a.m_ptr;
+  }
 
-      return m_ptr[i] < a.m_ptr[i];
-    }
+  bool ContractorHashcode::operator==(const ContractorHashcode& a) const
+  {
+    return m_hash == a.m_hash && m_ptr == a.m_ptr;
+  }
 
-    return false;
+  size_t ContractorHashcode::hash() const
+  {
+    return m_hash;
   }
 
   // DomainHashcode class
@@ -95,6 +99,7 @@ namespace codac
   DomainHashcode::DomainHashcode(const Domain& dom)
   {
     m_ptr = DomainHashcode::uintptr(dom);
+    m_hash = hash_ptr(m_ptr);
   }
 
   bool DomainHashcode::operator<(const DomainHashcode& a) const
@@ -102,6 +107,28 @@ namespace codac
     return m_ptr < a.m_ptr;
   }
 
+  bool DomainHashcode::operator==(const DomainHashcode& a) const
+  {
+    return m_ptr == a.m_ptr;
+  }
+
+  size_t DomainHashcode::hash() const
+  {
+    return m_hash;
+  }
+
+  size_t DomainHashcode::hash_ptr(uintptr_t ptr)
+  {
+    // Finalizer of MurmurHash3 (64 bits)
+    uint64_t h = ptr;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb53fe85a34cbULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
   uintptr_t DomainHashcode::uintptr(const Domain& dom)
   {
     uintptr_t ptr = 0;
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <vector>
 #include <functional>
 
 namespace codac
@@ -21,31 +22,73 @@ namespace codac
   class Domain;
   class Contractor;
   
+  /**
+   * \class ContractorHashcode
+   * \brief Key identifying a Contractor in a ContractorNetwork
+   *
+   * The key is made of the addresses of the domains involved in the contractor,
+   * and of a code related to the contractor itself. Its hash value is computed
+   * once at construction, for constant time lookups in hash tables.
+   */
   class ContractorHashcode
   {
     public:
 
       ContractorHashcode(const Contractor& ctc);
       bool operator<(const ContractorHashcode& a) const;
+      bool operator==(const ContractorHashcode& a) const;
+
+      /**
+       * \brief Returns the precomputed hash value of this key
+       *
+       * \return the hash value
+       */
+      size_t hash() const;
 
     protected:
 
-      size_t m_n;
-      std::uintptr_t *m_ptr;
+      std::vector<std::uintptr_t> m_ptr; //!< addresses of the domains, followed by the contractor code
+      size_t m_hash; //!< precomputed hash value
   };
 
+  /**
+   * \class DomainHashcode
+   * \brief Key identifying a Domain in a ContractorNetwork
+   *
+   * The key is the address of the values referenced by the domain.
+   */
   class DomainHashcode
   {
     public:
 
       DomainHashcode(const Domain& dom);
       bool operator<(const DomainHashcode& a) const;
+      bool operator==(const DomainHashcode& a) const;
+
+      /**
+       * \brief Returns the precomputed hash value of this key
+       *
+       * \return the hash value
+       */
+      size_t hash() const;
 
       static std::uintptr_t uintptr(const Domain& dom);
 
+      /**
+       * \brief Mixes the bits of an address into a hash value
+       *
+       * Addresses of allocated objects are aligned: their low bits are
+       * always zero and must be spread before being used as hash values.
+       *
+       * \param ptr the address
+       * \return the hash value
+       */
+      static size_t hash_ptr(std::uintptr_t ptr);
+
     protected:
 
-      std::uintptr_t m_ptr;
+      std::uintptr_t m_ptr; //!< address of the values referenced by the domain
+      size_t m_hash; //!< precomputed hash value
   };
 }
 
@@ -59,6 +102,24 @@ namespace std
       return codac::DomainHashcode::uintptr(dom);
     }
   };
+
+  template <>
+  struct hash<codac::DomainHashcode>
+  {
+    size_t operator()(const codac::DomainHashcode& h) const
+    {
+      return h.hash();
+    }
+  };
+
+  template <>
+  struct hash<codac::ContractorHashcode>
+  {
+    size_t operator()(const codac::ContractorHashcode& h) const
+    {
+      return h.hash();
+    }
+  };
 }
 
 
@@ -73,48 +73,99 @@ namespace codac
       throw DomainsTypeException(m_ctc_name, v_domains, m_str_expected_doms);
   }
 
+  void CtcDeriv::set_fused_sweep(bool fused)
+  {
+    m_fused_sweep = fused;
+  }
+
   void CtcDeriv::contract(Tube& x, const Tube& v, TimePropag t_propa)
   {
     assert(x.tdomain() == v.tdomain());
     assert(Tube::same_slicing(x, v));
     
-    if(t_propa & TimePropag::FORWARD)
+    vector<Tube*> v_x({&x});
+    vector<const Tube*> v_v({&v});
+    contract_sweep(v_x, v_v, t_propa);
+  }
+
+  void CtcDeriv::contract(TubeVector& x, const TubeVector& v, TimePropag t_propa)
+  {
+    assert(x.size() == v.size());
+    assert(x.tdomain() == v.tdomain());
+    assert(TubeVector::same_slicing(x, v));
+
+    vector<Tube*> v_x(x.size());
+    vector<const Tube*> v_v(v.size());
+    for(int i = 0 ; i < x.size() ; i++)
     {
-      Slice *s_x = x.first_slice();
-      const Slice *s_v = v.first_slice();
+      v_x[i] = &x[i];
+      v_v[i] = &v[i];
+    }
+
+    contract_sweep(v_x, v_v, t_propa);
+  }
 
-      while(s_x)
+  void CtcDeriv::contract_sweep(const vector<Tube*>& v_x, const vector<const Tube*>& v_v, TimePropag t_propa)
+  {
+    assert(v_x.size() == v_v.size());
+
+    // The slices of all the components are walked in lockstep
+    const size_t n = v_x.size();
+    vector<Slice*> v_sx(n);
+    vector<const Slice*> v_sv(n);
+
+    // In fused mode, the forward sweep only propagates the gates: slices are
+    // completely contracted once, by the backward sweep, with the final gates
+    bool fused = m_fused_sweep && (t_propa & TimePropag::FORWARD) && (t_propa & TimePropag::BACKWARD);
+
+    if(t_propa & TimePropag::FORWARD)
+    {
+      for(size_t i = 0 ; i < n ; i++)
       {
-        assert(s_v);
-        contract(*s_x, *s_v, t_propa);
-        s_x = s_x->next_slice();
-        s_v = s_v->next_slice();
+        v_sx[i] = v_x[i]->first_slice();
+        v_sv[i] = v_v[i]->first_slice();
       }
+
+      while(v_sx[0])
+        for(size_t i = 0 ; i < n ; i++)
+        {
+          assert(v_sv[i]);
+          if(fused)
+            contract_output_gate(*v_sx[i], *v_sv[i]);
+          else
+            contract(*v_sx[i], *v_sv[i], t_propa);
+          v_sx[i] = v_sx[i]->next_slice();
+          v_sv[i] = v_sv[i]->next_slice();
+        }
     }
     
     if(t_propa & TimePropag::BACKWARD)
     {
-      Slice *s_x = x.last_slice();
-      const Slice *s_v = v.last_slice();
-
-      while(s_x)
+      for(size_t i = 0 ; i < n ; i++)
       {
-        assert(s_v);
-        contract(*s_x, *s_v, t_propa);
-        s_x = s_x->prev_slice();
-        s_v = s_v->prev_slice();
+        v_sx[i] = v_x[i]->last_slice();
+        v_sv[i] = v_v[i]->last_slice();
       }
+
+      while(v_sx[0])
+        for(size_t i = 0 ; i < n ; i++)
+        {
+          assert(v_sv[i]);
+          contract(*v_sx[i], *v_sv[i], t_propa);
+          v_sx[i] = v_sx[i]->prev_slice();
+          v_sv[i] = v_sv[i]->prev_slice();
+        }
     }
   }
 
-  void CtcDeriv::contract(TubeVector& x, const TubeVector& v, TimePropag t_propa)
+  void CtcDeriv::contract_output_gate(Slice& x, const Slice& v)
   {
-    assert(x.size() == v.size());
     assert(x.tdomain() == v.tdomain());
-    assert(TubeVector::same_slicing(x, v));
 
-    for(int i = 0 ; i < x.size() ; i++)
-      contract(x[i], v[i], t_propa);
+    if(!x.tdomain().intersects(m_restricted_tdomain))
+      return;
+
+    x.set_output_gate(x.output_gate() & (x.input_gate() + x.tdomain().diam() * v.codomain()));
   }
   
   void CtcDeriv::contract(Slice& x, const Slice& v, TimePropag t_propa)
@@ -35,6 +35,17 @@ namespace codac
        */
       CtcDeriv();
 
+      /**
+       * \brief Specifies whether forward and backward contractions of tubes are fused
+       *
+       * When both ways of propagation are requested, the forward sweep then only propagates
+       * the gates, and each slice is completely contracted once during the backward sweep.
+       * This avoids half of the polygon computations, for the same resulting tube.
+       *
+       * \param fused if true, fused mode enabled (disabled by default)
+       */
+      void set_fused_sweep(bool fused = true);
+
       /*
        * \brief Contracts a set of abstract domains
        *
@@ -97,6 +108,25 @@ namespace codac
        * \param v the derivative slice \f$\llbracket v\rrbracket(\cdot)\f$
        */
       void contract_gates(Slice& x, const Slice& v);
+
+      /**
+       * \brief Contracts tubes over their slices, walked in lockstep for all the components
+       *
+       * \param v_x the components of the tube \f$[\mathbf{x}](\cdot)\f$
+       * \param v_v the components of the derivative tube \f$[\mathbf{v}](\cdot)\f$
+       * \param t_propa temporal way(s) of propagation
+       */
+      void contract_sweep(const std::vector<Tube*>& v_x, const std::vector<const Tube*>& v_v, TimePropag t_propa);
+
+      /**
+       * \brief Contracts the output gate of a slice from its input gate and its derivative set
+       *
+       * \param x the slice \f$\llbracket x\rrbracket(\cdot)\f$
+       * \param v the derivative slice \f$\llbracket v\rrbracket(\cdot)\f$
+       */
+      void contract_output_gate(Slice& x, const Slice& v);
+
+      bool m_fused_sweep = false; //!< if true, forward and backward contractions of tubes are fused
       
       friend class CtcEval; // contract_gates used by CtcEval
 
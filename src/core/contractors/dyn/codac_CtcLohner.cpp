@@ -10,11 +10,13 @@
 
 #include "codac_CtcLohner.h"
 
+#include <memory>
 #include <codac_CtcLohner.h>
 #include <Eigen/QR>
 #include <ibex.h>
 #include <codac_Eigen.h>
 #include <codac_DomainsTypeException.h>
+#include <codac_ThreadPool.h>
 
 
 using namespace ibex;
@@ -37,8 +39,8 @@ struct GlobalEnclosureError : public std::runtime_error {
 /**
  * \class LohnerAlgorithm
  *
- * \brief Simple first order Lohner algorithm to perform guaranteed integration of a system
- * \f$\dot{\mathbf{x}}=\mathbf{f}(\mathbf{x})\f$
+ * \brief Lohner algorithm to perform guaranteed integration of a system
+ * \f$\dot{\mathbf{x}}=\mathbf{f}(\mathbf{x})\f$, based on Taylor expansions of a given order
  */
 class LohnerAlgorithm {
 public:
@@ -53,13 +55,16 @@ public:
    * \param u0 initial condition of the system
    * \param contractions number of contractions of the global enclosure by the estimated local enclosure
    * \param eps inflation parameter for the global enclosure
+   * \param coefs Taylor coefficients \f$\mathbf{f}^{[k]}\f$ for \f$k\in[2,p]\f$, where \f$p\f$ is the order
+   *        of the method (order 2 if empty, the remainder being then computed from the jacobian of f)
    */
   LohnerAlgorithm(const Function *f,
                   double h,
                   bool forward,
                   const IntervalVector &u0 = IntervalVector::empty(1),
                   int contractions = 1,
-                  double eps = 0.1);
+                  double eps = 0.1,
+                  const std::vector<std::shared_ptr<Function> > &coefs = std::vector<std::shared_ptr<Function> >());
   /**
    * \brief integrate the system over a given number of steps
    *
@@ -90,6 +95,13 @@ public:
    * \return local enclosure \f$[\mathbf{x}_{k}]\f$
    */
   const IntervalVector &getGlobalEnclosure() const;
+
+  /**
+   * \brief Returns the Taylor-Lagrange remainder of the previous integration step
+   *
+   * \return enclosure of the remainder
+   */
+  const IntervalVector &getRemainder() const;
 private:
   /**
    * \brief Computes an estimation of the global enclosure of the system
@@ -100,20 +112,67 @@ private:
    */
   IntervalVector globalEnclosure(const IntervalVector &initialGuess, double dir);
 
+  /**
+   * \brief Computes the Taylor-Lagrange remainder of the step
+   *
+   * \param x global enclosure over the step
+   * \return enclosure of the remainder \f$(\pm h)^p\mathbf{f}^{[p]}([\mathbf{x}])\f$
+   */
+  IntervalVector remainder(const IntervalVector &x) const;
+
   unsigned int dim; //!< dimension of the system's state
   double h; //!< integration time step
   double direction; //!< forward or backward integration
   double eps; //!< inflation parameter for the global enclosure
   int contractions; //!< number of contractions of the global enclosure by the estimated local enclosure
   IntervalVector u; //!< local enclosure
-  IntervalVector z; //!< Taylor-Lagrange remainder (order 2)
+  IntervalVector z; //!< Taylor-Lagrange remainder
   IntervalVector r; //!< enclosure of uncertainties in the frame given by the matrix B
   IntervalVector u_tilde; //!< global enclosure
   Matrix B, Binv;
   Vector u_hat; //!< center of the box u
   const Function *f; //!< litteral function of the system \f$\dot{\mathbf{x}}=\mathbf{f}(\mathbf{x})\f$
+  std::vector<std::shared_ptr<Function> > coefs; //!< Taylor coefficients \f$\mathbf{f}^{[k]}\f$, from \f$k=2\f$
 };
 
+/**
+ * \brief Builds the Taylor coefficients of the solutions of \f$\dot{\mathbf{x}}=\mathbf{f}(\mathbf{x})\f$,
+ * defined by \f$\mathbf{f}^{[1]}=\mathbf{f}\f$ and
+ * \f$\mathbf{f}^{[k]}=\frac{1}{k}\frac{\partial\mathbf{f}^{[k-1]}}{\partial\mathbf{x}}\mathbf{f}\f$
+ *
+ * \param f function of the system
+ * \param order maximal order \f$p\f$ of the coefficients
+ * \param coefs the coefficients \f$\mathbf{f}^{[k]}\f$ for \f$k\in[2,p]\f$
+ * \param applied functions applied in the expressions of the coefficients, to be kept alive with them
+ */
+static void taylorCoefficients(const Function &f,
+                               int order,
+                               vector<shared_ptr<Function> > &coefs,
+                               vector<shared_ptr<Function> > &applied) {
+  coefs.clear();
+  applied.clear();
+  if (order <= 2) // the remainder is computed from the jacobian of f
+    return;
+
+  applied.push_back(make_shared<Function>(f));
+  shared_ptr<Function> fk = applied[0];
+
+  for (int k = 2; k <= order; ++k) {
+    applied.push_back(make_shared<Function>(fk->diff()));
+    const Function &dfk = *applied.back();
+
+    Array<const ExprSymbol> x(f.nb_arg());
+    Array<const ExprNode> x_nodes(f.nb_arg());
+    for (int i = 0; i < f.nb_arg(); ++i) {
+      x.set_ref(i, ExprSymbol::new_(f.arg_name(i), f.arg(i).dim));
+      x_nodes.set_ref(i, x[i]);
+    }
+
+    fk = make_shared<Function>(x, (1. / k) * (dfk(x_nodes) * (*applied[0])(x_nodes)));
+    coefs.push_back(fk);
+  }
+}
+
 // --
 
 LohnerAlgorithm::LohnerAlgorithm(const Function *f,
@@ -121,7 +180,8 @@ LohnerAlgorithm::LohnerAlgorithm(const Function *f,
                                  bool forward,
                                  const IntervalVector &u0,
                                  int contractions,
-                                 double eps)
+                                 double eps,
+                                 const std::vector<std::shared_ptr<Function> > &coefs)
     : dim(f->nb_var()),
       h(h),
       direction((forward) ? FWD : BWD),
@@ -133,7 +193,8 @@ LohnerAlgorithm::LohnerAlgorithm(const Function *f,
       B(Matrix::eye(dim)),
       Binv(Matrix::eye(dim)),
       u_hat(u0.mid()),
-      f(f) {}
+      f(f),
+      coefs(coefs) {}
 
 const IntervalVector &LohnerAlgorithm::integrate(unsigned int steps, double H) {
   if (H > 0) h = H;
@@ -143,14 +204,18 @@ const IntervalVector &LohnerAlgorithm::integrate(unsigned int steps, double H) {
     auto u_hat1 = u_hat;
     IntervalVector u_t = globalEnclosure(u, FWD);
     for (int j = 0; j < contractions; ++j) {
-      z1 = 0.5 * h * h * f->jacobian(u_t) * f->eval_vector(u_t);
+      z1 = remainder(u_t);
       Vector m1 = z1.mid();
       IntervalMatrix A = Matrix::eye(dim) + h * direction * f->jacobian(u);
+      for (int k = 2; k < (int)coefs.size() + 1; ++k) // higher order terms, if any
+        A += pow(Interval(h * direction), k) * coefs[k - 2]->jacobian(u);
       Eigen::HouseholderQR<Eigen::MatrixXd> qr(EigenHelpers::i2e((A * B).mid()));
       B1 = EigenHelpers::e2i(qr.householderQ());
       B1inv = ibex::real_inverse(B1);
       r1 = (B1inv * A * B) * r + B1inv * (z1 - m1);
       u_hat1 = u_hat + h * direction * f->eval_vector(u_hat).mid() + m1;
+      for (int k = 2; k < (int)coefs.size() + 1; ++k)
+        u_hat1 += (pow(Interval(h * direction), k) * coefs[k - 2]->eval_vector(u_hat)).mid();
       u1 = u_hat1 + B1 * r1;
       if (j < contractions - 1) {
         u_t = u_t & globalEnclosure(u1, BWD);
@@ -174,6 +239,12 @@ IntervalVector LohnerAlgorithm::globalEnclosure(const IntervalVector &initialGue
   throw GlobalEnclosureError();
 }
 
+IntervalVector LohnerAlgorithm::remainder(const IntervalVector &x) const {
+  if (coefs.empty()) // order 2
+    return 0.5 * h * h * f->jacobian(x) * f->eval_vector(x);
+  return pow(Interval(h * direction), (int)coefs.size() + 1) * coefs.back()->eval_vector(x);
+}
+
 void LohnerAlgorithm::contractStep(const IntervalVector &x) {
   u = x & u;
   u_hat = u.mid();
@@ -188,6 +259,10 @@ const IntervalVector &LohnerAlgorithm::getGlobalEnclosure() const {
   return u_tilde;
 }
 
+const IntervalVector &LohnerAlgorithm::getRemainder() const {
+  return z;
+}
+
 CtcLohner::CtcLohner(const Function &f, int contractions, double eps)
     : DynCtc(),
       m_f(f),
@@ -195,50 +270,175 @@ CtcLohner::CtcLohner(const Function &f, int contractions, double eps)
       dim(f.nb_var()),
       eps(eps) {}
 
+void CtcLohner::set_order(int order) {
+  assert(order >= 2);
+  m_order = order;
+  taylorCoefficients(m_f, order, m_taylor_coefs, m_taylor_applied);
+}
+
+int CtcLohner::order() const {
+  return m_order;
+}
+
+void CtcLohner::set_adaptive_step(bool adaptive, double tol) {
+  assert(tol > 0.);
+  m_adaptive_step = adaptive;
+  m_step_tol = tol;
+}
+
 void CtcLohner::contract(codac::TubeVector &tube, TimePropag t_propa) {
   assert((!tube.is_empty()) && (tube.size() == dim));
   IntervalVector input_gate(dim, Interval(0)), output_gate(dim, Interval(0)), slice(dim, Interval(0));
+  vector<Slice *> v_s(dim); // slices of the components at the current step
   double h;
+  if (m_adaptive_step) {
+    if (t_propa & TimePropag::FORWARD)
+      contract_adaptive(tube, true);
+    if (t_propa & TimePropag::BACKWARD)
+      contract_adaptive(tube, false);
+    return;
+  }
   if (t_propa & TimePropag::FORWARD) {
     for (int j = 0; j < dim; ++j) {
-      input_gate[j] = tube[j].slice(0)->input_gate();
+      v_s[j] = tube[j].first_slice();
+      input_gate[j] = v_s[j]->input_gate();
     }
-    LohnerAlgorithm lo(&m_f, 0.1, true, input_gate, contractions, eps);
+    LohnerAlgorithm lo(&m_f, 0.1, true, input_gate, contractions, eps, m_taylor_coefs);
     // Forward loop
-    for (int i = 0; i < tube.nb_slices(); ++i) {
-      h = tube[0].slice(i)->tdomain().diam();
+    while (v_s[0]) {
+      h = v_s[0]->tdomain().diam();
       for (int j = 0; j < dim; ++j) {
-        output_gate[j] = tube[j].slice(i)->output_gate();
-        slice[j] = tube[j].slice(i)->codomain();
+        output_gate[j] = v_s[j]->output_gate();
+        slice[j] = v_s[j]->codomain();
       }
       lo.integrate(1, h);
       lo.contractStep(output_gate);
-      for (int j = 0; j < dim; ++j)
-        tube[j].slice(i)->set_envelope(slice[j] & lo.getGlobalEnclosure()[j]);
+      for (int j = 0; j < dim; ++j) {
+        v_s[j]->set_envelope(slice[j] & lo.getGlobalEnclosure()[j]);
+        v_s[j] = v_s[j]->next_slice();
+      }
     }
     tube.set(output_gate & lo.getLocalEnclosure(), tube.tdomain().ub());
   }
   if (t_propa & TimePropag::BACKWARD) {
     for (int j = 0; j < dim; ++j) {
-      input_gate[j] = tube[j].last_slice()->output_gate();
+      v_s[j] = tube[j].last_slice();
+      input_gate[j] = v_s[j]->output_gate();
     }
-    LohnerAlgorithm lo2(&m_f, 0.1, false, input_gate, contractions, eps);
+    LohnerAlgorithm lo2(&m_f, 0.1, false, input_gate, contractions, eps, m_taylor_coefs);
     // Backward loop
-    for (int i = tube.nb_slices() - 1; i >= 0; --i) {
-      h = tube[0].slice(i)->tdomain().diam();
+    while (v_s[0]) {
+      h = v_s[0]->tdomain().diam();
       for (int j = 0; j < dim; ++j) {
-        output_gate[j] = tube[j].slice(i)->input_gate();
-        slice[j] = tube[j].slice(i)->codomain();
+        output_gate[j] = v_s[j]->input_gate();
+        slice[j] = v_s[j]->codomain();
       }
       lo2.integrate(1, h);
       lo2.contractStep(output_gate);
-      for (int j = 0; j < dim; ++j)
-        tube[j].slice(i)->set_envelope(slice[j] & lo2.getGlobalEnclosure()[j]);
+      for (int j = 0; j < dim; ++j) {
+        v_s[j]->set_envelope(slice[j] & lo2.getGlobalEnclosure()[j]);
+        v_s[j] = v_s[j]->prev_slice();
+      }
     }
     tube.set(output_gate & lo2.getLocalEnclosure(), tube.tdomain().lb());
   }
 }
 
+void CtcLohner::contract_adaptive(codac::TubeVector &tube, bool forward) {
+  // Slices are walked in the direction of the integration
+  auto next = [forward](Slice *s) { return forward ? s->next_slice() : s->prev_slice(); };
+  auto t_begin = [forward](const Slice *s) { return forward ? s->tdomain().lb() : s->tdomain().ub(); };
+  auto t_end = [forward](const Slice *s) { return forward ? s->tdomain().ub() : s->tdomain().lb(); };
+
+  IntervalVector input_gate(dim), output_gate(dim), hull(dim, Interval::EMPTY_SET);
+  vector<Slice *> v_s(dim), v_last(dim); // first and last slices covered by the step
+  for (int j = 0; j < dim; ++j) {
+    v_s[j] = forward ? tube[j].first_slice() : tube[j].last_slice();
+    input_gate[j] = forward ? v_s[j]->input_gate() : v_s[j]->output_gate();
+  }
+
+  LohnerAlgorithm lo(&m_f, 0.1, forward, input_gate, contractions, eps, m_taylor_coefs);
+  const double h_min = 1e-9 * tube.tdomain().diam();
+  double h = v_s[0]->tdomain().diam(); // step of the next integration
+  double t = t_begin(v_s[0]);
+
+  while (v_s[0]) {
+    // The step either stays in the current slice, or reaches the end of a slice:
+    // several slices are merged if the step starts at the beginning of the current one
+    v_last = v_s;
+    double dt = fabs(t_end(v_s[0]) - t);
+    bool sub_step = dt > 1.5 * h;
+    if (sub_step)
+      dt = h;
+    else if (t == t_begin(v_s[0])) {
+      while (next(v_last[0]) && fabs(t_end(next(v_last[0])) - t) <= 1.5 * h)
+        for (int j = 0; j < dim; ++j)
+          v_last[j] = next(v_last[j]);
+      dt = fabs(t_end(v_last[0]) - t);
+    }
+
+    // The step is reduced if no global enclosure is found, or if the remainder is too wide
+    LohnerAlgorithm lo_step(lo);
+    try {
+      lo_step.integrate(1, dt);
+    } catch (const GlobalEnclosureError &) {
+      if (dt <= h_min)
+        throw;
+      h = 0.5 * dt;
+      continue;
+    }
+
+    double err = lo_step.getRemainder().max_diam() / dt;
+    if (err > m_step_tol && dt > h_min) {
+      h = 0.5 * dt;
+      continue;
+    }
+
+    lo = lo_step;
+    if (err < m_step_tol / std::pow(2., m_order - 1)) // the error is about proportional to dt^(order-1)
+      h = std::max(h, 2. * dt);
+
+    hull |= lo.getGlobalEnclosure();
+    if (sub_step) {
+      t += forward ? dt : -dt;
+      continue;
+    }
+
+    // Writing results in the covered slices
+    for (bool last = false; !last; ) {
+      last = v_s[0] == v_last[0];
+      for (int j = 0; j < dim; ++j) {
+        v_s[j]->set_envelope(v_s[j]->codomain() & hull[j]);
+        output_gate[j] = forward ? v_s[j]->output_gate() : v_s[j]->input_gate();
+        v_s[j] = next(v_s[j]);
+      }
+    }
+
+    lo.contractStep(output_gate);
+    hull.set_empty();
+    t = v_s[0] ? t_begin(v_s[0]) : t;
+  }
+
+  tube.set(output_gate & lo.getLocalEnclosure(), forward ? tube.tdomain().ub() : tube.tdomain().lb());
+}
+
+const codac::TubeVector CtcLohner::propagate(const codac::TubeVector &x, const vector<IntervalVector> &v_x0,
+                                             vector<codac::TubeVector> &v_x, TimePropag t_propa, int nb_threads) const {
+  assert((!x.is_empty()) && (x.size() == dim));
+  ThreadPool pool(nb_threads);
+
+  // One contractor per thread, with its own functions (reused for all its tubes)
+  vector<unique_ptr<CtcLohner> > v_ctc;
+  for (int i = 0; i < pool.nb_threads(); ++i) {
+    v_ctc.push_back(unique_ptr<CtcLohner>(new CtcLohner(m_f, contractions, eps)));
+    v_ctc.back()->set_order(m_order);
+    v_ctc.back()->set_adaptive_step(m_adaptive_step, m_step_tol);
+  }
+
+  return contract_initial_conditions(x, v_x0, t_propa, v_x, pool,
+                                     [&](codac::TubeVector &xi, int thread_id) { v_ctc[thread_id]->contract(xi, t_propa); });
+}
+
 void CtcLohner::contract(codac::Tube &tube, TimePropag t_propa) {
   assert(!tube.is_empty());
   codac::TubeVector tubeVector(1, tube);
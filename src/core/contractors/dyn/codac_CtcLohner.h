@@ -12,6 +12,7 @@
 #ifndef __CODAC_CTCLOHNER_H__
 #define __CODAC_CTCLOHNER_H__
 
+#include <memory>
 #include "codac_DynCtc.h"
 #include "codac_TFnc.h"
 #include "codac_Slice.h"
@@ -37,6 +38,35 @@ public:
    */
   explicit CtcLohner(const Function &f, int contractions = 5, double eps = 0.1);
 
+  /**
+   * \brief Sets the order of the Taylor expansions of the integration method
+   *
+   * Higher orders allow larger integration steps (wider slices) for smooth systems.
+   * Taylor coefficients are obtained by symbolic differentiation of f.
+   *
+   * \param order order \f$p\geq 2\f$ of the method (2 by default)
+   */
+  void set_order(int order);
+
+  /**
+   * \brief Returns the order of the Taylor expansions of the integration method
+   *
+   * \return the order \f$p\f$
+   */
+  int order() const;
+
+  /**
+   * \brief Enables an integration step independent of the slicing of the tubes
+   *
+   * Each slice is then integrated with several steps, or several slices are integrated
+   * within one step, depending on the width of the Taylor-Lagrange remainder and on the
+   * existence of a global enclosure over the step. Results are written in the slices of the tube.
+   *
+   * \param adaptive true to enable the adaptive step (disabled by default)
+   * \param tol maximal width of the remainder per time unit of the steps
+   */
+  void set_adaptive_step(bool adaptive = true, double tol = 1e-3);
+
   /**
    * \brief Contracts the tube with respect to the specified differential constraint, either forward, backward (or both) in time
    *
@@ -62,11 +92,41 @@ public:
    */
   void contract(std::vector<codac::Domain *> &v_domains) override;
 
+  /**
+   * \brief Contracts copies of a tube, one per initial condition, in parallel
+   *
+   * For instance, initial conditions may be the boxes of a bisected initial set.
+   * Each thread works with its own copy of this contractor.
+   *
+   * @param x tube providing the tdomain, the slicing and the prior values of the copies
+   * @param v_x0 initial conditions, set at the beginning of the tdomain (at its end for a backward propagation)
+   * @param v_x resulting tubes, one per initial condition
+   * @param t_propa direction of contraction
+   * @param nb_threads number of threads (if 0, the number of hardware threads is used)
+   * @return the union hull of the resulting tubes
+   */
+  const codac::TubeVector propagate(const codac::TubeVector &x, const std::vector<IntervalVector> &v_x0,
+                                    std::vector<codac::TubeVector> &v_x, TimePropag t_propa = TimePropag::FORWARD,
+                                    int nb_threads = 0) const;
+
 protected:
+  /**
+   * \brief Contracts the tube in one direction with an adaptive integration step
+   *
+   * @param tube tube to contract
+   * @param forward true for a forward integration
+   */
+  void contract_adaptive(codac::TubeVector &tube, bool forward);
+
   Function m_f; //!< forward function
   int contractions; //!< number of contractions of the global enclosure by the estimated local enclosure
   int dim; //!< dimension of the state vector
   double eps; //!< inflation parameter for the global enclosure
+  int m_order = 2; //!< order of the Taylor expansions
+  bool m_adaptive_step = false; //!< integration step independent of the slicing
+  double m_step_tol = 1e-3; //!< maximal width of the remainder per time unit, in adaptive mode
+  std::vector<std::shared_ptr<Function> > m_taylor_coefs; //!< Taylor coefficients from order 2, if m_order > 2
+  std::vector<std::shared_ptr<Function> > m_taylor_applied; //!< functions applied in the expressions of the coefficients
 
   static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
   static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
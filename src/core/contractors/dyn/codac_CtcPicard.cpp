@@ -8,7 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <memory>
 #include "codac_CtcPicard.h"
+#include "codac_TFunction.h"
+#include "codac_ThreadPool.h"
 #include "codac_DomainsTypeException.h"
 
 using namespace std;
@@ -94,6 +97,9 @@ namespace codac
       contract(x, TimePropag::BACKWARD);
     }
 
+    else if(m_preserve_slicing && !m_f.is_intertemporal())
+      contract_preserving_slicing(x, t_propa);
+
     else
     {
       TubeVector *first_slicing = nullptr;
@@ -163,6 +169,142 @@ namespace codac
     return m_picard_iterations;
   }
 
+  void CtcPicard::contract_preserving_slicing(TubeVector& x, TimePropag t_propa)
+  {
+    assert(!((t_propa & TimePropag::FORWARD) && (t_propa & TimePropag::BACKWARD)));
+
+    // Slices are walked with pointers, and refined in a local layer if needed
+    double dt_min = x.tdomain().diam() / 500.;
+    IntervalVector input_gate(x.size()), envelope(x.size()), output_gate(x.size());
+    vector<Slice*> v_s(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+      v_s[i] = (t_propa & TimePropag::FORWARD) ? x[i].first_slice() : x[i].last_slice();
+
+    while(v_s[0])
+    {
+      for(int i = 0 ; i < x.size() ; i++)
+        envelope[i] = v_s[i]->codomain();
+
+      if(is_unbounded(envelope))
+      {
+        for(int i = 0 ; i < x.size() ; i++)
+        {
+          input_gate[i] = v_s[i]->input_gate();
+          output_gate[i] = v_s[i]->output_gate();
+        }
+
+        contract_step(v_s[0]->tdomain(), input_gate, envelope, output_gate, t_propa, dt_min);
+
+        for(int i = 0 ; i < x.size() ; i++)
+        {
+          v_s[i]->set_envelope(envelope[i]);
+          v_s[i]->set_input_gate(input_gate[i]);
+          v_s[i]->set_output_gate(output_gate[i]);
+        }
+      }
+
+      for(int i = 0 ; i < x.size() ; i++)
+        v_s[i] = (t_propa & TimePropag::FORWARD) ? v_s[i]->next_slice() : v_s[i]->prev_slice();
+    }
+  }
+
+  void CtcPicard::contract_step(const Interval& t, IntervalVector& input_gate, IntervalVector& envelope,
+    IntervalVector& output_gate, TimePropag t_propa, double dt_min)
+  {
+    assert(!m_f.is_intertemporal());
+    bool fwd = t_propa & TimePropag::FORWARD;
+    IntervalVector& x0 = fwd ? input_gate : output_gate;
+    IntervalVector& xf = fwd ? output_gate : input_gate;
+
+    guess_envelope(t, x0, envelope, t_propa);
+    input_gate &= envelope;
+    output_gate &= envelope;
+
+    IntervalVector input_box(envelope.size() + 1);
+    input_box[0] = t;
+    input_box.put(1, envelope);
+    IntervalVector f_eval = m_f.eval_vector(input_box);
+    xf &= fwd ? x0 + t.diam() * f_eval : x0 - t.diam() * f_eval;
+
+    // If the envelope stays unbounded, the step is split in two sub-steps,
+    // the values of which are projected back (the tube is not sampled)
+    if(is_unbounded(envelope) && t.diam() > dt_min)
+    {
+      Interval t1(t.lb(), t.mid()), t2(t.mid(), t.ub());
+      IntervalVector gate_mid = envelope, envelope1 = envelope, envelope2 = envelope;
+
+      if(fwd)
+      {
+        contract_step(t1, input_gate, envelope1, gate_mid, t_propa, dt_min);
+        contract_step(t2, gate_mid, envelope2, output_gate, t_propa, dt_min);
+      }
+
+      else
+      {
+        contract_step(t2, gate_mid, envelope2, output_gate, t_propa, dt_min);
+        contract_step(t1, input_gate, envelope1, gate_mid, t_propa, dt_min);
+      }
+
+      envelope = envelope1 | envelope2;
+    }
+  }
+
+  bool CtcPicard::guess_envelope(const Interval& t, const IntervalVector& x0, IntervalVector& envelope, TimePropag t_propa)
+  {
+    assert(!m_f.is_intertemporal());
+
+    float delta = m_delta;
+    Interval h = (t_propa & TimePropag::FORWARD) ? Interval(0., t.diam()) : Interval(-t.diam(), 0.);
+    IntervalVector x_guess(x0.size()), x_enclosure = x0;
+    IntervalVector input_box(x0.size() + 1);
+    input_box[0] = t;
+    m_picard_iterations = 0;
+
+    do
+    {
+      m_picard_iterations++;
+      x_guess = x_enclosure;
+
+      for(int i = 0 ; i < x_guess.size() ; i++)
+        x_guess[i] = x_guess[i].mid()
+                   + delta * (x_guess[i] - x_guess[i].mid())
+                   + Interval(-EPSILON,EPSILON); // in case of a degenerate box
+
+      input_box.put(1, x_guess & envelope);
+      x_enclosure = x0 + h * m_f.eval_vector(input_box);
+
+      if(is_unbounded(x_enclosure) || x_enclosure.is_empty() || x_guess.is_empty())
+        return false;
+
+    } while(!x_enclosure.is_interior_subset(x_guess));
+
+    envelope &= x_enclosure;
+    return true;
+  }
+
+  const TubeVector CtcPicard::propagate(const TubeVector& x, const vector<IntervalVector>& v_x0,
+    vector<TubeVector>& v_x, TimePropag t_propa, int nb_threads) const
+  {
+    assert(m_f.nb_var() == x.size());
+
+    // IBEX functions are not thread-safe: each thread needs its own copy
+    const TFunction *f = dynamic_cast<const TFunction*>(&m_f);
+    ThreadPool pool(f ? nb_threads : 1);
+
+    vector<unique_ptr<TFunction> > v_f;
+    vector<unique_ptr<CtcPicard> > v_ctc; // one contractor per thread, reused for all its tubes
+    for(int i = 0 ; i < pool.nb_threads() ; i++)
+    {
+      if(f)
+        v_f.push_back(unique_ptr<TFunction>(new TFunction(*f)));
+      v_ctc.push_back(unique_ptr<CtcPicard>(new CtcPicard(f ? (const TFnc&)*v_f.back() : m_f, m_delta)));
+      v_ctc.back()->preserve_slicing(m_preserve_slicing);
+    }
+
+    return contract_initial_conditions(x, v_x0, t_propa, v_x, pool,
+      [&](TubeVector& xi, int thread_id) { v_ctc[thread_id]->contract(xi, t_propa); });
+  }
+
   void CtcPicard::contract_kth_slices(TubeVector& x, int k, TimePropag t_propa)
   {
     assert(m_f.nb_var() == x.size());
@@ -219,6 +361,15 @@ namespace codac
       h = Interval(-t.diam(), 0.);
     }
 
+    if(!m_f.is_intertemporal()) // faster evaluation without tube update
+    {
+      IntervalVector envelope = initial_x;
+      if(guess_envelope(t, x0, envelope, t_propa))
+        for(int i = 0 ; i < x.size() ; i++)
+          x[i].slice(k)->set_envelope(envelope[i]);
+      return;
+    }
+
     IntervalVector x_guess(x.size()), x_enclosure = x0;
     m_picard_iterations = 0;
 
@@ -232,28 +383,16 @@ namespace codac
                    + delta * (x_guess[i] - x_guess[i].mid())
                    + Interval(-EPSILON,EPSILON); // in case of a degenerate box
 
-      if(m_f.is_intertemporal())
-      {
-        // Update needed for further computations
-        // that may be related to this slice k
-        for(int i = 0 ; i < x.size() ; i++)
-          x[i].slice(k)->set_envelope(x_guess[i] & initial_x[i]);
-        x_enclosure = x0 + h * m_f.eval_vector(k, x);
-      }
-
-      else // faster evaluation without tube update
-      {
-        IntervalVector input_box(x.size() + 1);
-        input_box[0] = t;
-        input_box.put(1, x_guess & initial_x); // todo: perform the intersection before?
-        x_enclosure = x0 + h * m_f.eval_vector(input_box);
-      }
+      // Update needed for further computations
+      // that may be related to this slice k
+      for(int i = 0 ; i < x.size() ; i++)
+        x[i].slice(k)->set_envelope(x_guess[i] & initial_x[i]);
+      x_enclosure = x0 + h * m_f.eval_vector(k, x);
 
       if(is_unbounded(x_enclosure) || x_enclosure.is_empty() || x_guess.is_empty())
       {
-        if(m_f.is_intertemporal())
-          for(int i = 0 ; i < x.size() ; i++)
-            x[i].slice(k)->set_envelope(initial_x[i]); // coming back to the initial state
+        for(int i = 0 ; i < x.size() ; i++)
+          x[i].slice(k)->set_envelope(initial_x[i]); // coming back to the initial state
         break;
       }
     } while(!x_enclosure.is_interior_subset(x_guess));
@@ -263,16 +402,13 @@ namespace codac
       for(int i = 0 ; i < x.size() ; i++)
         x[i].slice(k)->set_envelope(initial_x[i] & x_enclosure[i]);
 
-    if(m_f.is_intertemporal())
+    // Restoring ending gate, contracted by setting the envelope
+    for(int i = 0 ; i < x.size() ; i++)
     {
-      // Restoring ending gate, contracted by setting the envelope
-      for(int i = 0 ; i < x.size() ; i++)
-      {
-        Slice *s = x[i].slice(k);
-        if(t_propa & TimePropag::FORWARD)  s->set_output_gate(xf[i]);
-        if(t_propa & TimePropag::BACKWARD) s->set_input_gate(xf[i]);
-        // todo: ^ check this ^
-      }
+      Slice *s = x[i].slice(k);
+      if(t_propa & TimePropag::FORWARD)  s->set_output_gate(xf[i]);
+      if(t_propa & TimePropag::BACKWARD) s->set_input_gate(xf[i]);
+      // todo: ^ check this ^
     }
   }
 }
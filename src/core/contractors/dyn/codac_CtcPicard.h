@@ -36,11 +36,60 @@ namespace codac
 
       int picard_iterations() const;
 
+      /**
+       * \brief Contracts copies of a tube, one per initial condition, in parallel
+       *
+       * \note Threads evaluate their own copies of f when it is a TFunction,
+       *       the computations are sequential otherwise.
+       *
+       * \param x tube providing the tdomain, the slicing and the prior values of the copies
+       * \param v_x0 initial conditions, set at the beginning of the tdomain (at its end for a backward propagation)
+       * \param v_x resulting tubes, one per initial condition
+       * \param t_propa direction of contraction
+       * \param nb_threads number of threads (if 0, the number of hardware threads is used)
+       * \return the union hull of the resulting tubes
+       */
+      const TubeVector propagate(const TubeVector& x, const std::vector<IntervalVector>& v_x0,
+                                 std::vector<TubeVector>& v_x, TimePropag t_propa = TimePropag::FORWARD,
+                                 int nb_threads = 0) const;
+
     protected:
 
       void contract_kth_slices(TubeVector& x, int k, TimePropag t_propa);
       void guess_kth_slices_envelope(TubeVector& x, int k, TimePropag t_propa);
 
+      /**
+       * \brief Contracts a tube without modifying its slicing, for a function that is not inter-temporal
+       *
+       * \param x the tube to be contracted
+       * \param t_propa direction of contraction (forward or backward)
+       */
+      void contract_preserving_slicing(TubeVector& x, TimePropag t_propa);
+
+      /**
+       * \brief Contracts the values of a tube over a time step, refined by sub-steps if needed
+       *
+       * \param t the time step
+       * \param input_gate the values at \f$t^-\f$
+       * \param envelope the values over \f$[t]\f$
+       * \param output_gate the values at \f$t^+\f$
+       * \param t_propa direction of contraction (forward or backward)
+       * \param dt_min minimal width of the sub-steps
+       */
+      void contract_step(const Interval& t, IntervalVector& input_gate, IntervalVector& envelope,
+                         IntervalVector& output_gate, TimePropag t_propa, double dt_min);
+
+      /**
+       * \brief Contracts an envelope by Picard iterations, for a function that is not inter-temporal
+       *
+       * \param t the time step
+       * \param x0 the initial values of the step, in the direction of contraction
+       * \param envelope the values over \f$[t]\f$
+       * \param t_propa direction of contraction (forward or backward)
+       * \return false if no enclosure has been found (the envelope is then not contracted)
+       */
+      bool guess_envelope(const Interval& t, const IntervalVector& x0, IntervalVector& envelope, TimePropag t_propa);
+
       const TFunction* m_f_ptr = nullptr;
       const TFnc& m_f;
       const float m_delta;
@@ -8,7 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
+#include "ibex_CtcFwdBwd.h"
 #include "codac_CtcStatic.h"
+#include "codac_Exception.h"
 #include "codac_DomainsTypeException.h"
 
 using namespace std;
@@ -19,7 +22,69 @@ namespace codac
   CtcStatic::CtcStatic(Ctc& static_ctc, bool temporal_ctc)
     : DynCtc(temporal_ctc), m_static_ctc(static_ctc), m_temporal_ctc(temporal_ctc ? 1 : 0)
   {
+    m_thread_ctc.push_back(&m_static_ctc);
+  }
+
+  CtcStatic::~CtcStatic()
+  {
+    reset_threads();
+  }
+
+  void CtcStatic::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+
+    if(nb_threads == 0)
+      nb_threads = ThreadPool::hardware_concurrency();
+
+    CtcFwdBwd *fwdbwd = dynamic_cast<CtcFwdBwd*>(&m_static_ctc);
+    if(nb_threads > 1 && !fwdbwd)
+      throw Exception(__func__, "unable to copy the static contractor, use set_thread_contractors() instead");
+
+    reset_threads();
+
+    if(nb_threads == 1)
+      return;
+
+    for(int i = 1 ; i < nb_threads ; i++)
+    {
+      // Functions are copied too, as their evaluation is not thread-safe
+      m_fnc_copies.push_back(unique_ptr<Function>(new Function(fwdbwd->f)));
+      m_ctc_copies.push_back(unique_ptr<Ctc>(new CtcFwdBwd(*m_fnc_copies.back(), fwdbwd->d)));
+      m_thread_ctc.push_back(m_ctc_copies.back().get());
+    }
+
+    m_thread_pool = unique_ptr<ThreadPool>(new ThreadPool(nb_threads));
+  }
+
+  void CtcStatic::set_thread_contractors(const vector<Ctc*>& v_ctc)
+  {
+    reset_threads();
+
+    if(v_ctc.empty())
+      return;
+
+    for(const auto& ctc : v_ctc)
+    {
+      assert(ctc && ctc != &m_static_ctc);
+      assert(ctc->nb_var == m_static_ctc.nb_var);
+      m_thread_ctc.push_back(ctc);
+    }
+
+    m_thread_pool = unique_ptr<ThreadPool>(new ThreadPool(v_ctc.size()+1));
+  }
+
+  int CtcStatic::nb_threads() const
+  {
+    return m_thread_ctc.size();
+  }
 
+  void CtcStatic::reset_threads()
+  {
+    m_thread_pool.reset(); // waiting for the end of the workers
+    m_thread_ctc.resize(1);
+    m_ctc_copies.clear();
+    m_fnc_copies.clear();
   }
 
   // Static members for contractor signature (mainly used for CN Exceptions)
@@ -146,6 +211,12 @@ namespace codac
 
   void CtcStatic::contract(Slice **v_x_slices, int n)
   {
+    if(m_thread_pool)
+    {
+      contract_parallel(v_x_slices, n);
+      return;
+    }
+
     IntervalVector envelope(n + m_temporal_ctc);
     IntervalVector ingate(n + m_temporal_ctc);
 
@@ -208,4 +279,131 @@ namespace codac
           v_x_slices[i] = v_x_slices[i]->next_slice();
     }
   }
+
+  void CtcStatic::contract_parallel(Slice **v_x_slices, int n)
+  {
+    const int m = n + m_temporal_ctc;
+    const int max_block_size = ThreadPool::SLICES_PER_TASK * ThreadPool::TASKS_PER_THREAD * m_thread_pool->nb_threads();
+
+    vector<Slice*> v_block; // slices of the block, v_block[k*n+i] being the k-th slice of the i-th component
+    vector<IntervalVector> v_envelope(max_block_size, IntervalVector(m));
+    vector<IntervalVector> v_ingate(max_block_size, IntervalVector(m));
+    vector<char> v_contracted(max_block_size); // slices that are impacted by the contractor
+    v_block.reserve(max_block_size*n);
+
+    vector<Slice*> v_last_slices; // last slices of the tube, if they are impacted by the contractor
+
+    while(v_x_slices[0])
+    {
+      // Gathering the slices of the block
+
+      v_block.clear();
+      for(int k = 0 ; k < max_block_size && v_x_slices[0] ; k++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_block.push_back(v_x_slices[i]);
+          v_x_slices[i] = v_x_slices[i]->next_slice();
+        }
+
+      const int block_size = v_block.size() / n;
+      const int nb_tasks = (block_size + ThreadPool::SLICES_PER_TASK - 1) / ThreadPool::SLICES_PER_TASK;
+
+      // Contracting the envelopes (the tube is not modified by the threads)
+
+      m_thread_pool->run(nb_tasks, [&](int task_id, int thread_id)
+      {
+        Ctc& ctc = *m_thread_ctc[thread_id];
+        int k_end = std::min(block_size, (task_id+1) * ThreadPool::SLICES_PER_TASK);
+
+        for(int k = task_id * ThreadPool::SLICES_PER_TASK ; k < k_end ; k++)
+        {
+          Slice **s = &v_block[k*n];
+          v_contracted[k] = s[0]->tdomain().intersects(m_restricted_tdomain);
+          
+          // todo: Thin contraction with respect to tube's slicing:
+          // the contraction should not be optimal on purpose if the
+          // restricted tdomain does not cover the slice's tdomain
+
+          if(!v_contracted[k])
+            continue;
+
+          IntervalVector& envelope = v_envelope[k];
+
+          if(m_temporal_ctc)
+            envelope[0] = s[0]->tdomain();
+
+          for(int i = 0 ; i < n ; i++)
+            envelope[i+m_temporal_ctc] = s[i]->codomain();
+
+          ctc.contract(envelope);
+        }
+      });
+
+      // Contracting the input gates, as they would be after setting the previous envelope
+
+      m_thread_pool->run(nb_tasks, [&](int task_id, int thread_id)
+      {
+        Ctc& ctc = *m_thread_ctc[thread_id];
+        int k_end = std::min(block_size, (task_id+1) * ThreadPool::SLICES_PER_TASK);
+
+        for(int k = task_id * ThreadPool::SLICES_PER_TASK ; k < k_end ; k++)
+        {
+          if(!v_contracted[k])
+            continue;
+
+          Slice **s = &v_block[k*n];
+          IntervalVector& ingate = v_ingate[k];
+
+          if(m_temporal_ctc)
+            ingate[0] = s[0]->tdomain().lb();
+
+          for(int i = 0 ; i < n ; i++)
+          {
+            ingate[i+m_temporal_ctc] = s[i]->input_gate();
+
+            // At the beginning of a block, the previous envelope has already been set
+            if(k > 0 && v_contracted[k-1])
+              ingate[i+m_temporal_ctc] &= v_envelope[k-1][i+m_temporal_ctc];
+          }
+
+          ctc.contract(ingate);
+        }
+      });
+
+      // Setting the contracted values in the order of the sequential mode
+
+      for(int k = 0 ; k < block_size ; k++)
+      {
+        if(!v_contracted[k])
+          continue;
+
+        Slice **s = &v_block[k*n];
+
+        for(int i = 0 ; i < n ; i++)
+        {
+          s[i]->set_envelope(v_envelope[k][i+m_temporal_ctc]);
+          s[i]->set_input_gate(v_ingate[k][i+m_temporal_ctc]);
+        }
+      }
+
+      if(!v_x_slices[0] && v_contracted[block_size-1]) // keeping the last slices for the output gate
+        v_last_slices.assign(v_block.end()-n, v_block.end());
+    }
+
+    if(!v_last_slices.empty()) // output gate
+    {
+      IntervalVector outgate(m);
+
+      if(m_temporal_ctc)
+        outgate[0] = v_last_slices[0]->tdomain().ub();
+
+      for(int i = 0 ; i < n ; i++)
+        outgate[i+m_temporal_ctc] = v_last_slices[i]->output_gate();
+
+      m_static_ctc.contract(outgate);
+
+      for(int i = 0 ; i < n ; i++)
+        v_last_slices[i]->set_output_gate(outgate[i+m_temporal_ctc]);
+    }
+  }
 }
\ No newline at end of file
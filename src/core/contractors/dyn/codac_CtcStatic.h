@@ -12,9 +12,13 @@
 #ifndef __CODAC_CTCSTATIC_H__
 #define __CODAC_CTCSTATIC_H__
 
+#include <vector>
+#include <memory>
 #include "codac_Ctc.h"
+#include "codac_Function.h"
 #include "codac_DynCtc.h"
 #include "codac_Domain.h"
+#include "codac_ThreadPool.h"
 
 namespace codac
 {
@@ -23,6 +27,9 @@ namespace codac
    * \brief Generic static \f$\mathcal{C}\f$ that contracts a tube \f$[\mathbf{x}](\cdot)\f$ 
    *        with some IBEX contractor (for boxes, possibly including time).
    *        The contractor will be applied on each slice and gate.
+   *
+   * \note As the constraint is not inter-temporal, slices can be contracted in parallel
+   *       (see set_nb_threads()). Results do not depend on the number of threads.
    */
   class CtcStatic : public DynCtc
   {
@@ -37,6 +44,40 @@ namespace codac
        */
       CtcStatic(Ctc& ibex_ctc, bool temporal_ctc = false);
 
+      /**
+       * \brief CtcStatic destructor
+       */
+      ~CtcStatic();
+
+      /**
+       * \brief Enables the parallel contraction of the slices
+       *
+       * Each thread is given its own copy of the static contractor,
+       * which has to be a ibex::CtcFwdBwd object (such as a CtcFunction).
+       * Other contractors can be provided with set_thread_contractors().
+       *
+       * \param nb_threads number of threads (if 0, the number of hardware
+       *        threads is used; 1 disables the parallel mode)
+       */
+      void set_nb_threads(int nb_threads = 0);
+
+      /**
+       * \brief Enables the parallel contraction of the slices with custom contractors
+       *
+       * \note The contractors are not deleted by this object.
+       *
+       * \param v_ctc independent copies of the static contractor, one for each
+       *        additional thread (the number of threads is `v_ctc.size()+1`)
+       */
+      void set_thread_contractors(const std::vector<Ctc*>& v_ctc);
+
+      /**
+       * \brief Returns the number of threads used for the contractions
+       *
+       * \return the number of threads, 1 if the parallel mode is disabled
+       */
+      int nb_threads() const;
+
       /*
        * \brief Contracts a set of abstract domains
        *
@@ -122,9 +163,32 @@ namespace codac
 
     protected:
 
+      /**
+       * \brief Contracts an array of slices with the threads of the pool
+       *
+       * Slices are processed by blocks. In each block, the envelopes and then the
+       * input gates are contracted in parallel on chunks of consecutive slices, without
+       * modifying the tube. The results are then set sequentially, which leads to
+       * the same contractions (and the same synthesis updates) as the sequential mode.
+       *
+       * \param v_x_slices the slices to be contracted
+       * \param n the dimension of the array
+       */
+      void contract_parallel(Slice **v_x_slices, int n);
+
+      /**
+       * \brief Disables the parallel mode and releases the copies of the contractor
+       */
+      void reset_threads();
+
       Ctc& m_static_ctc; //!< related static contractor
       int m_temporal_ctc; //!< specifies either the temporal tdomain is part of the constraint or not
 
+      std::unique_ptr<ThreadPool> m_thread_pool; //!< threads used for parallel contractions (nullptr in sequential mode)
+      std::vector<Ctc*> m_thread_ctc; //!< contractor used by each thread (the first one is m_static_ctc)
+      std::vector<std::unique_ptr<Function> > m_fnc_copies; //!< functions of the contractor copies owned by this object
+      std::vector<std::unique_ptr<Ctc> > m_ctc_copies; //!< contractor copies owned by this object
+
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
       friend class ContractorNetwork;
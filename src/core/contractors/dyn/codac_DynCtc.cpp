@@ -9,6 +9,7 @@
  */
 
 #include "codac_DynCtc.h"
+#include "codac_ThreadPool.h"
 
 using namespace std;
 using namespace ibex;
@@ -45,4 +46,33 @@ namespace codac
   {
     return m_intertemporal;
   }
-}
\ No newline at end of file
+
+  const TubeVector DynCtc::contract_initial_conditions(const TubeVector& x,
+    const vector<IntervalVector>& v_x0, TimePropag t_propa,
+    vector<TubeVector>& v_x, ThreadPool& pool, const function<void(TubeVector&,int)>& ctc_f)
+  {
+    assert(!x.is_empty());
+    assert(!v_x0.empty());
+
+    double t0 = (t_propa & TimePropag::FORWARD) ? x.tdomain().lb() : x.tdomain().ub();
+
+    v_x.clear();
+    v_x.reserve(v_x0.size());
+    for(size_t i = 0 ; i < v_x0.size() ; i++)
+    {
+      assert(v_x0[i].size() == x.size());
+      v_x.push_back(x);
+    }
+
+    pool.run(v_x0.size(), [&](int i, int thread_id)
+    {
+      v_x[i].set(v_x[i](t0) & v_x0[i], t0);
+      ctc_f(v_x[i], thread_id);
+    });
+
+    TubeVector hull(v_x[0]);
+    for(size_t i = 1 ; i < v_x.size() ; i++)
+      hull |= v_x[i];
+    return hull;
+  }
+}
@@ -12,12 +12,15 @@
 #ifndef __CODAC_DYNCTC_H__
 #define __CODAC_DYNCTC_H__
 
+#include <vector>
+#include <functional>
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
 
 namespace codac
 {
   class Domain;
+  class ThreadPool;
   
   /**
    * \enum TimePropag
@@ -115,6 +118,25 @@ namespace codac
 
     protected:
 
+      /**
+       * \brief Contracts copies of a tube, one per initial condition, with several threads
+       *
+       * \param x tube providing the tdomain, the slicing and the prior values of the copies
+       * \param v_x0 initial conditions, set at \f$t_0^-\f$ for a forward propagation,
+       *        at \f$t_0^+\f$ otherwise
+       * \param t_propa direction of contraction
+       * \param v_x resulting tubes, one per initial condition
+       * \param pool threads computing the contractions
+       * \param ctc_f contraction of a tube by a thread, called as `ctc_f(tube, thread_id)`
+       * \return the union hull of the resulting tubes
+       */
+      static const TubeVector contract_initial_conditions(const TubeVector& x,
+                                                          const std::vector<IntervalVector>& v_x0,
+                                                          TimePropag t_propa,
+                                                          std::vector<TubeVector>& v_x,
+                                                          ThreadPool& pool,
+                                                          const std::function<void(TubeVector&,int)>& ctc_f);
+
       bool m_preserve_slicing = true; //!< if `true`, tube's slicing will not be affected by the contractor
       bool m_fast_mode = false; //!< some contractors may propose more pessimistic but faster execution modes
       Interval m_restricted_tdomain; //!< limits the contractions to the specified temporal domain
@@ -9,6 +9,7 @@
  */
 
 #include "codac_CtcFunction.h"
+#include "codac_CtcStatic.h"
 
 using namespace std;
 using namespace ibex;
@@ -39,6 +40,30 @@ namespace codac
     // todo: clean delete
   }
 
+  CtcFunction::CtcFunction(const CtcFunction& ctc)
+    : CtcFwdBwd(ctc)
+  {
+    if(ctc.m_parallel_ctc) // the threads are not shared with the copied object
+      set_nb_threads(ctc.m_parallel_ctc->nb_threads());
+  }
+
+  CtcFunction::~CtcFunction()
+  {
+
+  }
+
+  void CtcFunction::set_nb_threads(int nb_threads)
+  {
+    if(nb_threads == 1)
+      m_parallel_ctc.reset();
+
+    else
+    {
+      m_parallel_ctc = unique_ptr<CtcStatic>(new CtcStatic(*this));
+      m_parallel_ctc->set_nb_threads(nb_threads);
+    }
+  }
+
   void CtcFunction::contract(IntervalVector& x)
   {
     assert(x.size() == nb_var);
@@ -214,6 +239,12 @@ namespace codac
 
   void CtcFunction::contract(Slice **v_x_slices)
   {
+    if(m_parallel_ctc)
+    {
+      m_parallel_ctc->contract(v_x_slices, nb_var);
+      return;
+    }
+
     IntervalVector envelope(nb_var);
     IntervalVector ingate(nb_var);
 
@@ -13,6 +13,7 @@
 #define __CODAC_CTCFUNCTION_H__
 
 #include <string>
+#include <memory>
 #include "codac_Function.h"
 #include "ibex_CtcFwdBwd.h"
 #include "ibex_Domain.h"
@@ -20,6 +21,8 @@
 
 namespace codac
 {
+  class CtcStatic;
+
   /**
    * \class CtcFunction
    * \brief Generic static \f$\mathcal{C}\f$ that contracts a box \f$[\mathbf{x}]\f$ or a tube \f$[\mathbf{x}](\cdot)\f$
@@ -63,6 +66,32 @@ namespace codac
        * \param y the IntervalVector \f$[\mathbf{y}]\f$
        */
       CtcFunction(const Function& f, const IntervalVector& y);
+
+      /**
+       * \brief Creates a copy of a contractor
+       *
+       * \note The parallel mode (see set_nb_threads()) is transmitted to the copy,
+       *       which has its own threads and copies of the contractor.
+       *
+       * \param ctc the CtcFunction to be copied
+       */
+      CtcFunction(const CtcFunction& ctc);
+
+      /**
+       * \brief CtcFunction destructor
+       */
+      ~CtcFunction();
+
+      /**
+       * \brief Enables the parallel contraction of the slices of tubes
+       *
+       * Each thread is given its own copy of the contractor. Results
+       * do not depend on the number of threads.
+       *
+       * \param nb_threads number of threads (if 0, the number of hardware
+       *        threads is used; 1 disables the parallel mode)
+       */
+      void set_nb_threads(int nb_threads = 0);
       
       /**
        * \brief \f$\mathcal{C}\big([\mathbf{x}]\big)\f$
@@ -201,6 +230,10 @@ namespace codac
        * \param v_x_slices the slices to be contracted
        */
       void contract(Slice **v_x_slices);
+
+    protected:
+
+      std::unique_ptr<CtcStatic> m_parallel_ctc; //!< contractor on slices used in parallel mode (nullptr otherwise)
   };
 }
 
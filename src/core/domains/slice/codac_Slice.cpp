@@ -11,12 +11,27 @@
 #include <iomanip>
 #include "codac_Slice.h"
 #include "codac_CtcDeriv.h"
+#include "codac_MemoryPool.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  // Memory pools (never destroyed, as slices may outlive static objects)
+
+  static MemoryPool& slices_pool()
+  {
+    static MemoryPool *pool = new MemoryPool(sizeof(Slice), alignof(Slice));
+    return *pool;
+  }
+
+  static MemoryPool& gates_pool()
+  {
+    static MemoryPool *pool = new MemoryPool(sizeof(Interval), alignof(Interval));
+    return *pool;
+  }
+
   // Public methods
 
     // Definition
@@ -25,8 +40,8 @@ namespace codac
       : m_tdomain(tdomain), m_codomain(codomain)
     {
       assert(valid_tdomain(tdomain));
-      m_input_gate = new Interval(codomain);
-      m_output_gate = new Interval(codomain);
+      m_input_gate = create_gate(codomain);
+      m_output_gate = create_gate(codomain);
     }
 
     Slice::Slice(const Slice& x)
@@ -42,8 +57,8 @@ namespace codac
       if(m_next_slice) m_next_slice->m_prev_slice = nullptr;
 
       // Gates are deleted if not shared with other slices
-      if(m_prev_slice == nullptr) delete m_input_gate;
-      if(m_next_slice == nullptr) delete m_output_gate;
+      if(m_prev_slice == nullptr) delete_gate(m_input_gate);
+      if(m_next_slice == nullptr) delete_gate(m_output_gate);
     }
 
     int Slice::size() const
@@ -60,10 +75,11 @@ namespace codac
       
       if(m_synthesis_reference)
       {
-        m_synthesis_reference->request_values_update();
-        m_synthesis_reference->request_integrals_update();
+        m_synthesis_reference->request_values_update(m_synthesis_id);
+        m_synthesis_reference->request_integrals_update(m_synthesis_id);
       }
-      
+
+      request_volume_update();
       return *this;
     }
     
@@ -72,6 +88,21 @@ namespace codac
       return m_tdomain;
     }
 
+    void* Slice::operator new(size_t size)
+    {
+      if(size != sizeof(Slice)) // derived objects are not handled by the pool
+        return ::operator new(size);
+      return slices_pool().allocate();
+    }
+
+    void Slice::operator delete(void *ptr, size_t size)
+    {
+      if(size != sizeof(Slice))
+        ::operator delete(ptr);
+      else
+        slices_pool().deallocate(ptr);
+    }
+
     // Slices structure
 
     Slice* Slice::prev_slice()
@@ -454,9 +485,11 @@ namespace codac
 
       if(m_synthesis_reference)
       {
-        m_synthesis_reference->request_values_update();
-        m_synthesis_reference->request_integrals_update();
+        m_synthesis_reference->request_values_update(m_synthesis_id);
+        m_synthesis_reference->request_integrals_update(m_synthesis_id);
       }
+
+      request_volume_update();
     }
     
     void Slice::set_empty()
@@ -476,9 +509,11 @@ namespace codac
 
       if(m_synthesis_reference)
       {
-        m_synthesis_reference->request_values_update();
-        m_synthesis_reference->request_integrals_update();
+        m_synthesis_reference->request_values_update(m_synthesis_id);
+        m_synthesis_reference->request_integrals_update(m_synthesis_id);
       }
+
+      request_volume_update();
     }
 
     void Slice::set_input_gate(const Interval& input_gate, bool slice_consistency)
@@ -494,9 +529,11 @@ namespace codac
 
       if(m_synthesis_reference)
       {
-        m_synthesis_reference->request_values_update();
+        m_synthesis_reference->request_values_update(m_synthesis_id);
         // Note: integrals are not impacted by gates
       }
+
+      request_volume_update();
     }
 
     void Slice::set_output_gate(const Interval& output_gate, bool slice_consistency)
@@ -512,9 +549,11 @@ namespace codac
 
       if(m_synthesis_reference)
       {
-        m_synthesis_reference->request_values_update();
+        m_synthesis_reference->request_values_update(m_synthesis_id);
         // Note: integrals are not impacted by gates
       }
+
+      request_volume_update();
     }
     
     const Slice& Slice::inflate(double rad)
@@ -539,11 +578,28 @@ namespace codac
 
 
   // Protected methods
+
+    // Gates allocation
+
+    Interval* Slice::create_gate(const Interval& value)
+    {
+      return new(gates_pool().allocate()) Interval(value);
+    }
+
+    void Slice::delete_gate(Interval *gate)
+    {
+      if(gate)
+      {
+        gate->~Interval();
+        gates_pool().deallocate(gate);
+      }
+    }
     
     void Slice::set_tdomain(const Interval& tdomain)
     {
       assert(valid_tdomain(tdomain));
       m_tdomain = tdomain;
+      request_volume_update();
     }
 
     void Slice::shift_tdomain(double shift_ref)
@@ -590,7 +646,7 @@ namespace codac
       first_slice->set_tdomain(first_slice->tdomain() | second_slice->tdomain());
 
       // Deleting objects after fusion
-      first_slice->m_output_gate = new Interval(second_slice->output_gate());
+      first_slice->m_output_gate = create_gate(second_slice->output_gate());
 
       second_slice->m_prev_slice = nullptr;
       second_slice->m_next_slice = nullptr;
@@ -606,6 +662,16 @@ namespace codac
       }
     }
 
+    void Slice::request_volume_update() const
+    {
+      if(m_volume_tracker)
+      {
+        m_volume_tracker->request_update(this);
+        if(m_prev_slice)
+          m_volume_tracker->request_update(m_prev_slice);
+      }
+    }
+
     // Access values
 
     const IntervalVector Slice::codomain_box() const
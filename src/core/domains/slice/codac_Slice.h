@@ -17,6 +17,7 @@
 #include "codac_DynamicalItem.h"
 #include "codac_ConvexPolygon.h"
 #include "codac_TubeTreeSynthesis.h"
+#include "codac_TubeVolumeTracker.h"
 #include "codac_BoolInterval.h"
 
 namespace codac
@@ -25,6 +26,7 @@ namespace codac
 
   class Tube;
   class Trajectory;
+  class Domain;
 
   /**
    * \class Slice
@@ -81,6 +83,25 @@ namespace codac
        */
       const Interval tdomain() const;
 
+      /**
+       * \brief Allocates the memory of a Slice object
+       *
+       * \note Slices are stored side by side in large memory chunks (see MemoryPool),
+       *       so that iterating over the slices of a tube remains cache friendly.
+       *
+       * \param size the size in bytes of the object
+       * \return the address of the allocated memory
+       */
+      static void* operator new(std::size_t size);
+
+      /**
+       * \brief Releases the memory of a Slice object
+       *
+       * \param ptr the address of the object
+       * \param size the size in bytes of the object
+       */
+      static void operator delete(void *ptr, std::size_t size);
+
       /// @}
       /// \name Slices structure
       /// @{
@@ -655,6 +676,31 @@ namespace codac
        */
       static void merge_slices(Slice *first_slice, Slice *&second_slice);
 
+      /**
+       * \brief Allocates a gate from the pool dedicated to gates
+       *
+       * \note Gates are allocated next to each other, as slices are.
+       *
+       * \param value the initial value of the gate
+       * \return a pointer to the new gate
+       */
+      static Interval* create_gate(const Interval& value);
+
+      /**
+       * \brief Deletes a gate previously obtained from create_gate()
+       *
+       * \param gate a pointer to the gate (nullptr is accepted)
+       */
+      static void delete_gate(Interval *gate);
+
+      /**
+       * \brief Reports a modification of this slice to the volume tracker of its tube, if any
+       *
+       * \note The previous slice is also reported, as it shares its output gate
+       *       with the input gate of this slice.
+       */
+      void request_volume_update() const;
+
       /**
        * \brief Returns the box \f$\llbracket x\rrbracket([t_0,t_f])\f$
        *
@@ -670,12 +716,22 @@ namespace codac
         Interval m_codomain = Interval::ALL_REALS; //!< envelope of the slice
         Interval *m_input_gate = nullptr, *m_output_gate = nullptr; //!< input and output gates
         Slice *m_prev_slice = nullptr, *m_next_slice = nullptr; //!< pointers to previous and next slices of the related tube
-        mutable TubeTreeSynthesis *m_synthesis_reference = nullptr; //!< pointer to a leaf of the optional synthesis tree of the related tube
+        mutable TubeTreeSynthesis *m_synthesis_reference = nullptr; //!< pointer to the optional synthesis tree of the related tube
+        mutable int m_synthesis_id = -1; //!< index of the related leaf in the synthesis tree
+        mutable TubeVolumeTracker *m_volume_tracker = nullptr; //!< pointer to the optional volume tracker of the related tube
+        mutable double m_tracked_volume[2] = {0.,0.}; //!< contributions of the slice last accounted by the volume tracker
+        mutable std::atomic<bool> m_volume_dirty{false}; //!< set when the slice is in the list of dirty slices of the volume tracker
+        mutable unsigned long m_cn_id = 0; //!< id of the last ContractorNetwork in which the slice has been added as a domain
+        mutable Domain *m_cn_domain = nullptr; //!< pointer to the Domain of this slice in that ContractorNetwork
 
       friend class Tube;
       friend class TubeTreeSynthesis;
+      friend class TubeVolumeTracker;
       friend class CtcEval;
+      friend class Domain;
+      friend class ContractorNetwork;
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+      friend void deserialize_Tube(const double *t, const double *codomains, const double *gates, int nb_slices, Tube *&tube);
   };
 }
 
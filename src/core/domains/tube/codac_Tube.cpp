@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "codac_Tube.h"
 #include "codac_Exception.h"
 #include "codac_CtcDeriv.h"
@@ -39,6 +40,7 @@ namespace codac
       
       // Redundant information for fast access
       m_tdomain = tdomain;
+      update_slices_index(tdomain.diam());
     }
     
     Tube::Tube(const Interval& tdomain, double timestep, const Interval& codomain)
@@ -64,7 +66,7 @@ namespace codac
 
         if(prev_slice)
         {
-          delete slice->m_input_gate;
+          Slice::delete_gate(slice->m_input_gate);
           slice->m_input_gate = nullptr;
           Slice::chain_slices(prev_slice, slice);
         }
@@ -75,6 +77,8 @@ namespace codac
 
       } while(ub < tdomain.ub());
 
+      update_slices_index(timestep);
+
       if(codomain != Interval::ALL_REALS)
         set(codomain);
     }
@@ -106,6 +110,7 @@ namespace codac
       }
 
       m_first_slice = new Slice(tube_tdomain, Interval::ALL_REALS);
+      update_slices_index();
       Slice *s = m_first_slice;
 
       for(size_t i = 0 ; i < v_tdomains.size() ; i++)
@@ -170,6 +175,7 @@ namespace codac
     {
       delete_synthesis_tree();
       delete_polynomial_synthesis();
+      delete m_volume_tracker.load();
 
       Slice *slice = first_slice();
       while(slice)
@@ -230,7 +236,7 @@ namespace codac
 
           if(prev_slice)
           {
-            delete slice->m_input_gate;
+            Slice::delete_gate(slice->m_input_gate);
             slice->m_input_gate = nullptr;
             Slice::chain_slices(prev_slice, slice);
           }
@@ -240,6 +246,7 @@ namespace codac
 
         // Redundant information for fast access
         m_tdomain = x.tdomain();
+        update_slices_index(x.m_regular_slicing ? x.m_uniform_timestep : 0.);
 
       return *this;
     }
@@ -318,16 +325,12 @@ namespace codac
 
     int Tube::nb_slices() const
     {
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->nb_slices();
-      
-      else
-      {
-        int size = 0;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-          size ++;
-        return size;
-      }
+      return static_cast<int>(m_v_slices.size());
+    }
+
+    double Tube::uniform_timestep() const
+    {
+      return m_uniform_timestep;
     }
 
     Slice* Tube::slice(int slice_id)
@@ -337,25 +340,10 @@ namespace codac
 
     const Slice* Tube::slice(int slice_id) const
     {
-      if(slice_id < 0 && slice_id >= nb_slices())
+      if(slice_id < 0 || slice_id >= nb_slices())
         return nullptr;
 
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast access
-        return m_synthesis_tree->slice(slice_id);
-      
-      else
-      {
-        int i = 0;
-
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          if(i == slice_id)
-            return s;
-          i++;
-        }
-
-        return nullptr;
-      }
+      return m_v_slices[slice_id];
     }
 
     Slice* Tube::slice(double t)
@@ -368,22 +356,7 @@ namespace codac
       if(!tdomain().contains(t))
         return nullptr;
 
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->slice(t);
-      
-      else
-      {
-        const Slice *last_s = nullptr;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          if(t < s->tdomain().ub())
-            return s;
-          last_s = s;
-        }
-        
-        assert(last_s);
-        return last_s;
-      }
+      return m_v_slices[find_slice_index(t)];
     }
 
     Slice* Tube::first_slice()
@@ -403,16 +376,9 @@ namespace codac
 
     const Slice* Tube::last_slice() const
     {
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->slice(nb_slices() - 1);
-      
-      else
-      {
-        for(const Slice *s = first_slice() ; true ; s = s->next_slice())
-          if(s->next_slice() == nullptr)
-            return s;
+      if(m_v_slices.empty())
         return nullptr;
-      }
+      return m_v_slices.back();
     }
 
     Slice* Tube::wider_slice()
@@ -485,41 +451,22 @@ namespace codac
     const Interval Tube::slice_tdomain(int slice_id) const
     {
       assert(slice_id >= 0 && slice_id < nb_slices());
-      return slice(slice_id)->tdomain();
+      return m_v_slices[slice_id]->tdomain();
     }
 
     int Tube::time_to_index(double t) const
     {
       assert(tdomain().contains(t));
-
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->time_to_index(t);
-      
-      else
-      {
-        int i = -1;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          i++;
-          if(t < s->tdomain().ub())
-            return i;
-        }
-
-        return i;
-      }
+      return find_slice_index(t);
     }
 
     int Tube::index(const Slice* slice) const
     {
-      int i = 0;
-      const Slice *it = first_slice();
-      while(it && it != slice)
-      {
-        it = it->next_slice();
-        if(it == nullptr) return -1;
-        i++;
-      }
-      return i;
+      if(slice == nullptr || !tdomain().contains(slice->tdomain().lb()))
+        return -1;
+
+      int i = find_slice_index(slice->tdomain().lb());
+      return m_v_slices[i] == slice ? i : -1;
     }
 
     void Tube::sample(double t)
@@ -544,7 +491,6 @@ namespace codac
 
       else
       {
-        delete_synthesis_tree(); // todo: update tree if created, instead of delete
         delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
 
         Slice *next_slice = slice_to_be_sampled->next_slice();
@@ -555,11 +501,35 @@ namespace codac
         slice_to_be_sampled->set_tdomain(Interval(slice_to_be_sampled->tdomain().lb(), t));
 
         // Updated slices structure
-        delete new_slice->m_input_gate;
+        Slice::delete_gate(new_slice->m_input_gate);
         new_slice->m_input_gate = nullptr;
         Slice::chain_slices(new_slice, next_slice);
         Slice::chain_slices(slice_to_be_sampled, new_slice);
         new_slice->set_input_gate(new_slice->codomain());
+
+        // Updated slices index
+        int k = find_slice_index(slice_to_be_sampled->tdomain().lb());
+        assert(m_v_slices[k] == slice_to_be_sampled);
+        m_v_slices.insert(m_v_slices.begin() + k + 1, new_slice);
+        if(m_uniform_timestep > 0.)
+          set_nonuniform_index();
+        else
+          m_v_slices_lb.insert(m_v_slices_lb.begin() + k + 1, t);
+
+        // Updated volume tracker
+        if(m_volume_tracker)
+          m_volume_tracker.load()->add_slice(new_slice);
+
+        // Updated synthesis tree: the related leaf is split
+        if(m_synthesis_mode == SynthesisMode::BINARY_TREE)
+        {
+          assert(slice_to_be_sampled->m_synthesis_reference == m_synthesis_tree);
+          m_synthesis_tree->split_leaf(slice_to_be_sampled->m_synthesis_id, new_slice);
+
+          // The tree is rebuilt if local samplings made it too unbalanced
+          if(m_synthesis_tree->depth(new_slice->m_synthesis_id) > 2 * (std::log2(nb_slices()) + 1))
+            create_synthesis_tree();
+        }
       }
     }
 
@@ -567,7 +537,6 @@ namespace codac
     {
       assert(tdomain().contains(t));
 
-      delete_synthesis_tree(); // todo: update tree if created, instead of delete
       delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
 
       sample(t);
@@ -596,15 +565,35 @@ namespace codac
       assert(tdomain().contains(t));
       assert(t != tdomain().lb() && t != tdomain().ub() && "cannot remove initial/final gates");
 
-      Slice *s2 = slice(t);
+      delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
+
+      int k = find_slice_index(t);
+      Slice *s2 = m_v_slices[k];
       assert(s2->tdomain().lb() == t && "the gate must already exist");
       Slice *s1 = s2->prev_slice();
 
+      int leaf1 = s1->m_synthesis_id, leaf2 = s2->m_synthesis_id;
       Slice::merge_slices(s1, s2);
+
+      // Updated synthesis tree: the two leaves are merged
+      if(m_synthesis_mode == SynthesisMode::BINARY_TREE)
+        m_synthesis_tree->merge_leaves(leaf1, leaf2);
+
+      // Updated slices index
+      m_v_slices.erase(m_v_slices.begin() + k);
+      if(m_uniform_timestep > 0.)
+        set_nonuniform_index();
+      else
+        m_v_slices_lb.erase(m_v_slices_lb.begin() + k);
+
+      if(m_volume_tracker)
+        m_volume_tracker.load()->invalidate();
     }
 
     void Tube::merge_similar_slices(double distance_threshold)
     {
+      delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
+
       Slice *s2 = first_slice();
       while(s2)
       {
@@ -612,10 +601,18 @@ namespace codac
         Slice *next_slice = s2->next_slice();
 
         if(s1 && distance(s1->codomain(),s2->codomain()) < distance_threshold)
-            Slice::merge_slices(s1, s2);
+        {
+          int leaf1 = s1->m_synthesis_id, leaf2 = s2->m_synthesis_id;
+          Slice::merge_slices(s1, s2);
+
+          if(m_synthesis_mode == SynthesisMode::BINARY_TREE)
+            m_synthesis_tree->merge_leaves(leaf1, leaf2);
+        }
       
         s2 = next_slice;
       }
+
+      update_slices_index();
     }
 
     // Accessing values
@@ -627,14 +624,12 @@ namespace codac
 
     double Tube::volume() const
     {
-      double volume = 0.;
-      for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-      {
-        if(s->volume() == POS_INFINITY)
-          return POS_INFINITY;
-        volume += s->volume();
-      }
-      return volume;
+      return volume_tracker()->envelopes_volume(m_first_slice);
+    }
+
+    double Tube::gates_volume() const
+    {
+      return volume_tracker()->gates_volume(m_first_slice);
     }
 
     const Interval Tube::operator()(int slice_id) const
@@ -1272,6 +1267,7 @@ namespace codac
       s_last->set_tdomain(t & s_last->tdomain());
 
       m_tdomain = t;
+      update_slices_index();
       delete_synthesis_tree(); // todo: update tree if created, instead of delete
       delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
       return *this;
@@ -1282,6 +1278,7 @@ namespace codac
       for(Slice *s = first_slice() ; s ; s = s->next_slice())
         s->shift_tdomain(shift_ref);
       m_tdomain += shift_ref;
+      update_slices_index();
       delete_synthesis_tree();
       delete_polynomial_synthesis();
     }
@@ -1489,6 +1486,14 @@ namespace codac
     
     bool Tube::same_slicing(const Tube& x1, const Tube& x2)
     {
+      if(&x1 == &x2)
+        return true;
+
+      // Slicings entirely defined by the same timestep and tdomain
+      if(x1.m_regular_slicing && x2.m_regular_slicing
+        && x1.m_uniform_timestep == x2.m_uniform_timestep && x1.tdomain() == x2.tdomain())
+        return true;
+
       if(x1.nb_slices() != x2.nb_slices())
         return false;
 
@@ -1541,6 +1546,126 @@ namespace codac
 
   // Protected methods
 
+    // Slices structure
+
+    void Tube::update_slices_index(double timestep)
+    {
+      m_v_slices.clear();
+      m_v_slices_lb.clear();
+      m_uniform_timestep = 0.;
+      m_regular_slicing = false;
+
+      if(m_volume_tracker)
+        m_volume_tracker.load()->invalidate();
+
+      for(Slice *s = m_first_slice ; s ; s = s->next_slice())
+        m_v_slices.push_back(s);
+
+      if(m_v_slices.empty())
+        return;
+
+      double t0 = m_v_slices[0]->tdomain().lb();
+      double tf = m_v_slices.back()->tdomain().ub();
+
+      // Slicing of Tube(tdomain, timestep), checked exactly
+      if(timestep > 0.)
+      {
+        double lb = t0;
+        m_regular_slicing = true;
+        for(const Slice *s : m_v_slices)
+        {
+          double ub = std::min(lb + timestep, tf);
+          if(s->tdomain().lb() != lb || s->tdomain().ub() != ub)
+          {
+            m_regular_slicing = false;
+            break;
+          }
+          lb = ub;
+        }
+
+        if(m_regular_slicing)
+          m_uniform_timestep = timestep;
+      }
+
+      // Otherwise, uniform sampling: all slices share the same width,
+      // except the last one that may be smaller
+      if(!m_regular_slicing)
+      {
+        double dt = m_v_slices[0]->tdomain().diam();
+        m_uniform_timestep = dt;
+        for(size_t i = 0 ; i < m_v_slices.size() ; i++)
+        {
+          double w = m_v_slices[i]->tdomain().diam();
+          if(fabs(w - dt) > 1e-9 * dt && (i != m_v_slices.size() - 1 || w > dt))
+          {
+            m_uniform_timestep = 0.;
+            break;
+          }
+        }
+      }
+
+      if(m_uniform_timestep > 0.)
+      {
+        // No array of lower bounds: the index is computed from t
+        m_uniform_t0 = t0;
+        m_inv_uniform_timestep = 1. / m_uniform_timestep;
+        m_v_slices_lb.shrink_to_fit();
+      }
+
+      else
+        set_nonuniform_index();
+    }
+
+    void Tube::set_nonuniform_index()
+    {
+      m_v_slices_lb.resize(m_v_slices.size());
+      for(size_t i = 0 ; i < m_v_slices.size() ; i++)
+        m_v_slices_lb[i] = m_v_slices[i]->tdomain().lb();
+
+      m_uniform_timestep = 0.;
+      m_regular_slicing = false;
+    }
+
+    int Tube::find_slice_index(double t) const
+    {
+      assert(!m_v_slices.empty());
+      int n = static_cast<int>(m_v_slices.size());
+      int k;
+
+      if(m_uniform_timestep > 0.) // direct access, corrected for floating-point drifts
+      {
+        double i = (t - m_uniform_t0) * m_inv_uniform_timestep;
+        k = i <= 0. ? 0 : (i >= n - 1 ? n - 1 : static_cast<int>(i));
+        while(k > 0 && t < m_v_slices[k]->tdomain().lb()) k--;
+        while(k < n - 1 && t >= m_v_slices[k + 1]->tdomain().lb()) k++;
+      }
+
+      else // binary search
+      {
+        k = upper_bound(m_v_slices_lb.begin(), m_v_slices_lb.end(), t) - m_v_slices_lb.begin() - 1;
+        k = std::max(0, k);
+      }
+
+      return k;
+    }
+
+    TubeVolumeTracker* Tube::volume_tracker() const
+    {
+      TubeVolumeTracker *tracker = m_volume_tracker;
+
+      if(tracker == nullptr)
+      {
+        // Only one tracker is kept in case of concurrent first calls
+        TubeVolumeTracker *new_tracker = new TubeVolumeTracker();
+        if(m_volume_tracker.compare_exchange_strong(tracker, new_tracker))
+          tracker = new_tracker;
+        else
+          delete new_tracker; // tracker is now the one of the other thread
+      }
+
+      return tracker;
+    }
+
     // Accessing values
 
     const IntervalVector Tube::codomain_box() const
@@ -1601,11 +1726,8 @@ namespace codac
     {
       delete_synthesis_tree();
 
-      vector<const Slice*> v_slices;
-      for(const Slice* s = first_slice() ; s ; s = s->next_slice())
-        v_slices.push_back(s);
-
-      m_synthesis_tree = new TubeTreeSynthesis(this, 0, nb_slices() - 1, v_slices);
+      vector<const Slice*> v_slices(m_v_slices.begin(), m_v_slices.end());
+      m_synthesis_tree = new TubeTreeSynthesis(this, v_slices);
       m_synthesis_mode = SynthesisMode::BINARY_TREE;
     }
     
@@ -15,6 +15,7 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <atomic>
 #include "codac_TFnc.h"
 #include "codac_Slice.h"
 #include "codac_Trajectory.h"
@@ -22,6 +23,7 @@
 #include "codac_tube_arithmetic.h"
 #include "codac_TubeTreeSynthesis.h"
 #include "codac_TubePolynomialSynthesis.h"
+#include "codac_TubeVolumeTracker.h"
 #include "codac_TubeSynthesis.h"
 #include "codac_Polygon.h"
 #include "codac_BoolInterval.h"
@@ -37,6 +39,7 @@ namespace codac
   class Trajectory;
   class TubeTreeSynthesis;
   class TubePolynomialSynthesis;
+  template<typename E> class TubeExpr;
 
   /**
    * \class Tube
@@ -116,6 +119,17 @@ namespace codac
        */
       explicit Tube(const Tube& x, const TFnc& f, int f_image_id = 0);
 
+      /**
+       * \brief Creates a scalar tube from a lazily evaluated expression of tubes,
+       *        with the same time discretization (see codac_tube_expr.h)
+       *
+       * \note The expression is computed in one pass over the slices, without temporary tubes
+       *
+       * \param expr the expression, built from tubes returned by lazy()
+       */
+      template<typename E>
+      Tube(const TubeExpr<E>& expr);
+
       /**
        * \brief Creates a scalar tube \f$[x](\cdot)\f$ enclosing a trajectory \f$x(\cdot)\f$,
        *        possibly with some temporal discretization
@@ -191,6 +205,19 @@ namespace codac
        */
       const Tube& operator=(const Tube& x);
 
+      /**
+       * \brief Evaluates a lazily evaluated expression of tubes into this tube
+       *        (see codac_tube_expr.h)
+       *
+       * \note No allocation is made if the tube has the slicing of the expression,
+       *       which may involve the tube itself
+       *
+       * \param expr the expression, built from tubes returned by lazy()
+       * \return the tube, updated
+       */
+      template<typename E>
+      const Tube& operator=(const TubeExpr<E>& expr);
+
       /**
        * \brief Returns the temporal definition domain of this tube
        *
@@ -236,6 +263,16 @@ namespace codac
        */
       int nb_slices() const;
 
+      /**
+       * \brief Returns the timestep of this tube, in case of a uniform slicing
+       *
+       * \note For uniformly sampled tubes, slices are accessed in constant time
+       *
+       * \return the width of the slices (except the last one that may be smaller),
+       *         0. if the slicing is not uniform
+       */
+      double uniform_timestep() const;
+
       /**
        * \brief Returns a pointer to the ith Slice object of this tube
        *
@@ -464,10 +501,27 @@ namespace codac
        * \note returns POS_INFINITY if the codomain is unbounded
        * \note returns 0 if the tube is flat (and so without wrapping effect)
        *
+       * \note The volume is maintained incrementally: only the slices modified
+       *       since the last call are considered.
+       *
+       * \note Thread-safe with respect to other volume requests on this tube,
+       *       but not with respect to concurrent modifications of its slices.
+       *
        * \return volume defined as \f$w([t_0,t_f])\times w([x]([t_0,t_f]))\f$
        */
       double volume() const;
 
+      /**
+       * \brief Returns the sum of the diameters of the gates of this tube
+       *
+       * \note returns POS_INFINITY if one of the gates is unbounded
+       * \note As for volume(), the sum is maintained incrementally, and
+       *       requests are thread-safe as long as the slices are not modified.
+       *
+       * \return the sum of the diameters of the input gate and of all the output gates
+       */
+      double gates_volume() const;
+
       /**
        * \brief Returns the value of the ith slice
        *
@@ -1111,7 +1165,7 @@ namespace codac
        * \note The values and sampling (slices and gates) are serialized
        *
        * \param binary_file_name name of the output file (default value: "x.tube")
-       * \param version_number serialization version (used for tests purposes, default value: last version)
+       * \param version_number serialization version (default value: SERIALIZATION_VERSION, see serialize_Tube())
        */
       void serialize(const std::string& binary_file_name = "x.tube", int version_number = SERIALIZATION_VERSION) const;
 
@@ -1124,7 +1178,7 @@ namespace codac
        *
        * \param binary_file_name name of the output file (default value: "x.tube")
        * \param traj the Trajectory object to serialize (for instance, actual but unknown values)
-       * \param version_number serialization version (used for tests purposes, default value: last version)
+       * \param version_number serialization version (default value: SERIALIZATION_VERSION, see serialize_Tube())
        */
       void serialize(const std::string& binary_file_name, const Trajectory& traj, int version_number = SERIALIZATION_VERSION) const;
 
@@ -1136,6 +1190,9 @@ namespace codac
        * \note If true, it means the two tubes are defined with the same
        *       amount of slices and identical sampling
        *
+       * \note The test is made in constant time for tubes built with
+       *       the same tdomain and timestep
+       *
        * \param x1 the first Tube
        * \param x2 the second Tube
        * \return true in case of same slicing
@@ -1215,6 +1272,42 @@ namespace codac
        */
       void delete_polynomial_synthesis() const;
 
+      /**
+       * \brief Rebuilds the index of the slices from the list of Slice objects
+       *
+       * \note Must be called after any structural change that is not
+       *       handled incrementally (copy, truncation, deserialization...)
+       *
+       * \param timestep optional timestep from which the slices may have been built,
+       *        as in Tube(tdomain, timestep)
+       */
+      void update_slices_index(double timestep = 0.);
+
+      /**
+       * \brief Indexes the slices by their lower bounds, once the slicing is no more uniform
+       */
+      void set_nonuniform_index();
+
+      /**
+       * \brief Returns the index of the slice defined at \f$t\f$, by using the slices index
+       *
+       * \note For uniformly sampled tubes, the index is directly computed from \f$t\f$.
+       *       Otherwise, a binary search is performed on the lower bounds of the slices.
+       *
+       * \param t the temporal key (double, must belong to the Tube's tdomain)
+       * \return the index of the slice
+       */
+      int find_slice_index(double t) const;
+
+      /**
+       * \brief Returns the volume tracker of this tube, created on the first call
+       *
+       * \note Concurrent first calls create a single tracker
+       *
+       * \return a pointer to the TubeVolumeTracker object
+       */
+      TubeVolumeTracker* volume_tracker() const;
+
       // Class variables:
 
         Slice *m_first_slice = nullptr; //!< pointer to the first Slice object of this tube
@@ -1222,8 +1315,16 @@ namespace codac
         mutable TubePolynomialSynthesis *m_polynomial_synthesis = nullptr; //!< pointer to the optional synthesis tree
         mutable SynthesisMode m_synthesis_mode = SynthesisMode::NONE; //!< enables of the use of a synthesis tree
         Interval m_tdomain; //!< redundant information for fast evaluations
+        std::vector<Slice*> m_v_slices; //!< direct access to the slices, in temporal order
+        std::vector<double> m_v_slices_lb; //!< sorted lower bounds of the slices' tdomains (not used if uniform)
+        double m_uniform_timestep = 0.; //!< timestep of a uniformly sampled tube (0. if not uniform)
+        double m_inv_uniform_timestep = 0.; //!< inverse of the timestep, for computing indexes
+        double m_uniform_t0 = 0.; //!< lower bound of the first slice of a uniformly sampled tube
+        bool m_regular_slicing = false; //!< true if the slices are exactly those of Tube(tdomain, m_uniform_timestep)
+        mutable std::atomic<TubeVolumeTracker*> m_volume_tracker{nullptr}; //!< running volume of the tube, created on demand
 
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+      friend void deserialize_Tube(const double *t, const double *codomains, const double *gates, int nb_slices, Tube *&tube);
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
       friend class TubeVector;
       friend class CtcEval;
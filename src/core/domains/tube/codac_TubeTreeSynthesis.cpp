@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <tuple>
 #include "codac_TubeTreeSynthesis.h"
 
 using namespace std;
@@ -15,206 +16,132 @@ using namespace ibex;
 
 namespace codac
 {
-  TubeTreeSynthesis::TubeTreeSynthesis(const Tube* tube, int k0, int kf, const vector<const Slice*>& v_tube_slices)
-    : m_tube_ref(tube), m_parent(nullptr)
+  TubeTreeSynthesis::TubeTreeSynthesis(const Tube* tube, const vector<const Slice*>& v_tube_slices)
+    : m_tube_ref(tube)
   {
     assert(tube);
-    assert(k0 >= 0 && k0 < (int)v_tube_slices.size()); // todo: use size_t
-    assert(kf >= 0 && kf < (int)v_tube_slices.size()); // todo: use size_t
+    assert(!v_tube_slices.empty());
 
-    if(k0 == kf) // leaf, pointer to a slice
-    {
-      m_first_subtree = nullptr;
-      m_second_subtree = nullptr;
-      m_slice_ref = v_tube_slices[k0];
-      m_slice_ref->m_synthesis_reference = this;
-      m_tdomain = m_slice_ref->tdomain();
-      m_nb_slices = 1;
-    }
+    m_nodes.reserve(2 * v_tube_slices.size() - 1);
+    m_nodes.push_back(Node()); // root
 
-    else
-    {
-      // In the first subtree: [t0,thalf[
-      // In the second subtree: [thalf,tf]
+    // Breadth-first construction: each node is associated
+    // with a range [k0,kf] of slices
 
-      m_nb_slices = kf - k0 + 1;
-      int kmid = k0 + ceil(m_nb_slices / 2.) - 1;
+    vector<tuple<int,int,int> > v_ranges(1, make_tuple(0, 0, (int)v_tube_slices.size() - 1));
+    v_ranges.reserve(m_nodes.capacity());
 
-      m_first_subtree = new TubeTreeSynthesis(tube, k0, kmid, v_tube_slices);
-      m_first_subtree->m_parent = this;
+    for(size_t i = 0 ; i < v_ranges.size() ; i++)
+    {
+      int node_id, k0, kf;
+      tie(node_id, k0, kf) = v_ranges[i];
 
-      if(kmid + 1 <= kf)
-      {
-        m_second_subtree = new TubeTreeSynthesis(tube, kmid + 1, kf, v_tube_slices);
-        m_second_subtree->m_parent = this;
-      }
+      if(k0 == kf) // leaf, pointer to a slice
+        set_leaf(node_id, v_tube_slices[k0]);
 
       else
-        m_second_subtree = nullptr;
+      {
+        // In the first subtree: [t0,thalf[
+        // In the second subtree: [thalf,tf]
+
+        int nb_slices = kf - k0 + 1;
+        int kmid = k0 + ceil(nb_slices / 2.) - 1;
+
+        int first_id = create_node(node_id);
+        int second_id = create_node(node_id);
+
+        Node& node = m_nodes[node_id];
+        node.first_subtree = first_id;
+        node.second_subtree = second_id;
+        node.nb_slices = nb_slices;
+        node.tdomain = Interval(v_tube_slices[k0]->tdomain().lb(), v_tube_slices[kf]->tdomain().ub());
 
-      m_tdomain = m_first_subtree->tdomain() | m_second_subtree->tdomain();
-      m_slice_ref = nullptr;
+        v_ranges.push_back(make_tuple(first_id, k0, kmid));
+        v_ranges.push_back(make_tuple(second_id, kmid + 1, kf));
+      }
     }
   }
 
   TubeTreeSynthesis::~TubeTreeSynthesis()
   {
-    if(m_slice_ref)
-      m_slice_ref->m_synthesis_reference = nullptr; // removing reference from slice's part
-
-    if(m_first_subtree)
-      delete m_first_subtree;
-
-    if(m_second_subtree)
-      delete m_second_subtree;
+    // Removing references from slices' part
+    for(const Node& node : m_nodes)
+      if(node.slice_ref)
+      {
+        node.slice_ref->m_synthesis_reference = nullptr;
+        node.slice_ref->m_synthesis_id = -1;
+      }
   }
 
   const Interval TubeTreeSynthesis::tdomain() const
   {
-    return m_tdomain;
+    return m_nodes[0].tdomain;
   }
 
   int TubeTreeSynthesis::nb_slices() const
   {
-    return m_nb_slices;
+    return m_nodes[0].nb_slices;
   }
 
   const Interval TubeTreeSynthesis::operator()(const Interval& t)
   {
-    if(t.is_empty())
-      return Interval::empty_set();
-
-    else if(t.lb() < tdomain().lb() || t.ub() > tdomain().ub())
-      return Interval::all_reals();
-
-    else if(t.is_degenerated())
-      return m_tube_ref->operator()(t.lb());
-
-    else if(is_leaf() || t == m_tdomain)
-      return codomain();
-
-    else
-    {
-      Interval inter_firstsubtree = m_first_subtree->tdomain() & t;
-      Interval inter_secondsubtree = m_second_subtree->tdomain() & t;
-
-      assert(inter_firstsubtree != inter_secondsubtree); // both degenerated
-
-      if(inter_firstsubtree.is_degenerated() && !inter_secondsubtree.is_degenerated())
-        return (*m_second_subtree)(inter_secondsubtree);
-
-      else if(inter_secondsubtree.is_degenerated() && !inter_firstsubtree.is_degenerated())
-        return (*m_first_subtree)(inter_firstsubtree);
-
-      else
-        return (*m_first_subtree)(inter_firstsubtree) | (*m_second_subtree)(inter_secondsubtree);
-    }
+    if(m_nodes[0].values_update_needed)
+      update_values();
+    return codomain(0, t);
   }
   
   const Interval TubeTreeSynthesis::invert(const Interval& y, const Interval& search_tdomain)
   {
-    if(search_tdomain.is_empty())
-      return Interval::empty_set();
-
-    else if(search_tdomain.lb() < tdomain().lb() || search_tdomain.ub() > tdomain().ub())
-      return Interval::all_reals();
-
-    else if(!codomain().intersects(y))
-      return Interval::empty_set();
-
-    else if(codomain_bounds().first.ub() < y.lb() && codomain_bounds().second.lb() > y.ub())
-      return search_tdomain;
-
-    else
-    {
-      if(is_leaf())
-        return search_tdomain;
-
-      else
-        return m_first_subtree->invert(y, search_tdomain & m_first_subtree->tdomain())
-          | m_second_subtree->invert(y, search_tdomain & m_second_subtree->tdomain());
-    }
+    if(m_nodes[0].values_update_needed)
+      update_values();
+    return invert(0, y, search_tdomain);
   }
   
   const Interval TubeTreeSynthesis::codomain()
   {
-    if(m_values_update_needed)
-      root()->update_values();
-    return m_codomain;
+    if(m_nodes[0].values_update_needed)
+      update_values();
+    return m_nodes[0].codomain;
   }
   
   const pair<Interval,Interval> TubeTreeSynthesis::codomain_bounds()
   {
-    if(m_values_update_needed)
-      root()->update_values();
-    return m_codomain_bounds;
+    if(m_nodes[0].values_update_needed)
+      update_values();
+    return m_nodes[0].codomain_bounds;
   }
 
   const pair<Interval,Interval> TubeTreeSynthesis::eval(const Interval& t)
   {
-    pair<Interval,Interval> p = make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
-
-    if(t.is_degenerated()) // faster to perform the evaluation over the related slice
-      p = slice(time_to_index(t.lb()))->eval(t);
+    if(m_nodes[0].values_update_needed)
+      update_values();
+    return eval(0, t);
+  }
 
-    else if(t.is_empty())
-      p = make_pair(Interval::empty_set(), Interval::empty_set());
+  int TubeTreeSynthesis::time_to_index(double t) const
+  {
+    assert(tdomain().contains(t));
 
-    else if(is_leaf() || t == m_tdomain) // todo: this last condition useful?
-    {
-      if(t == m_tdomain)
-        p = codomain_bounds();
+    if(t == tdomain().ub())
+      return nb_slices() - 1;
 
-      else
-        p = m_slice_ref->eval(t & m_tdomain);
-    }
+    int index = 0, node_id = 0;
 
-    else if(t.intersects(tdomain()))
+    while(!is_leaf(node_id))
     {
-      Interval inter_firstsubtree = m_first_subtree->tdomain() & t;
-      Interval inter_secondsubtree = m_second_subtree->tdomain() & t;
+      const Node& node = m_nodes[node_id];
 
-      assert(inter_firstsubtree != inter_secondsubtree); // both degenerated
-
-      if(inter_firstsubtree.is_degenerated() && !inter_secondsubtree.is_degenerated())
-        p = m_second_subtree->eval(inter_secondsubtree);
-
-      else if(inter_secondsubtree.is_degenerated() && !inter_firstsubtree.is_degenerated())
-        p = m_first_subtree->eval(inter_firstsubtree);
+      if(t < m_nodes[node.first_subtree].tdomain.ub())
+        node_id = node.first_subtree;
 
       else
       {
-        pair<Interval,Interval> p_first = m_first_subtree->eval(inter_firstsubtree);
-        pair<Interval,Interval> p_second = m_second_subtree->eval(inter_secondsubtree);
-        p = make_pair(p_first.first | p_second.first, p_first.second | p_second.second);
+        index += m_nodes[node.first_subtree].nb_slices;
+        node_id = node.second_subtree;
       }
     }
 
-    // Outside tdomain
-    if(t.lb() < tdomain().lb() || t.ub() > tdomain().ub())
-    {
-      p.first |= NEG_INFINITY;
-      p.second |= POS_INFINITY;
-    }
-
-    return p;
-  }
-
-  int TubeTreeSynthesis::time_to_index(double t) const
-  {
-    assert(tdomain().contains(t));
-
-    if(t == m_tdomain.ub())
-      return m_nb_slices - 1;
-
-    if(is_leaf())
-      return 0;
-
-    if(t < m_first_subtree->tdomain().ub())
-      return m_first_subtree->time_to_index(t);
-
-    else
-      return m_second_subtree->time_to_index(t) + m_first_subtree->nb_slices();
+    return index;
   }
 
   Slice* TubeTreeSynthesis::slice(int slice_id)
@@ -227,19 +154,24 @@ namespace codac
   {
     assert(slice_id >= 0 && slice_id < nb_slices());
 
-    if(is_leaf())
-      return m_slice_ref;
+    int node_id = 0;
 
-    else
+    while(!is_leaf(node_id))
     {
-      int mid_id = ceil(nb_slices() / 2.);
+      const Node& node = m_nodes[node_id];
+      int mid_id = m_nodes[node.first_subtree].nb_slices;
 
       if(slice_id < mid_id)
-        return m_first_subtree->slice(slice_id);
+        node_id = node.first_subtree;
 
       else
-        return m_second_subtree->slice(slice_id - mid_id);
+      {
+        slice_id -= mid_id;
+        node_id = node.second_subtree;
+      }
     }
+
+    return m_nodes[node_id].slice_ref;
   }
 
   Slice* TubeTreeSynthesis::slice(double t)
@@ -251,152 +183,43 @@ namespace codac
   const Slice* TubeTreeSynthesis::slice(double t) const
   {
     assert(tdomain().contains(t));
-
-    if(is_leaf())
-      return m_slice_ref;
-
-    else
-    {
-      if(t < m_first_subtree->tdomain().ub())
-        return m_first_subtree->slice(t);
-
-      else
-        return m_second_subtree->slice(t);
-    }
+    return m_nodes[leaf(0, t)].slice_ref;
   }
 
-  void TubeTreeSynthesis::request_values_update()
+  void TubeTreeSynthesis::request_values_update(int node_id)
   {
-    if(m_values_update_needed)
-      return;
-    
-    m_values_update_needed = true;
-
-    if(m_parent && !m_parent->m_values_update_needed)
-      m_parent->request_values_update();
-  }
-
-  void TubeTreeSynthesis::request_integrals_update(bool propagate_to_other_slices)
-  {
-    if(m_integrals_update_needed)
-      return;
-
-    m_integrals_update_needed = true;
-    
-    if(m_parent && !m_parent->m_integrals_update_needed)
-      m_parent->request_integrals_update();
-
-    if(m_slice_ref && propagate_to_other_slices)
+    while(node_id != -1 && !m_nodes[node_id].values_update_needed)
     {
-      // Update everything after the updated slice
-      for(const Slice *s = m_slice_ref->next_slice() ; s ; s = s->next_slice())
-      {
-        assert(s->m_synthesis_reference);
-        s->m_synthesis_reference->request_integrals_update(false);
-      }
+      m_nodes[node_id].values_update_needed = true;
+      node_id = m_nodes[node_id].parent;
     }
   }
 
-  bool TubeTreeSynthesis::is_leaf() const
+  void TubeTreeSynthesis::request_integrals_update(int node_id, bool propagate_to_other_slices)
   {
-    bool is_leaf_ = (m_first_subtree == nullptr && m_second_subtree == nullptr);
-    if(is_leaf_)
-      assert(m_slice_ref);
-    return is_leaf_;
-  }
+    if(m_nodes[node_id].integrals_update_needed)
+      return;
 
-  bool TubeTreeSynthesis::is_root() const
-  {
-    bool is_root_ = (m_parent == nullptr);
-    return is_root_;
-  }
+    const Slice *slice_ref = m_nodes[node_id].slice_ref;
 
-  TubeTreeSynthesis* TubeTreeSynthesis::root()
-  {
-    if(m_parent == nullptr)
-      return this;
-    else
-      return m_parent->root();
-  }
+    for(int id = node_id ; id != -1 && !m_nodes[id].integrals_update_needed ; id = m_nodes[id].parent)
+      m_nodes[id].integrals_update_needed = true;
 
-  void TubeTreeSynthesis::update_values()
-  {
-    if(m_values_update_needed)
+    if(slice_ref && propagate_to_other_slices)
     {
-      if(is_leaf())
-      {
-        m_codomain = m_slice_ref->codomain();
-        m_codomain_bounds = make_pair(m_codomain.lb(), m_codomain.ub());
-        m_codomain_bounds.first |= m_slice_ref->input_gate().lb();
-        m_codomain_bounds.first |= m_slice_ref->output_gate().lb();
-        m_codomain_bounds.second |= m_slice_ref->input_gate().ub();
-        m_codomain_bounds.second |= m_slice_ref->output_gate().ub();
-        m_values_update_needed = false;
-      }
-
-      else
-      {
-        m_first_subtree->update_values();
-        m_second_subtree->update_values();
-
-        m_codomain = m_first_subtree->m_codomain | m_second_subtree->m_codomain;
-        pair<Interval,Interval> p_first = m_first_subtree->m_codomain_bounds;
-        pair<Interval,Interval> p_second = m_second_subtree->m_codomain_bounds;
-        m_codomain_bounds = make_pair(p_first.first | p_second.first, p_first.second | p_second.second);
-
-        m_values_update_needed = false;
-      }
-    }
-  }
-
-  void TubeTreeSynthesis::update_integrals()
-  {
-    if(m_values_update_needed)
-    {
-      // 1. Updating leafs values (leaf nodes)
-
-      if(is_root())
-      {
-        // This part can only be executed from the root
-        // (because integral computation starts from k=0)
-
-        Interval sum = Interval(0);
-        for(const Slice *s = m_tube_ref->first_slice() ; s ; s = s->next_slice())
-        {
-          double dt = s->tdomain().diam();
-          Interval slice_value = s->codomain();
-          Interval integral = sum + slice_value * Interval(0., dt);
-          assert(s->m_synthesis_reference);
-          s->m_synthesis_reference->m_partial_primitive =
-                make_pair(Interval(integral.lb(), integral.lb() + fabs(slice_value.lb() * dt)),
-                          Interval(integral.ub() - fabs(slice_value.ub() * dt), integral.ub()));
-          s->m_synthesis_reference->m_integrals_update_needed = false;
-          sum += slice_value * dt;
-        }
-      }
-
-      // 2. Upper synthesis (tree nodes)
-
-      if(!is_leaf()) // flag already set to false in step 1
+      // Update everything after the updated slice
+      for(const Slice *s = slice_ref->next_slice() ; s ; s = s->next_slice())
       {
-        m_first_subtree->update_integrals();
-        m_second_subtree->update_integrals();
-
-        m_partial_primitive = m_first_subtree->m_partial_primitive;
-        m_partial_primitive.first |= m_second_subtree->m_partial_primitive.first;
-        m_partial_primitive.second |= m_second_subtree->m_partial_primitive.second;
-        
-        m_integrals_update_needed = false;
+        assert(s->m_synthesis_reference == this);
+        request_integrals_update(s->m_synthesis_id, false);
       }
     }
   }
 
   pair<Interval,Interval> TubeTreeSynthesis::partial_integral(const Interval& t)
   {
-    assert(is_root());
-
-    if(m_integrals_update_needed)
-      root()->update_integrals();
+    if(m_nodes[0].integrals_update_needed)
+      update_integrals();
 
     int index_lb = m_tube_ref->time_to_index(t.lb());
     int index_ub = m_tube_ref->time_to_index(t.ub());
@@ -412,7 +235,7 @@ namespace codac
 
     // Part A: integral along the temporal domain [t]&[intv_t_lb]
     {
-      pair<Interval,Interval> partial_primitive_first = s_lb->m_synthesis_reference->m_partial_primitive;
+      pair<Interval,Interval> partial_primitive_first = m_nodes[s_lb->m_synthesis_id].partial_primitive;
       
       if(partial_primitive_first.first.is_empty() || partial_primitive_first.second.is_empty())
         return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
@@ -440,7 +263,7 @@ namespace codac
           integral_lb |= Interval(primitive_lb.lb() - y_first.lb() * tb2.diam(),
                                    primitive_lb.lb() - y_first.lb() * tb1.diam());
 
-        else if(y_first.lb() > 0)
+        else // y_first.lb() >= 0
           integral_lb |= Interval(primitive_lb.lb() + y_first.lb() * ta1.diam(),
                                    primitive_lb.lb() + y_first.lb() * ta2.diam());
 
@@ -448,7 +271,7 @@ namespace codac
           integral_ub |= Interval(primitive_lb.ub() + y_first.ub() * ta2.diam(),
                                    primitive_lb.ub() + y_first.ub() * ta1.diam());
 
-        else if(y_first.ub() > 0)
+        else // y_first.ub() >= 0
           integral_ub |= Interval(primitive_lb.ub() - y_first.ub() * tb1.diam(),
                                    primitive_lb.ub() - y_first.ub() * tb2.diam());
       }
@@ -457,7 +280,7 @@ namespace codac
     // Part B: in between, integral along the temporal domain [ub(intv_t_lb),lb(intv_t_ub)]
     if(index_ub - index_lb > 1)
     {
-      pair<Interval,Interval> partial_primitive = partial_primitive_bounds(Interval(intv_t_lb.ub(), intv_t_ub.lb()));
+      pair<Interval,Interval> partial_primitive = partial_primitive_bounds(0, Interval(intv_t_lb.ub(), intv_t_ub.lb()));
       integral_lb |= partial_primitive.first;
       integral_ub |= partial_primitive.second;
     }
@@ -465,7 +288,7 @@ namespace codac
     // Part C: integral along the temporal domain [t]&[intv_t_ub]
     if(index_lb != index_ub)
     {
-      pair<Interval,Interval> partial_primitive_second = s_ub->m_synthesis_reference->m_partial_primitive;
+      pair<Interval,Interval> partial_primitive_second = m_nodes[s_ub->m_synthesis_id].partial_primitive;
       
       if(partial_primitive_second.first.is_empty() || partial_primitive_second.second.is_empty())
         return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
@@ -492,7 +315,7 @@ namespace codac
           integral_lb |= Interval(primitive_ub.lb() - y_second.lb() * tb2.diam(),
                                    primitive_ub.lb() - y_second.lb() * tb1.diam());
 
-        else if(y_second.lb() > 0)
+        else // y_second.lb() >= 0
           integral_lb |= Interval(primitive_ub.lb(),
                                    primitive_ub.lb() + y_second.lb() * ta.diam());
 
@@ -500,7 +323,7 @@ namespace codac
           integral_ub |= Interval(primitive_ub.ub() + y_second.ub() * ta.diam(),
                                    primitive_ub.ub());
 
-        else if(y_second.ub() > 0)
+        else // y_second.ub() >= 0
           integral_ub |= Interval(primitive_ub.ub() - y_second.ub() * tb1.diam(),
                                    primitive_ub.ub() - y_second.ub() * tb2.diam());
       }
@@ -511,43 +334,446 @@ namespace codac
 
   const pair<Interval,Interval> TubeTreeSynthesis::partial_primitive_bounds(const Interval& t)
   {
-    if(m_integrals_update_needed)
-      root()->update_integrals();
+    if(m_nodes[0].integrals_update_needed)
+      update_integrals();
+    return partial_primitive_bounds(0, t);
+  }
+
+  int TubeTreeSynthesis::depth(int node_id) const
+  {
+    int depth = 0;
+    for(int id = m_nodes[node_id].parent ; id != -1 ; id = m_nodes[id].parent)
+      depth++;
+    return depth;
+  }
+
+  void TubeTreeSynthesis::split_leaf(int leaf_id, const Slice *new_slice)
+  {
+    assert(is_leaf(leaf_id));
+    assert(new_slice && new_slice->prev_slice() == m_nodes[leaf_id].slice_ref);
+    assert(m_nodes[leaf_id].tdomain == (m_nodes[leaf_id].slice_ref->tdomain() | new_slice->tdomain()));
+
+    // The leaf becomes a node made of two leaves,
+    // its temporal domain remains the same
+
+    const Slice *slice = m_nodes[leaf_id].slice_ref;
+    int first_id = create_node(leaf_id);
+    int second_id = create_node(leaf_id);
+    set_leaf(first_id, slice);
+    set_leaf(second_id, new_slice);
+
+    Node& node = m_nodes[leaf_id];
+    node.first_subtree = first_id;
+    node.second_subtree = second_id;
+    node.slice_ref = nullptr;
+    node.nb_slices = 2;
+
+    for(int id = node.parent ; id != -1 ; id = m_nodes[id].parent)
+      m_nodes[id].nb_slices++;
+
+    // Values of the new leaves are evaluated on demand,
+    // only along the path to the root
+
+    node.values_update_needed = false;
+    request_values_update(leaf_id);
+
+    // The integral of the tube is not changed by the sampling:
+    // partial primitives are locally computed if they were up to date
+
+    if(node.integrals_update_needed)
+      return;
+
+    Interval sum = update_leaf_integrals(first_id, node.integral_before);
+    update_leaf_integrals(second_id, sum);
+
+    for(int id = leaf_id ; id != -1 ; id = m_nodes[id].parent)
+    {
+      Node& n = m_nodes[id];
+      if(!n.integrals_update_needed)
+      {
+        n.partial_primitive = m_nodes[n.first_subtree].partial_primitive;
+        n.partial_primitive.first |= m_nodes[n.second_subtree].partial_primitive.first;
+        n.partial_primitive.second |= m_nodes[n.second_subtree].partial_primitive.second;
+      }
+    }
+  }
+
+  void TubeTreeSynthesis::merge_leaves(int first_leaf_id, int second_leaf_id)
+  {
+    // The slice of the second leaf has already been merged into the slice
+    // of the first one, and deleted: its reference must not be used anymore
+
+    assert(is_leaf(first_leaf_id) && is_leaf(second_leaf_id));
+    assert(m_nodes[second_leaf_id].parent != -1);
+    m_nodes[second_leaf_id].slice_ref = nullptr;
+
+    // The parent node of the second leaf takes the place of its sibling
+
+    int node_id = m_nodes[second_leaf_id].parent;
+    int sibling_id = (m_nodes[node_id].first_subtree == second_leaf_id)
+      ? m_nodes[node_id].second_subtree : m_nodes[node_id].first_subtree;
+
+    Node& node = m_nodes[node_id];
+    int parent_id = node.parent;
+    node = m_nodes[sibling_id];
+    node.parent = parent_id;
+
+    if(!is_leaf(node_id))
+    {
+      m_nodes[node.first_subtree].parent = node_id;
+      m_nodes[node.second_subtree].parent = node_id;
+    }
+
+    else
+      node.slice_ref->m_synthesis_id = node_id;
+
+    if(first_leaf_id == sibling_id) // the first leaf is moved up
+      first_leaf_id = node_id;
+
+    m_nodes[sibling_id].slice_ref = nullptr;
+    delete_node(sibling_id);
+    delete_node(second_leaf_id);
+
+    for(int id = parent_id ; id != -1 ; id = m_nodes[id].parent)
+      m_nodes[id].nb_slices--;
+
+    // Temporal domains are updated along the two paths to the root
+
+    update_tdomain(node_id);
+    update_tdomain(first_leaf_id);
+
+    // Syntheses of the ancestors will be computed on demand
+
+    m_nodes[first_leaf_id].values_update_needed = false;
+    request_values_update(first_leaf_id);
+    m_nodes[node_id].values_update_needed = false;
+    request_values_update(node_id);
+    m_nodes[first_leaf_id].integrals_update_needed = false;
+    request_integrals_update(first_leaf_id);
+  }
+
+  // Protected methods
+
+  int TubeTreeSynthesis::create_node(int parent_id)
+  {
+    int node_id;
+
+    if(m_free_nodes.empty())
+    {
+      node_id = m_nodes.size();
+      m_nodes.push_back(Node());
+    }
+
+    else
+    {
+      node_id = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_nodes[node_id] = Node();
+    }
+
+    m_nodes[node_id].parent = parent_id;
+    return node_id;
+  }
+
+  void TubeTreeSynthesis::delete_node(int node_id)
+  {
+    assert(m_nodes[node_id].slice_ref == nullptr);
+    m_nodes[node_id] = Node();
+    m_free_nodes.push_back(node_id);
+  }
+
+  void TubeTreeSynthesis::set_leaf(int node_id, const Slice *slice)
+  {
+    assert(slice);
+    Node& node = m_nodes[node_id];
+    node.slice_ref = slice;
+    node.tdomain = slice->tdomain();
+    node.nb_slices = 1;
+    slice->m_synthesis_reference = this;
+    slice->m_synthesis_id = node_id;
+  }
+
+  bool TubeTreeSynthesis::is_leaf(int node_id) const
+  {
+    bool is_leaf_ = (m_nodes[node_id].first_subtree == -1);
+    if(is_leaf_)
+      assert(m_nodes[node_id].second_subtree == -1);
+    return is_leaf_;
+  }
+
+  int TubeTreeSynthesis::leaf(int node_id, double t) const
+  {
+    assert(m_nodes[node_id].tdomain.contains(t));
+
+    while(!is_leaf(node_id))
+    {
+      const Node& node = m_nodes[node_id];
+
+      if(t < m_nodes[node.first_subtree].tdomain.ub())
+        node_id = node.first_subtree;
+      else
+        node_id = node.second_subtree;
+    }
+
+    return node_id;
+  }
+
+  const Interval TubeTreeSynthesis::codomain(int node_id, const Interval& t) const
+  {
+    const Node& node = m_nodes[node_id];
+
+    if(t.is_empty())
+      return Interval::empty_set();
+
+    else if(t.lb() < node.tdomain.lb() || t.ub() > node.tdomain.ub())
+      return Interval::all_reals();
+
+    else if(t.is_degenerated())
+      return m_tube_ref->operator()(t.lb());
+
+    else if(is_leaf(node_id) || t == node.tdomain)
+      return node.codomain;
+
+    else
+    {
+      Interval inter_firstsubtree = m_nodes[node.first_subtree].tdomain & t;
+      Interval inter_secondsubtree = m_nodes[node.second_subtree].tdomain & t;
+
+      assert(inter_firstsubtree != inter_secondsubtree); // both degenerated
+
+      if(inter_firstsubtree.is_degenerated() && !inter_secondsubtree.is_degenerated())
+        return codomain(node.second_subtree, inter_secondsubtree);
+
+      else if(inter_secondsubtree.is_degenerated() && !inter_firstsubtree.is_degenerated())
+        return codomain(node.first_subtree, inter_firstsubtree);
+
+      else
+        return codomain(node.first_subtree, inter_firstsubtree)
+             | codomain(node.second_subtree, inter_secondsubtree);
+    }
+  }
+
+  const Interval TubeTreeSynthesis::invert(int node_id, const Interval& y, const Interval& search_tdomain) const
+  {
+    const Node& node = m_nodes[node_id];
+
+    if(search_tdomain.is_empty())
+      return Interval::empty_set();
+
+    else if(search_tdomain.lb() < node.tdomain.lb() || search_tdomain.ub() > node.tdomain.ub())
+      return Interval::all_reals();
+
+    else if(!node.codomain.intersects(y))
+      return Interval::empty_set();
+
+    else if(node.codomain_bounds.first.ub() < y.lb() && node.codomain_bounds.second.lb() > y.ub())
+      return search_tdomain;
+
+    else
+    {
+      if(is_leaf(node_id))
+        return search_tdomain;
+
+      else
+        return invert(node.first_subtree, y, search_tdomain & m_nodes[node.first_subtree].tdomain)
+          | invert(node.second_subtree, y, search_tdomain & m_nodes[node.second_subtree].tdomain);
+    }
+  }
+
+  const pair<Interval,Interval> TubeTreeSynthesis::eval(int node_id, const Interval& t) const
+  {
+    const Node& node = m_nodes[node_id];
+    pair<Interval,Interval> p = make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
+
+    if(t.is_degenerated()) // faster to perform the evaluation over the related slice
+      p = m_nodes[leaf(node_id, t.lb())].slice_ref->eval(t);
+
+    else if(t.is_empty())
+      p = make_pair(Interval::empty_set(), Interval::empty_set());
+
+    else if(is_leaf(node_id) || t == node.tdomain) // todo: this last condition useful?
+    {
+      if(t == node.tdomain)
+        p = node.codomain_bounds;
+
+      else
+        p = node.slice_ref->eval(t & node.tdomain);
+    }
+
+    else if(t.intersects(node.tdomain))
+    {
+      Interval inter_firstsubtree = m_nodes[node.first_subtree].tdomain & t;
+      Interval inter_secondsubtree = m_nodes[node.second_subtree].tdomain & t;
+
+      assert(inter_firstsubtree != inter_secondsubtree); // both degenerated
+
+      if(inter_firstsubtree.is_degenerated() && !inter_secondsubtree.is_degenerated())
+        p = eval(node.second_subtree, inter_secondsubtree);
+
+      else if(inter_secondsubtree.is_degenerated() && !inter_firstsubtree.is_degenerated())
+        p = eval(node.first_subtree, inter_firstsubtree);
+
+      else
+      {
+        pair<Interval,Interval> p_first = eval(node.first_subtree, inter_firstsubtree);
+        pair<Interval,Interval> p_second = eval(node.second_subtree, inter_secondsubtree);
+        p = make_pair(p_first.first | p_second.first, p_first.second | p_second.second);
+      }
+    }
+
+    // Outside tdomain
+    if(t.lb() < node.tdomain.lb() || t.ub() > node.tdomain.ub())
+    {
+      p.first |= NEG_INFINITY;
+      p.second |= POS_INFINITY;
+    }
+
+    return p;
+  }
+
+  const pair<Interval,Interval> TubeTreeSynthesis::partial_primitive_bounds(int node_id, const Interval& t) const
+  {
+    const Node& node = m_nodes[node_id];
 
     // todo: deal with t outside tdomain
 
     if(t == Interval::ALL_REALS)
-      return m_partial_primitive; // pre-computed values
+      return node.partial_primitive; // pre-computed values
 
-    Interval intersection = tdomain() & t;
+    Interval intersection = node.tdomain & t;
 
     if(intersection.is_empty())
       return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
 
-    else if(is_leaf() || t == tdomain() || t.is_superset(tdomain()))
-      return m_partial_primitive; // pre-computed values
+    else if(is_leaf(node_id) || t == node.tdomain || t.is_superset(node.tdomain))
+      return node.partial_primitive; // pre-computed values
 
     else
     {
-      Interval inter_firstsubtree = m_first_subtree->tdomain() & intersection;
-      Interval inter_secondsubtree = m_second_subtree->tdomain() & intersection;
+      const Node& first = m_nodes[node.first_subtree];
+      const Node& second = m_nodes[node.second_subtree];
+      Interval inter_firstsubtree = first.tdomain & intersection;
+      Interval inter_secondsubtree = second.tdomain & intersection;
       
       if(inter_firstsubtree.is_degenerated() && inter_secondsubtree.is_degenerated())
-        return make_pair(m_first_subtree->partial_primitive_bounds().first & m_second_subtree->partial_primitive_bounds().first,
-                         m_first_subtree->partial_primitive_bounds().second & m_second_subtree->partial_primitive_bounds().second);
+        return make_pair(first.partial_primitive.first & second.partial_primitive.first,
+                         first.partial_primitive.second & second.partial_primitive.second);
      
       else if(inter_firstsubtree.is_empty() || inter_firstsubtree.is_degenerated())
-        return m_second_subtree->partial_primitive_bounds(inter_secondsubtree);
+        return partial_primitive_bounds(node.second_subtree, inter_secondsubtree);
       
       else if(inter_secondsubtree.is_empty() || inter_secondsubtree.is_degenerated())
-        return m_first_subtree->partial_primitive_bounds(inter_firstsubtree);
+        return partial_primitive_bounds(node.first_subtree, inter_firstsubtree);
 
       else
       {
-        pair<Interval,Interval> pp_past = m_first_subtree->partial_primitive_bounds(inter_firstsubtree);
-        pair<Interval,Interval> pp_future = m_second_subtree->partial_primitive_bounds(inter_secondsubtree);
+        pair<Interval,Interval> pp_past = partial_primitive_bounds(node.first_subtree, inter_firstsubtree);
+        pair<Interval,Interval> pp_future = partial_primitive_bounds(node.second_subtree, inter_secondsubtree);
         return make_pair(pp_past.first | pp_future.first, pp_past.second | pp_future.second);
       }
     }
   }
-}
\ No newline at end of file
+
+  void TubeTreeSynthesis::update_values()
+  {
+    update_values(0);
+  }
+
+  void TubeTreeSynthesis::update_values(int node_id)
+  {
+    Node& node = m_nodes[node_id];
+
+    if(node.values_update_needed)
+    {
+      if(is_leaf(node_id))
+      {
+        const Slice *s = node.slice_ref;
+        node.codomain = s->codomain();
+        node.codomain_bounds = make_pair(node.codomain.lb(), node.codomain.ub());
+        node.codomain_bounds.first |= s->input_gate().lb();
+        node.codomain_bounds.first |= s->output_gate().lb();
+        node.codomain_bounds.second |= s->input_gate().ub();
+        node.codomain_bounds.second |= s->output_gate().ub();
+        node.values_update_needed = false;
+      }
+
+      else
+      {
+        update_values(node.first_subtree);
+        update_values(node.second_subtree);
+
+        const Node& first = m_nodes[node.first_subtree];
+        const Node& second = m_nodes[node.second_subtree];
+        node.codomain = first.codomain | second.codomain;
+        node.codomain_bounds = make_pair(first.codomain_bounds.first | second.codomain_bounds.first,
+                                         first.codomain_bounds.second | second.codomain_bounds.second);
+        node.values_update_needed = false;
+      }
+    }
+  }
+
+  void TubeTreeSynthesis::update_integrals()
+  {
+    if(m_nodes[0].integrals_update_needed)
+    {
+      // 1. Updating leafs values (leaf nodes)
+      // (integral computation starts from k=0)
+
+      Interval sum = Interval(0);
+      for(const Slice *s = m_tube_ref->first_slice() ; s ; s = s->next_slice())
+      {
+        assert(s->m_synthesis_reference == this);
+        sum = update_leaf_integrals(s->m_synthesis_id, sum);
+      }
+
+      // 2. Upper synthesis (tree nodes)
+
+      update_integrals(0);
+    }
+  }
+
+  void TubeTreeSynthesis::update_integrals(int node_id)
+  {
+    Node& node = m_nodes[node_id];
+
+    if(node.integrals_update_needed && !is_leaf(node_id)) // flag of leaves already set to false
+    {
+      update_integrals(node.first_subtree);
+      update_integrals(node.second_subtree);
+
+      node.partial_primitive = m_nodes[node.first_subtree].partial_primitive;
+      node.partial_primitive.first |= m_nodes[node.second_subtree].partial_primitive.first;
+      node.partial_primitive.second |= m_nodes[node.second_subtree].partial_primitive.second;
+      
+      node.integrals_update_needed = false;
+    }
+  }
+
+  const Interval TubeTreeSynthesis::update_leaf_integrals(int leaf_id, const Interval& integral_before)
+  {
+    assert(is_leaf(leaf_id));
+    Node& node = m_nodes[leaf_id];
+
+    double dt = node.slice_ref->tdomain().diam();
+    Interval slice_value = node.slice_ref->codomain();
+    Interval integral = integral_before + slice_value * Interval(0., dt);
+    node.partial_primitive =
+          make_pair(Interval(integral.lb(), integral.lb() + fabs(slice_value.lb() * dt)),
+                    Interval(integral.ub() - fabs(slice_value.ub() * dt), integral.ub()));
+    node.integral_before = integral_before;
+    node.integrals_update_needed = false;
+    return integral_before + slice_value * dt;
+  }
+
+  void TubeTreeSynthesis::update_tdomain(int node_id)
+  {
+    for(int id = node_id ; id != -1 ; id = m_nodes[id].parent)
+    {
+      Node& node = m_nodes[id];
+      if(is_leaf(id))
+        node.tdomain = node.slice_ref->tdomain();
+      else
+        node.tdomain = m_nodes[node.first_subtree].tdomain | m_nodes[node.second_subtree].tdomain;
+    }
+  }
+}
@@ -19,7 +19,7 @@ namespace codac
   {
     public:
 
-      TubeTreeSynthesis(const Tube* tube, int k0, int kf, const std::vector<const Slice*>& v_tube_slices);
+      TubeTreeSynthesis(const Tube* tube, const std::vector<const Slice*>& v_tube_slices);
       ~TubeTreeSynthesis();
 
       const Interval tdomain() const;
@@ -29,42 +29,62 @@ namespace codac
       const Interval codomain();
       const std::pair<Interval,Interval> codomain_bounds();
       const std::pair<Interval,Interval> eval(const Interval& t = Interval::ALL_REALS);
-      
+
       int time_to_index(double t) const;
       Slice* slice(int slice_id);
       const Slice* slice(int slice_id) const;
       Slice* slice(double t);
       const Slice* slice(double t) const;
 
-      bool is_leaf() const;
-      bool is_root() const;
-      TubeTreeSynthesis* root();
-
-      void request_values_update();
-      void request_integrals_update(bool propagate_to_other_slices = true);
-      void update_values();
-      void update_integrals();
+      void request_values_update(int node_id);
+      void request_integrals_update(int node_id, bool propagate_to_other_slices = true);
       std::pair<Interval,Interval> partial_integral(const Interval& t);
       const std::pair<Interval,Interval> partial_primitive_bounds(const Interval& t = Interval::ALL_REALS);
 
+      int depth(int node_id) const;
+      void split_leaf(int leaf_id, const Slice *new_slice);
+      void merge_leaves(int first_leaf_id, int second_leaf_id);
+
     protected:
 
-      // Slices connections
-      const Slice *m_slice_ref = nullptr;
-      const Tube *m_tube_ref = nullptr;
+      // Nodes are stored in a single array, and linked by their indices.
+      // The tree is laid out breadth-first, so that the upper levels,
+      // visited by all the queries, are contiguous in memory.
+      struct Node
+      {
+        Interval tdomain, codomain;
+        std::pair<Interval,Interval> codomain_bounds;
+        std::pair<Interval,Interval> partial_primitive;
+        Interval integral_before; // leaves only: integral of the tube before the slice
+        const Slice *slice_ref = nullptr; // leaves only
+        int parent = -1, first_subtree = -1, second_subtree = -1;
+        int nb_slices = 1;
+        bool values_update_needed = true;
+        bool integrals_update_needed = true;
+      };
 
-      // Binary tree structure
-      TubeTreeSynthesis *m_parent = nullptr;
-      TubeTreeSynthesis *m_first_subtree = nullptr, *m_second_subtree = nullptr;
+      int create_node(int parent_id);
+      void delete_node(int node_id);
+      void set_leaf(int node_id, const Slice *slice);
+      bool is_leaf(int node_id) const;
+      int leaf(int node_id, double t) const;
 
-      int m_nb_slices = 1;
-      Interval m_tdomain, m_codomain;
-      std::pair<Interval,Interval> m_codomain_bounds;
-      std::pair<Interval,Interval> m_partial_primitive;
+      const Interval codomain(int node_id, const Interval& t) const;
+      const Interval invert(int node_id, const Interval& y, const Interval& search_tdomain) const;
+      const std::pair<Interval,Interval> eval(int node_id, const Interval& t) const;
+      const std::pair<Interval,Interval> partial_primitive_bounds(int node_id, const Interval& t) const;
 
-      bool m_integrals_update_needed = true;
-      bool m_values_update_needed = true;
+      void update_values();
+      void update_values(int node_id);
+      void update_integrals();
+      void update_integrals(int node_id);
+      const Interval update_leaf_integrals(int leaf_id, const Interval& integral_before);
+      void update_tdomain(int node_id);
+
+      const Tube *m_tube_ref = nullptr;
+      std::vector<Node> m_nodes; // the root is the first node
+      std::vector<int> m_free_nodes; // indices of removed nodes, available for new ones
   };
 }
 
-#endif
\ No newline at end of file
+#endif
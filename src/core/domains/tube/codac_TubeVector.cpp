@@ -618,12 +618,12 @@ namespace codac
       Trajectory diag_traj;
       TrajectoryVector diams = diam(gates_thicknesses);
 
-      for(map<double,double>::const_iterator it = diams[0].sampled_map().begin() ; it != diams[0].sampled_map().end() ; it++)
+      for(double t : diams[0].sampled_times())
       {
         double diag = 0.;
         for(int i = start_index ; i <= end_index ; i++)
-          diag += std::pow(diams(it->first)[i], 2);
-        diag_traj.set(std::sqrt(diag), it->first);
+          diag += std::pow(diams(t)[i], 2);
+        diag_traj.set(std::sqrt(diag), t);
       }
 
       return diag_traj;
@@ -1118,7 +1118,7 @@ namespace codac
        * \note The values and sampling (slices and gates) are serialized
        *
        * \param binary_file_name name of the output file (default value: "x.tube")
-       * \param version_number serialization version (used for tests purposes, default value: last version)
+       * \param version_number serialization version (default value: SERIALIZATION_VERSION, see serialize_Tube())
        */
       void serialize(const std::string& binary_file_name = "x.tube", int version_number = SERIALIZATION_VERSION) const;
 
@@ -1131,7 +1131,7 @@ namespace codac
        *
        * \param binary_file_name name of the output file (default value: "x.tube")
        * \param traj the TrajectoryVector object to serialize (for instance, actual but unknown values)
-       * \param version_number serialization version (used for tests purposes, default value: last version)
+       * \param version_number serialization version (default value: SERIALIZATION_VERSION, see serialize_Tube())
        */
       void serialize(const std::string& binary_file_name, const TrajectoryVector& traj, int version_number = SERIALIZATION_VERSION) const;
 
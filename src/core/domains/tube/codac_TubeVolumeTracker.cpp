@@ -0,0 +1,168 @@
+/**
+ *  TubeVolumeTracker class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cmath>
+#include "codac_TubeVolumeTracker.h"
+#include "codac_Slice.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  TubeVolumeTracker::TubeVolumeTracker()
+    : m_nb_dirty_slices(0)
+  {
+
+  }
+
+  double TubeVolumeTracker::envelopes_volume(const Slice *first_slice)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    update(first_slice);
+    return sum(0);
+  }
+
+  double TubeVolumeTracker::gates_volume(const Slice *first_slice)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    update(first_slice);
+    return sum(1);
+  }
+
+  void TubeVolumeTracker::request_update(const Slice *s)
+  {
+    if(!m_synchronized) // the sums will be recomputed anyway
+      return;
+
+    if(!s->m_volume_dirty.exchange(true)) // each slice is listed only once
+    {
+      int i = m_nb_dirty_slices++;
+      assert(i < (int)m_v_dirty_slices.size());
+      m_v_dirty_slices[i] = s;
+    }
+  }
+
+  void TubeVolumeTracker::add_slice(const Slice *s)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if(!m_synchronized)
+      return;
+
+    s->m_volume_tracker = this;
+    s->m_tracked_volume[0] = 0.;
+    s->m_tracked_volume[1] = 0.;
+    s->m_volume_dirty = false;
+
+    m_nb_slices++;
+    m_v_dirty_slices.resize(m_nb_slices);
+    request_update(s);
+  }
+
+  void TubeVolumeTracker::invalidate()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_synchronized = false;
+  }
+
+  void TubeVolumeTracker::update(const Slice *first_slice)
+  {
+    int nb_dirty_slices = m_nb_dirty_slices;
+
+    if(!m_synchronized || m_nb_updates + nb_dirty_slices > m_nb_slices)
+    {
+      synchronize(first_slice);
+      return;
+    }
+
+    for(int i = 0 ; i < nb_dirty_slices ; i++)
+    {
+      const Slice *s = m_v_dirty_slices[i];
+      s->m_volume_dirty = false;
+
+      double envelope_vol = s->volume();
+      double gates_vol = s->output_gate().diam() + (s->prev_slice() ? 0. : s->input_gate().diam());
+      if(envelope_vol == s->m_tracked_volume[0] && gates_vol == s->m_tracked_volume[1])
+        continue; // the sums are kept unchanged, bit for bit
+
+      accumulate(s->m_tracked_volume[0], s->m_tracked_volume[1], -1);
+      s->m_tracked_volume[0] = envelope_vol;
+      s->m_tracked_volume[1] = gates_vol;
+      accumulate(s->m_tracked_volume[0], s->m_tracked_volume[1], 1);
+      m_nb_updates++;
+    }
+
+    m_nb_dirty_slices = 0;
+
+    // Subtracting large contributions from the sums may lead to cancellations
+    for(int i = 0 ; i < 2 ; i++)
+      if(m_sum[i] + m_compensation[i] < m_synchronized_sum[i] / 16.)
+      {
+        synchronize(first_slice);
+        return;
+      }
+  }
+
+  void TubeVolumeTracker::synchronize(const Slice *first_slice)
+  {
+    m_sum[0] = 0.; m_sum[1] = 0.;
+    m_compensation[0] = 0.; m_compensation[1] = 0.;
+    m_nb_unbounded[0] = 0; m_nb_unbounded[1] = 0;
+    m_nb_slices = 0;
+
+    for(const Slice *s = first_slice ; s ; s = s->next_slice())
+    {
+      s->m_volume_tracker = this;
+      s->m_tracked_volume[0] = s->volume();
+      s->m_tracked_volume[1] = s->output_gate().diam() + (s->prev_slice() ? 0. : s->input_gate().diam());
+      accumulate(s->m_tracked_volume[0], s->m_tracked_volume[1], 1);
+      s->m_volume_dirty = false;
+      m_nb_slices++;
+    }
+
+    m_v_dirty_slices.assign(m_nb_slices, nullptr);
+    m_nb_dirty_slices = 0;
+    m_nb_updates = 0;
+    m_synchronized = true;
+    m_synchronized_sum[0] = m_sum[0] + m_compensation[0];
+    m_synchronized_sum[1] = m_sum[1] + m_compensation[1];
+  }
+
+  void TubeVolumeTracker::accumulate(double envelope_vol, double gates_vol, int sign)
+  {
+    double v[2] = { envelope_vol, gates_vol };
+
+    for(int i = 0 ; i < 2 ; i++)
+    {
+      if(std::isinf(v[i]))
+        m_nb_unbounded[i] += sign;
+      else
+        add_term(i, sign * v[i]);
+    }
+  }
+
+  void TubeVolumeTracker::add_term(int i, double x)
+  {
+    // The rounding error of the addition is exactly computed and kept apart
+    double t = m_sum[i] + x;
+    if(std::fabs(m_sum[i]) >= std::fabs(x))
+      m_compensation[i] += (m_sum[i] - t) + x;
+    else
+      m_compensation[i] += (x - t) + m_sum[i];
+    m_sum[i] = t;
+  }
+
+  double TubeVolumeTracker::sum(int i) const
+  {
+    assert(m_nb_unbounded[i] >= 0);
+    return m_nb_unbounded[i] > 0 ? POS_INFINITY : std::max(0., m_sum[i] + m_compensation[i]);
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ *  \file
+ *  TubeVolumeTracker class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBEVOLUMETRACKER_H__
+#define __CODAC_TUBEVOLUMETRACKER_H__
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+namespace codac
+{
+  class Slice;
+
+  /**
+   * \class TubeVolumeTracker
+   * \brief Running sums of the volumes of the slices and of the diameters
+   *        of the gates of a tube
+   *
+   * Each slice stores its last accounted contributions. When a slice is
+   * modified, it is appended to a list of dirty slices, and only these
+   * slices are considered when the sums are next requested.
+   *
+   * Dirty slices can be reported concurrently by several threads, as long as
+   * the sums are not requested at the same time. The sums can be requested
+   * concurrently (requests are serialized by a mutex), for instance by const
+   * methods of the tube called from several threads.
+   *
+   * The sums are compensated (Kahan-Babuska-Neumaier summation), and slices
+   * reported with unchanged contributions are ignored: a fixed-point test does
+   * not see spurious variations of volume. The sums are also recomputed from
+   * scratch when the number of incremental updates exceeds the number of slices,
+   * or when they have been strongly reduced.
+   */
+  class TubeVolumeTracker
+  {
+    public:
+
+      TubeVolumeTracker();
+
+      /**
+       * \brief Returns the sum of the volumes of the slices
+       *
+       * \param first_slice first slice of the related tube
+       * \return the volume, or POS_INFINITY if one of the slices is unbounded
+       */
+      double envelopes_volume(const Slice *first_slice);
+
+      /**
+       * \brief Returns the sum of the diameters of the gates
+       *
+       * \param first_slice first slice of the related tube
+       * \return the sum, or POS_INFINITY if one of the gates is unbounded
+       */
+      double gates_volume(const Slice *first_slice);
+
+      /**
+       * \brief Reports a slice whose contributions have to be updated
+       *
+       * \note Can be called concurrently by several threads.
+       *
+       * \param s pointer to the modified slice
+       */
+      void request_update(const Slice *s);
+
+      /**
+       * \brief Reports a slice that has been added in the tube by sampling
+       *
+       * \param s pointer to the new slice
+       */
+      void add_slice(const Slice *s);
+
+      /**
+       * \brief Requires a computation from scratch at the next request,
+       *        after a structural change of the tube
+       */
+      void invalidate();
+
+    protected:
+
+      TubeVolumeTracker(const TubeVolumeTracker&) = delete;
+      TubeVolumeTracker& operator=(const TubeVolumeTracker&) = delete;
+
+      /**
+       * \brief Accounts for the dirty slices, or recomputes the sums if needed
+       *
+       * \param first_slice first slice of the related tube
+       */
+      void update(const Slice *first_slice);
+
+      /**
+       * \brief Computes the sums from scratch and attaches the slices to this tracker
+       *
+       * \param first_slice first slice of the related tube
+       */
+      void synchronize(const Slice *first_slice);
+
+      /**
+       * \brief Adds (or removes) the contributions of a slice to the sums
+       *
+       * \param envelope_vol volume of the slice
+       * \param gates_vol diameter of the gates related to the slice
+       * \param sign 1 to add the contributions, -1 to remove them
+       */
+      void accumulate(double envelope_vol, double gates_vol, int sign);
+
+      /**
+       * \brief Adds a term to a compensated sum
+       *
+       * \param i 0 for the volumes of the slices, 1 for the diameters of the gates
+       * \param x the bounded term to be added
+       */
+      void add_term(int i, double x);
+
+      /**
+       * \brief Returns a sum, or POS_INFINITY if it contains unbounded terms
+       *
+       * \param i 0 for the volumes of the slices, 1 for the diameters of the gates
+       * \return the sum
+       */
+      double sum(int i) const;
+
+      // Class variables:
+
+        std::vector<const Slice*> m_v_dirty_slices; //!< slices modified since the last update
+        std::atomic<int> m_nb_dirty_slices; //!< number of slices in m_v_dirty_slices
+        bool m_synchronized = false; //!< false if the sums have to be recomputed from scratch
+        int m_nb_slices = 0; //!< number of slices of the tube
+        int m_nb_updates = 0; //!< number of incremental updates since the last synchronization
+
+        double m_sum[2] = {0.,0.}; //!< sums of the bounded terms (volumes of slices, diameters of gates)
+        double m_compensation[2] = {0.,0.}; //!< rounding errors of the sums, to be added to them
+        int m_nb_unbounded[2] = {0,0}; //!< numbers of unbounded terms
+        double m_synchronized_sum[2] = {0.,0.}; //!< sums at the last synchronization
+        std::mutex m_mutex; //!< serializes the requests of the sums and the structural changes
+  };
+}
+
+#endif
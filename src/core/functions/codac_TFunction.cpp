@@ -10,6 +10,7 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 #include "codac_TFunction.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
@@ -141,6 +142,7 @@ namespace codac
 
   TFunction::~TFunction()
   {
+    m_thread_pool.reset(); // waiting for the end of the workers
     delete m_ibex_f;
   }
 
@@ -151,6 +153,10 @@ namespace codac
     m_ibex_f = new Function(*f.m_ibex_f);
     m_expr = f.m_expr;
     TFnc::operator=(f);
+
+    if(m_thread_pool) // copies of the new function
+      set_nb_threads(nb_threads());
+
     return *this;
   }
 
@@ -211,6 +217,29 @@ namespace codac
     return m_ibex_f->arg_name(i+1);
   }
 
+  void TFunction::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+
+    if(nb_threads == 0)
+      nb_threads = ThreadPool::hardware_concurrency();
+
+    m_thread_pool.reset(); // waiting for the end of the workers
+    m_fnc_copies.clear();
+
+    if(nb_threads == 1)
+      return;
+
+    for(int i = 1 ; i < nb_threads ; i++)
+      m_fnc_copies.push_back(unique_ptr<Function>(new Function(*m_ibex_f)));
+    m_thread_pool = unique_ptr<ThreadPool>(new ThreadPool(nb_threads));
+  }
+
+  int TFunction::nb_threads() const
+  {
+    return m_thread_pool ? m_thread_pool->nb_threads() : 1;
+  }
+
   void TFunction::construct_from_array(int n, const char** x, const char* y)
   {
     assert(n >= 0);
@@ -362,6 +391,12 @@ namespace codac
       return y;
     }
 
+    if(m_thread_pool)
+    {
+      eval_vector_parallel(x, y);
+      return y;
+    }
+
     IntervalVector box(x.size() + 1), result(y.size());
 
     const Slice **v_sx = new const Slice*[x.size()];
@@ -418,6 +453,90 @@ namespace codac
     return y;
   }
 
+  void TFunction::eval_vector_parallel(const TubeVector& x, TubeVector& y) const
+  {
+    const int n = nb_var(); // components of x in the boxes
+    const int max_block_size = ThreadPool::SLICES_PER_TASK * ThreadPool::TASKS_PER_THREAD * m_thread_pool->nb_threads();
+
+    vector<const Slice*> v_sx(x.size());
+    vector<Slice*> v_sy(y.size());
+    for(int i = 0 ; i < x.size() ; i++)
+      v_sx[i] = x[i].first_slice();
+    for(int i = 0 ; i < y.size() ; i++)
+      v_sy[i] = y[i].first_slice();
+
+    vector<const Slice*> v_block_x; // slices of the block, v_block_x[k*x.size()+i] being the k-th slice of x[i]
+    vector<Slice*> v_block_y;
+    vector<IntervalVector> v_envelope(max_block_size, IntervalVector(y.size()));
+    vector<IntervalVector> v_ingate(max_block_size, IntervalVector(y.size()));
+    v_block_x.reserve(max_block_size*x.size());
+    v_block_y.reserve(max_block_size*y.size());
+
+    while(v_sx[0])
+    {
+      // Gathering the slices of the block
+
+      v_block_x.clear();
+      v_block_y.clear();
+      for(int k = 0 ; k < max_block_size && v_sx[0] ; k++)
+      {
+        v_block_x.insert(v_block_x.end(), v_sx.begin(), v_sx.end());
+        v_block_y.insert(v_block_y.end(), v_sy.begin(), v_sy.end());
+        for(auto& s : v_sx) s = s->next_slice();
+        for(auto& s : v_sy) s = s->next_slice();
+      }
+
+      const int block_size = v_block_x.size() / x.size();
+      const int nb_tasks = (block_size + ThreadPool::SLICES_PER_TASK - 1) / ThreadPool::SLICES_PER_TASK;
+
+      // Evaluating the envelopes and input gates (the tubes are not modified by the threads)
+
+      m_thread_pool->run(nb_tasks, [&](int task_id, int thread_id)
+      {
+        Function& f = thread_id == 0 ? *m_ibex_f : *m_fnc_copies[thread_id-1];
+        IntervalVector box(n + 1); // +1 for system variable (t)
+        int k_end = std::min(block_size, (task_id+1) * ThreadPool::SLICES_PER_TASK);
+
+        for(int k = task_id * ThreadPool::SLICES_PER_TASK ; k < k_end ; k++)
+        {
+          const Slice **s = &v_block_x[k*x.size()];
+
+          box[0] = s[0]->tdomain();
+          for(int i = 0 ; i < n ; i++)
+            box[i+1] = s[i]->codomain();
+          v_envelope[k] = f.eval_vector(box);
+
+          box[0] = s[0]->tdomain().lb();
+          for(int i = 0 ; i < n ; i++)
+            box[i+1] = s[i]->input_gate();
+          v_ingate[k] = f.eval_vector(box);
+        }
+      });
+
+      // Setting the values in the calling thread
+
+      for(int k = 0 ; k < block_size ; k++)
+        for(int i = 0 ; i < y.size() ; i++)
+        {
+          v_block_y[k*y.size()+i]->set_envelope(v_envelope[k][i], false);
+          v_block_y[k*y.size()+i]->set_input_gate(v_ingate[k][i], false);
+        }
+    }
+
+    // Output gate, from the last slices of the last block
+
+    const Slice **s_x = &v_block_x[v_block_x.size() - x.size()];
+    Slice **s_y = &v_block_y[v_block_y.size() - y.size()];
+
+    IntervalVector box(n + 1);
+    box[0] = s_x[0]->tdomain().ub();
+    for(int i = 0 ; i < n ; i++)
+      box[i+1] = s_x[i]->output_gate();
+    IntervalVector result = m_ibex_f->eval_vector(box);
+    for(int i = 0 ; i < y.size() ; i++)
+      s_y[i]->set_output_gate(result[i], false);
+  }
+
   const TrajectoryVector TFunction::traj_eval_vector(const TrajectoryVector& x) const
   {
     // Faster evaluation than the generic Fnc::eval method
@@ -434,14 +553,13 @@ namespace codac
       && "eval TFunction not supported for analytic trajectories");
     
     TrajectoryVector y(image_dim());
-    for(map<double,double>::const_iterator it = x[0].sampled_map().begin() ;
-        it != x[0].sampled_map().end() ; it++)
+    for(double t : x[0].sampled_times())
     {
       Vector v(nb_var() + 1);
-      v[0] = it->first;
-      v.put(1, x(it->first));
+      v[0] = t;
+      v.put(1, x(t));
 
-      y.set(m_ibex_f->eval_vector(v).mid(), it->first);
+      y.set(m_ibex_f->eval_vector(v).mid(), t);
     }
 
     return y;
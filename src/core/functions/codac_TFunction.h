@@ -12,10 +12,13 @@
 #define __CODAC_TFUNCTION_H__
 
 #include <string>
+#include <vector>
+#include <memory>
 #include "codac_Function.h"
 #include "codac_TFnc.h"
 #include "codac_Trajectory.h"
 #include "codac_TrajectoryVector.h"
+#include "codac_ThreadPool.h"
 
 namespace codac
 {
@@ -71,12 +74,43 @@ namespace codac
 
       const TFunction diff() const;
 
+      /**
+       * \brief Enables the parallel evaluation of the slices of tubes
+       *
+       * Each thread is given its own copy of the IBEX function, as its evaluation
+       * is not thread-safe. Results do not depend on the number of threads.
+       *
+       * \note This setting is not transmitted to copies of this function.
+       *
+       * \param nb_threads number of threads (if 0, the number of hardware
+       *        threads is used; 1 disables the parallel mode)
+       */
+      void set_nb_threads(int nb_threads = 0);
+
+      /**
+       * \brief Returns the number of threads used for evaluating tubes
+       *
+       * \return the number of threads, 1 if the parallel mode is disabled
+       */
+      int nb_threads() const;
+
     protected:
 
       void construct_from_array(int n, const char** x, const char* y);
 
+      /**
+       * \brief Evaluates the slices of \f$[\mathbf{x}](\cdot)\f$ by blocks, in parallel
+       *
+       * \param x the input tube
+       * \param y the output tube, with the slicing of x
+       */
+      void eval_vector_parallel(const TubeVector& x, TubeVector& y) const;
+
       Function *m_ibex_f = nullptr;
       std::string m_expr; // stored here because impossible to get this value from Function
+
+      std::unique_ptr<ThreadPool> m_thread_pool; //!< threads used for parallel evaluations (nullptr in sequential mode)
+      std::vector<std::unique_ptr<Function> > m_fnc_copies; //!< copies of the function for the additional threads
   };
 }
 
@@ -469,11 +469,12 @@ namespace codac
 
     if(traj->definition_type() == TrajDefnType::MAP_OF_VALUES)
     {
-      typename map<double,double>::const_iterator it_scalar_values;
-      for(it_scalar_values = traj->sampled_map().begin(); it_scalar_values != traj->sampled_map().end(); it_scalar_values++)
+      const vector<double>& v_t = traj->sampled_times();
+      const vector<double>& v_values = traj->sampled_values();
+      for(size_t i = 0 ; i < v_t.size() ; i++)
       {
         if(m_map_trajs[traj].points_size != 0.)
-          draw_point(ThickPoint(it_scalar_values->first, it_scalar_values->second), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
+          draw_point(ThickPoint(v_t[i], v_values[i]), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
 
         else
         {
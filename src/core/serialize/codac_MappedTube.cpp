@@ -0,0 +1,236 @@
+/**
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include "codac_MappedTube.h"
+#include "codac_serialize_tubes.h"
+#include "codac_serialize_intervals.h"
+#include "codac_Exception.h"
+#include "codac_Tube.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Offset of the arrays in the file: version number, padding, header
+  static const size_t ARRAYS_OFFSET = 8 + sizeof(TubeBinaryHeader);
+
+  // Definition
+
+  MappedTube::MappedTube(const string& binary_file_name)
+  {
+    try
+    {
+      map_file(binary_file_name);
+    }
+
+    catch(...) // the destructor will not be called
+    {
+      unmap_file();
+      throw;
+    }
+  }
+
+  MappedTube::~MappedTube()
+  {
+    unmap_file();
+  }
+
+  int MappedTube::nb_slices() const
+  {
+    return m_nb_slices;
+  }
+
+  const Interval MappedTube::tdomain() const
+  {
+    return Interval(m_t[0], m_t[m_nb_slices]);
+  }
+
+  int MappedTube::time_to_index(double t) const
+  {
+    assert(tdomain().contains(t));
+    int k = upper_bound(m_t, m_t + m_nb_slices, t) - m_t - 1;
+    return std::max(0, k);
+  }
+
+  const Interval MappedTube::slice_tdomain(int slice_id) const
+  {
+    assert(slice_id >= 0 && slice_id < m_nb_slices);
+    return Interval(m_t[slice_id], m_t[slice_id+1]);
+  }
+
+  const Interval MappedTube::slice_codomain(int slice_id) const
+  {
+    assert(slice_id >= 0 && slice_id < m_nb_slices);
+    Interval codomain;
+    deserialize_Interval(&m_codomains[2*slice_id], codomain);
+    return codomain;
+  }
+
+  const Interval MappedTube::gate(int gate_id) const
+  {
+    assert(gate_id >= 0 && gate_id <= m_nb_slices);
+    Interval gate;
+    deserialize_Interval(&m_gates[2*gate_id], gate);
+    return gate;
+  }
+
+  // Accessing values
+
+  const Interval MappedTube::codomain() const
+  {
+    return operator()(tdomain());
+  }
+
+  const Interval MappedTube::operator()(double t) const
+  {
+    if(!tdomain().contains(t))
+      return Interval::all_reals();
+
+    int i = time_to_index(t);
+
+    if(t == m_t[i])
+      return gate(i);
+
+    else if(t == m_t[i+1])
+      return gate(i+1);
+
+    return slice_codomain(i);
+  }
+
+  const Interval MappedTube::operator()(const Interval& t) const
+  {
+    if(t.is_empty())
+      return Interval::empty_set();
+
+    else if(t.lb() < tdomain().lb() || t.ub() > tdomain().ub())
+      return Interval::all_reals();
+
+    else if(t.is_degenerated())
+      return operator()(t.lb());
+
+    // Same slices as for Tube::operator()(const Interval&)
+    int first = time_to_index(t.lb());
+    int last = time_to_index(t.ub());
+    if(m_t[last] == t.ub())
+      last--;
+
+    Interval codomain = Interval::EMPTY_SET;
+    for(int i = first ; i <= last ; i++)
+      codomain |= slice_codomain(i);
+    return codomain;
+  }
+
+  void MappedTube::load_tube(Tube *&tube, const Interval& t) const
+  {
+    Interval t_ = t & tdomain();
+    if(t_.is_empty())
+      throw Exception(__func__, "the tube is not defined over [t]");
+
+    int first = time_to_index(t_.lb());
+    int last = time_to_index(t_.ub());
+    if(last > first && m_t[last] == t_.ub())
+      last--;
+
+    deserialize_Tube(&m_t[first], &m_codomains[2*first], &m_gates[2*first], last - first + 1, tube);
+  }
+
+  // Protected methods
+
+  void MappedTube::map_file(const string& binary_file_name)
+  {
+    const char *data = nullptr;
+    size_t size = 0;
+
+    #ifndef _WIN32
+
+      int fd = open(binary_file_name.c_str(), O_RDONLY);
+      if(fd < 0)
+        throw Exception(__func__, "unable to open the file " + binary_file_name);
+
+      struct stat file_stat;
+      if(fstat(fd, &file_stat) < 0 || file_stat.st_size < (off_t)ARRAYS_OFFSET)
+      {
+        close(fd);
+        throw Exception(__func__, "wrong file format");
+      }
+
+      size = file_stat.st_size;
+      void *mapped_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd); // the mapping remains valid
+
+      if(mapped_data == MAP_FAILED)
+        throw Exception(__func__, "unable to map the file " + binary_file_name);
+
+      m_mapped_data = mapped_data;
+      m_mapped_size = size;
+      data = static_cast<const char*>(mapped_data);
+
+    #else // no mmap: the file is read at once, into 8-byte aligned values
+
+      ifstream bin_file(binary_file_name, ios::in | ios::binary | ios::ate);
+      if(!bin_file.is_open())
+        throw Exception(__func__, "unable to open the file " + binary_file_name);
+
+      size = bin_file.tellg();
+      if(size < ARRAYS_OFFSET)
+        throw Exception(__func__, "wrong file format");
+
+      m_v_buffer.resize((size + sizeof(double) - 1) / sizeof(double));
+      bin_file.seekg(0, ios::beg);
+      bin_file.read((char*)m_v_buffer.data(), size);
+      data = (const char*)m_v_buffer.data();
+
+    #endif // _WIN32
+
+    short int version_number;
+    memcpy(&version_number, data, sizeof(short int));
+    if(version_number != 3)
+      throw Exception(__func__, "the file is not serialized with the version 3");
+
+    TubeBinaryHeader header;
+    memcpy(&header, data + 8, sizeof(TubeBinaryHeader));
+    if(strncmp(header.magic, "codactub", 8) != 0)
+      throw Exception(__func__, "wrong file format");
+
+    // Arrays: t[n+1], codomains[2n], gates[2(n+1)]
+    if(header.nb_slices < 1 || header.nb_slices > numeric_limits<int>::max()
+      || size < ARRAYS_OFFSET + (5 * header.nb_slices + 3) * sizeof(double))
+      throw Exception(__func__, "wrong slices number");
+
+    m_nb_slices = header.nb_slices;
+    m_t = reinterpret_cast<const double*>(data + ARRAYS_OFFSET);
+    m_codomains = m_t + m_nb_slices + 1;
+    m_gates = m_codomains + 2 * m_nb_slices;
+  }
+
+  void MappedTube::unmap_file()
+  {
+    #ifndef _WIN32
+    if(m_mapped_data)
+      munmap(m_mapped_data, m_mapped_size);
+    #endif // _WIN32
+
+    m_mapped_data = nullptr;
+    m_mapped_size = 0;
+  }
+}
@@ -0,0 +1,169 @@
+/**
+ *  \file
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_MAPPEDTUBE_H__
+#define __CODAC_MAPPEDTUBE_H__
+
+#include <string>
+#include <vector>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  class Tube;
+
+  /**
+   * \class MappedTube
+   * \brief Read-only view of a Tube serialized in a binary file (version 3)
+   *
+   * The file is memory-mapped: the values are read from the arrays
+   * of the file when accessed, without building the slices of a Tube.
+   * A Tube object can be built afterwards on a part of the tdomain only,
+   * see load_tube().
+   *
+   * \note On systems without mmap (Windows), the arrays of values are read
+   *       at once into memory.
+   */
+  class MappedTube
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a view of the Tube serialized in a binary file
+       *
+       * \param binary_file_name path to the binary file, written with the version 3 (see MAPPED_SERIALIZATION_VERSION)
+       */
+      explicit MappedTube(const std::string& binary_file_name);
+
+      /**
+       * \brief MappedTube destructor, unmaps the file
+       */
+      ~MappedTube();
+
+      MappedTube(const MappedTube&) = delete;
+      MappedTube& operator=(const MappedTube&) = delete;
+
+      /**
+       * \brief Returns the number of slices of the serialized tube
+       *
+       * \return the number of slices
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal definition domain of the serialized tube
+       *
+       * \return an Interval object \f$[t_0,t_f]\f$
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Returns the index of the slice defined for \f$t\f$
+       *
+       * \param t the temporal key, belonging to the tdomain
+       * \return an integer
+       */
+      int time_to_index(double t) const;
+
+      /**
+       * \brief Returns the tdomain of the ith slice
+       *
+       * \param slice_id the index of the slice
+       * \return an Interval object
+       */
+      const Interval slice_tdomain(int slice_id) const;
+
+      /**
+       * \brief Returns the codomain of the ith slice
+       *
+       * \param slice_id the index of the slice
+       * \return an Interval object
+       */
+      const Interval slice_codomain(int slice_id) const;
+
+      /**
+       * \brief Returns the ith gate, at the lower bound of the ith slice
+       *
+       * \param gate_id the index of the gate, from 0 to nb_slices()
+       * \return an Interval object
+       */
+      const Interval gate(int gate_id) const;
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the envelope of the serialized tube
+       *
+       * \note The codomain is computed in linear time
+       *
+       * \return the hull of the slices codomains
+       */
+      const Interval codomain() const;
+
+      /**
+       * \brief Returns the evaluation of the serialized tube at \f$t\f$
+       *
+       * \param t the temporal key
+       * \return the value of the tube at \f$t\f$, all reals outside the tdomain
+       */
+      const Interval operator()(double t) const;
+
+      /**
+       * \brief Returns the interval evaluation of the serialized tube over \f$[t]\f$
+       *
+       * \param t the subset of the tdomain
+       * \return the hull of the slices codomains over \f$[t]\f$
+       */
+      const Interval operator()(const Interval& t) const;
+
+      /**
+       * \brief Builds a Tube object from the slices defined over a part of the tdomain
+       *
+       * Only the slices intersecting \f$[t]\f$ are created.
+       *
+       * \param tube the Tube object to be created
+       * \param t the part of the tdomain to be loaded, the whole tdomain by default
+       */
+      void load_tube(Tube *&tube, const Interval& t = Interval::ALL_REALS) const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Maps the file into memory and checks its structure
+       *
+       * \param binary_file_name path to the binary file
+       */
+      void map_file(const std::string& binary_file_name);
+
+      /**
+       * \brief Releases the mapped file, if any
+       */
+      void unmap_file();
+
+      int m_nb_slices = 0; //!< number of slices
+      const double *m_t = nullptr; //!< nb_slices+1 bounds of the slices tdomains
+      const double *m_codomains = nullptr; //!< 2*nb_slices bounds of the codomains
+      const double *m_gates = nullptr; //!< 2*(nb_slices+1) bounds of the gates
+
+      void *m_mapped_data = nullptr; //!< address of the mapped file
+      size_t m_mapped_size = 0; //!< size of the mapped file
+      std::vector<double> m_v_buffer; //!< values read into memory, if the file cannot be mapped
+  };
+}
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ *  TubeReader class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include "codac_TubeReader.h"
+#include "codac_serialize_tubes.h"
+#include "codac_serialize_intervals.h"
+#include "codac_Exception.h"
+#include "codac_Tube.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Upper bound of the size of a payload, for detecting corrupted records
+  static const uint32_t MAX_RECORD_SIZE = 1u << 30;
+
+  // Definition
+
+  TubeReader::TubeReader(const string& file_name)
+    : m_file(file_name.c_str(), ios::in | ios::binary), m_end_offset(sizeof(TubeLogHeader))
+  {
+    if(!m_file.is_open())
+      throw Exception(__func__, "unable to open the file " + file_name);
+
+    TubeLogHeader header;
+    m_file.read((char*)&header, sizeof(TubeLogHeader));
+    if(!m_file || strncmp(header.magic, "codaclog", 8) != 0)
+      throw Exception(__func__, "wrong file format");
+
+    // Records listed by the chain of index records, from the last one
+    vector<vector<RecordEntry> > v_indexes;
+    for(int64_t offset = header.last_index_offset ; offset >= 0 ; )
+    {
+      uint32_t type;
+      vector<char> payload;
+      if(!read_record(m_file, offset, type, payload) || type != INDEX
+        || payload.size() < sizeof(int64_t) || (payload.size() - sizeof(int64_t)) % sizeof(RecordEntry) != 0)
+        throw Exception(__func__, "corrupted index");
+
+      if(offset == header.last_index_offset)
+        m_end_offset = offset + record_size(payload.size());
+
+      v_indexes.push_back(vector<RecordEntry>((payload.size() - sizeof(int64_t)) / sizeof(RecordEntry)));
+      memcpy(v_indexes.back().data(), payload.data() + sizeof(int64_t), payload.size() - sizeof(int64_t));
+
+      int64_t prev_offset;
+      memcpy(&prev_offset, payload.data(), sizeof(int64_t));
+      if(prev_offset >= offset)
+        throw Exception(__func__, "corrupted index");
+      offset = prev_offset;
+    }
+
+    for(auto it = v_indexes.rbegin() ; it != v_indexes.rend() ; it++)
+      for(const auto& record : *it)
+      {
+        m_v_records.push_back(record);
+        m_nb_slices += record.nb_slices;
+      }
+
+    m_last_index_offset = header.last_index_offset;
+
+    // Records written after the last index
+    update();
+  }
+
+  int64_t TubeReader::nb_slices() const
+  {
+    return m_nb_slices;
+  }
+
+  const Interval TubeReader::tdomain() const
+  {
+    if(m_v_records.empty())
+      return Interval::EMPTY_SET;
+    return Interval(m_v_records.front().t_lb, m_v_records.back().t_ub);
+  }
+
+  // Reading slices
+
+  bool TubeReader::update()
+  {
+    bool new_slices = false;
+    uint32_t type;
+    vector<char> payload;
+
+    while(read_record(m_file, m_end_offset, type, payload))
+    {
+      if(type == SLICES)
+      {
+        size_t slice_bytes = SLICE_SIZE * sizeof(double);
+        if(payload.empty() || payload.size() % slice_bytes != 0)
+          break;
+
+        RecordEntry record;
+        record.offset = m_end_offset;
+        record.nb_slices = payload.size() / slice_bytes;
+        memcpy(&record.t_lb, payload.data(), sizeof(double));
+        memcpy(&record.t_ub, payload.data() + payload.size() - slice_bytes + sizeof(double), sizeof(double));
+
+        m_v_records.push_back(record);
+        m_nb_slices += record.nb_slices;
+        new_slices = true;
+      }
+
+      else if(type == INDEX)
+        m_last_index_offset = m_end_offset;
+
+      else
+        break;
+
+      m_end_offset += record_size(payload.size());
+    }
+
+    m_file.clear(); // the file may be completed later
+    return new_slices;
+  }
+
+  void TubeReader::load_tube(Tube *&tube, const Interval& t) const
+  {
+    Interval t_ = t & tdomain();
+    if(t_.is_empty())
+      throw Exception(__func__, "no slice available over [t]");
+
+    // Slices of the records intersecting [t]
+    vector<double> v_slices;
+    for(const auto& record : m_v_records)
+      if(record.t_ub >= t_.lb() && record.t_lb <= t_.ub())
+      {
+        uint32_t type;
+        vector<char> payload;
+        if(!read_record(m_file, record.offset, type, payload) || type != SLICES)
+          throw Exception(__func__, "corrupted file");
+
+        size_t n = v_slices.size();
+        v_slices.resize(n + payload.size() / sizeof(double));
+        memcpy(&v_slices[n], payload.data(), payload.size());
+      }
+
+    m_file.clear();
+
+    // A Tube object is indexed by int values
+    if(v_slices.size() / SLICE_SIZE > (size_t)numeric_limits<int>::max())
+      throw Exception(__func__, "too many slices over [t] for a Tube object");
+
+    // Same slices as for MappedTube::load_tube()
+    int nb_loaded_slices = v_slices.size() / SLICE_SIZE;
+    int first = 0, last = 0;
+    for(int k = 0 ; k < nb_loaded_slices ; k++)
+    {
+      if(v_slices[k*SLICE_SIZE] <= t_.lb()) first = k;
+      if(v_slices[k*SLICE_SIZE] <= t_.ub()) last = k;
+    }
+    if(last > first && v_slices[last*SLICE_SIZE] == t_.ub())
+      last--;
+
+    // Arrays of the version 3 of the serialization, gates being shared by successive slices
+    int n = last - first + 1;
+    vector<double> v_t(n+1), v_codomains(2*n), v_gates(2*(n+1));
+    Interval input_gate, output_gate;
+
+    for(int k = 0 ; k < n ; k++)
+    {
+      const double *s = &v_slices[(first+k)*SLICE_SIZE];
+      v_t[k] = s[0];
+
+      deserialize_Interval(s+2, input_gate);
+      if(k > 0)
+        input_gate &= output_gate;
+      serialize_Interval(&v_gates[2*k], input_gate);
+
+      v_codomains[2*k] = s[4];
+      v_codomains[2*k+1] = s[5];
+      deserialize_Interval(s+6, output_gate);
+    }
+
+    v_t[n] = v_slices[last*SLICE_SIZE + 1];
+    serialize_Interval(&v_gates[2*n], output_gate);
+
+    deserialize_Tube(v_t.data(), v_codomains.data(), v_gates.data(), n, tube);
+  }
+
+  // Protected methods
+
+  uint64_t TubeReader::checksum(const char *data, size_t nb_bytes, uint64_t hash)
+  {
+    for(size_t i = 0 ; i < nb_bytes ; i++)
+    {
+      hash ^= (uint8_t)data[i];
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  bool TubeReader::read_record(istream& file, int64_t offset, uint32_t& type, vector<char>& payload)
+  {
+    file.clear();
+    file.seekg(offset);
+
+    uint32_t header[2];
+    file.read((char*)header, sizeof(header));
+    if(!file)
+      return false;
+
+    if(header[1] > MAX_RECORD_SIZE) // corrupted size
+      return false;
+
+    type = header[0];
+    payload.resize(header[1]);
+    file.read(payload.data(), payload.size());
+
+    uint64_t sum;
+    file.read((char*)&sum, sizeof(uint64_t));
+    if(!file)
+      return false;
+
+    return sum == checksum(payload.data(), payload.size(), checksum((const char*)header, sizeof(header)));
+  }
+
+  int64_t TubeReader::record_size(size_t nb_bytes)
+  {
+    return 2 * sizeof(uint32_t) + nb_bytes + sizeof(uint64_t);
+  }
+}
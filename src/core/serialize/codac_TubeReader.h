@@ -0,0 +1,172 @@
+/**
+ *  \file
+ *  TubeReader class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBEREADER_H__
+#define __CODAC_TUBEREADER_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  class Tube;
+
+  /**
+   * \brief Header of a tube log file, written by a TubeWriter
+   */
+  struct TubeLogHeader
+  {
+    char magic[8]; //!< identifier of the format: "codaclog"
+    std::int64_t last_index_offset; //!< position of the last index record in the file, -1 if none
+  };
+
+  /**
+   * \class TubeReader
+   * \brief Reads the slices of a tube log file, possibly while it is written by a TubeWriter
+   *
+   * Tube log binary structure: <br>
+   *   [TubeLogHeader] <br>
+   *   [record_1] <br>
+   *   [record_2] <br>
+   *   ...
+   *
+   * Record binary structure: <br>
+   *   [uint32_type] // slices or index <br>
+   *   [uint32_nb_bytes] <br>
+   *   [payload] <br>
+   *   [uint64_checksum] // of the type, size and payload
+   *
+   * The payload of a slices record is made of 8 doubles per slice:
+   * bounds of the tdomain, input gate, codomain and output gate
+   * (empty intervals are represented by NaN bounds). The payload of an index record
+   * is the position of the previous index record, followed by the tdomain,
+   * position and number of slices of each record written since the previous index.
+   *
+   * Records that are incomplete or corrupted (for instance after a crash of the writer)
+   * are ignored, as well as the following ones.
+   */
+  class TubeReader
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Opens a tube log file and reads its available slices
+       *
+       * \param file_name path to the log file
+       */
+      explicit TubeReader(const std::string& file_name);
+
+      /**
+       * \brief Returns the number of slices available in the file
+       *
+       * \return the number of slices
+       */
+      std::int64_t nb_slices() const;
+
+      /**
+       * \brief Returns the tdomain covered by the available slices
+       *
+       * \return an Interval object, empty if no slice is available
+       */
+      const Interval tdomain() const;
+
+      /// @}
+      /// \name Reading slices
+      /// @{
+
+      /**
+       * \brief Reads the records appended to the file since the last update
+       *
+       * This allows to tail a file being written.
+       *
+       * \return true if new slices are available
+       */
+      bool update();
+
+      /**
+       * \brief Builds a Tube object from the available slices over a part of the tdomain
+       *
+       * \param tube the Tube object to be created
+       * \param t the part of the tdomain to be loaded, the whole tdomain by default
+       */
+      void load_tube(Tube *&tube, const Interval& t = Interval::ALL_REALS) const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Types of records of a tube log file
+       */
+      enum RecordType : std::uint32_t { SLICES = 1, INDEX = 2 };
+
+      /**
+       * \brief Location of a slices record in the file
+       */
+      struct RecordEntry
+      {
+        double t_lb; //!< lower bound of the tdomain of the record
+        double t_ub; //!< upper bound of the tdomain of the record
+        std::int64_t offset; //!< position of the record in the file
+        std::int64_t nb_slices; //!< number of slices of the record
+      };
+
+      /**
+       * \brief Number of doubles per slice in a slices record
+       */
+      static constexpr int SLICE_SIZE = 8;
+
+      /**
+       * \brief Computes the checksum of a sequence of bytes (FNV-1a)
+       *
+       * \param data the bytes
+       * \param nb_bytes the number of bytes
+       * \param hash the checksum of the previous bytes, if any
+       * \return the checksum
+       */
+      static std::uint64_t checksum(const char *data, size_t nb_bytes, std::uint64_t hash = 14695981039346656037ULL);
+
+      /**
+       * \brief Reads a record of a tube log file
+       *
+       * \param file the log file
+       * \param offset the position of the record
+       * \param type the type of the record
+       * \param payload the payload of the record
+       * \return false if the record is incomplete or corrupted
+       */
+      static bool read_record(std::istream& file, std::int64_t offset, std::uint32_t& type, std::vector<char>& payload);
+
+      /**
+       * \brief Returns the size of a record in the file
+       *
+       * \param nb_bytes the size of the payload
+       * \return the size of the record
+       */
+      static std::int64_t record_size(size_t nb_bytes);
+
+      mutable std::ifstream m_file; //!< log file
+      std::vector<RecordEntry> m_v_records; //!< slices records available in the file
+      std::int64_t m_end_offset; //!< position after the last valid record
+      std::int64_t m_last_index_offset = -1; //!< position of the last index record
+      std::int64_t m_nb_slices = 0; //!< number of slices available in the file
+
+      friend class TubeWriter;
+  };
+}
+
+#endif
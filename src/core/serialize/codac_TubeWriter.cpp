@@ -0,0 +1,235 @@
+/**
+ *  TubeWriter class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cstring>
+#include <cstddef>
+#include <filesystem>
+#include <fcntl.h>
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+#include "codac_TubeWriter.h"
+#include "codac_serialize_intervals.h"
+#include "codac_Exception.h"
+#include "codac_Tube.h"
+#include "codac_Slice.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Definition
+
+  TubeWriter::TubeWriter(const string& file_name, bool recover, int nb_slices_per_record, int nb_records_per_checkpoint)
+    : m_end_offset(sizeof(TubeLogHeader)),
+      m_nb_slices_per_record(nb_slices_per_record), m_nb_records_per_checkpoint(nb_records_per_checkpoint)
+  {
+    assert(nb_slices_per_record > 0 && nb_records_per_checkpoint > 0);
+
+    if(recover && ifstream(file_name.c_str()).good())
+    {
+      // Valid records are kept, an incomplete one is removed
+      {
+        TubeReader reader(file_name);
+        m_end_offset = reader.m_end_offset;
+        m_last_index_offset = reader.m_last_index_offset;
+        m_nb_slices = reader.nb_slices();
+        m_tdomain = reader.tdomain();
+
+        for(const auto& record : reader.m_v_records)
+          if(record.offset > m_last_index_offset)
+            m_v_unindexed_records.push_back(record);
+      }
+
+      std::filesystem::resize_file(file_name, m_end_offset);
+    }
+
+    else
+    {
+      ofstream file(file_name.c_str(), ios::out | ios::binary | ios::trunc);
+      if(!file.is_open())
+        throw Exception(__func__, "unable to create the file " + file_name);
+
+      TubeLogHeader header = { { 'c','o','d','a','c','l','o','g' }, -1 };
+      file.write((const char*)&header, sizeof(TubeLogHeader));
+    }
+
+    m_file.open(file_name.c_str(), ios::in | ios::out | ios::binary);
+    if(!m_file.is_open())
+      throw Exception(__func__, "unable to open the file " + file_name);
+
+    // Syncing any descriptor of the file commits the bytes written through m_file
+    #if defined(_WIN32)
+      m_fd = _open(file_name.c_str(), _O_RDWR | _O_BINARY);
+    #else
+      m_fd = ::open(file_name.c_str(), O_RDWR);
+    #endif
+    if(m_fd < 0)
+      throw Exception(__func__, "unable to open the file " + file_name);
+
+    m_v_buffer.reserve(m_nb_slices_per_record * TubeReader::SLICE_SIZE);
+  }
+
+  TubeWriter::~TubeWriter()
+  {
+    try
+    {
+      checkpoint();
+    }
+
+    catch(...) // no exception from a destructor: the written records remain valid
+    {
+
+    }
+
+    #if defined(_WIN32)
+      _close(m_fd);
+    #else
+      ::close(m_fd);
+    #endif
+  }
+
+  int64_t TubeWriter::nb_slices() const
+  {
+    return m_nb_slices;
+  }
+
+  const Interval TubeWriter::tdomain() const
+  {
+    return m_tdomain;
+  }
+
+  // Writing slices
+
+  void TubeWriter::write(const Slice& s)
+  {
+    if(m_nb_slices > 0 && s.tdomain().lb() != m_tdomain.ub())
+      throw Exception(__func__, "slices must be written in chronological order, without gap");
+
+    double values[TubeReader::SLICE_SIZE] = { s.tdomain().lb(), s.tdomain().ub() };
+    serialize_Interval(&values[2], s.input_gate());
+    serialize_Interval(&values[4], s.codomain());
+    serialize_Interval(&values[6], s.output_gate());
+    m_v_buffer.insert(m_v_buffer.end(), values, values + TubeReader::SLICE_SIZE);
+
+    m_tdomain |= s.tdomain();
+    m_nb_slices++;
+
+    if((int)m_v_buffer.size() >= m_nb_slices_per_record * TubeReader::SLICE_SIZE)
+      flush();
+  }
+
+  int TubeWriter::write(const Tube& x, double t)
+  {
+    const Slice *s = x.first_slice();
+
+    if(m_nb_slices > 0)
+    {
+      if(!x.tdomain().contains(m_tdomain.ub()))
+        throw Exception(__func__, "the tube does not follow the written slices");
+
+      if(m_tdomain.ub() == x.tdomain().ub())
+        return 0;
+
+      s = x.slice(m_tdomain.ub());
+      if(s->tdomain().lb() != m_tdomain.ub())
+        throw Exception(__func__, "the slicing of the tube does not match the written slices");
+    }
+
+    int n = 0;
+    for( ; s && s->tdomain().ub() <= t ; s = s->next_slice(), n++)
+      write(*s);
+    return n;
+  }
+
+  void TubeWriter::flush()
+  {
+    if(m_v_buffer.empty())
+      return;
+
+    TubeReader::RecordEntry record;
+    record.t_lb = m_v_buffer.front();
+    record.t_ub = m_v_buffer[m_v_buffer.size() - TubeReader::SLICE_SIZE + 1];
+    record.offset = m_end_offset;
+    record.nb_slices = m_v_buffer.size() / TubeReader::SLICE_SIZE;
+
+    vector<char> payload(m_v_buffer.size() * sizeof(double));
+    memcpy(payload.data(), m_v_buffer.data(), payload.size());
+    write_record(TubeReader::SLICES, payload);
+
+    m_v_buffer.clear();
+    m_v_unindexed_records.push_back(record);
+
+    if((int)m_v_unindexed_records.size() >= m_nb_records_per_checkpoint)
+      checkpoint();
+  }
+
+  void TubeWriter::checkpoint()
+  {
+    flush();
+
+    if(m_v_unindexed_records.empty())
+      return;
+
+    vector<char> payload(sizeof(int64_t) + m_v_unindexed_records.size() * sizeof(TubeReader::RecordEntry));
+    memcpy(payload.data(), &m_last_index_offset, sizeof(int64_t));
+    memcpy(payload.data() + sizeof(int64_t), m_v_unindexed_records.data(),
+      m_v_unindexed_records.size() * sizeof(TubeReader::RecordEntry));
+
+    int64_t index_offset = m_end_offset;
+    write_record(TubeReader::INDEX, payload);
+
+    // The header is updated once the index is on the storage device
+    // (synced by write_record), so that it never points to a missing record
+    m_file.seekp(offsetof(TubeLogHeader, last_index_offset));
+    m_file.write((const char*)&index_offset, sizeof(int64_t));
+    sync();
+
+    m_last_index_offset = index_offset;
+    m_v_unindexed_records.clear();
+  }
+
+  // Protected methods
+
+  void TubeWriter::write_record(uint32_t type, const vector<char>& payload)
+  {
+    uint32_t header[2] = { type, (uint32_t)payload.size() };
+    uint64_t sum = TubeReader::checksum(payload.data(), payload.size(),
+      TubeReader::checksum((const char*)header, sizeof(header)));
+
+    m_file.seekp(m_end_offset);
+    m_file.write((const char*)header, sizeof(header));
+    m_file.write(payload.data(), payload.size());
+    m_file.write((const char*)&sum, sizeof(uint64_t));
+    sync();
+
+    m_end_offset += TubeReader::record_size(payload.size());
+  }
+
+  void TubeWriter::sync()
+  {
+    m_file.flush();
+    if(!m_file)
+      throw Exception(__func__, "unable to write into the file");
+
+    #if defined(_WIN32)
+      bool synced = _commit(m_fd) == 0; // FlushFileBuffers
+    #else
+      bool synced = fsync(m_fd) == 0;
+    #endif
+
+    if(!synced)
+      throw Exception(__func__, "unable to synchronize the file with the storage device");
+  }
+}
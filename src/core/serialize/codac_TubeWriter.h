@@ -0,0 +1,142 @@
+/**
+ *  \file
+ *  TubeWriter class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBEWRITER_H__
+#define __CODAC_TUBEWRITER_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "codac_Interval.h"
+#include "codac_TubeReader.h"
+
+namespace codac
+{
+  class Tube;
+  class Slice;
+
+  /**
+   * \class TubeWriter
+   * \brief Appends slices to a tube log file, during the computation of a tube
+   *
+   * Slices are written in chronological order, as soon as they are final
+   * (for instance once contracted by a ContractorNetwork), so that the whole
+   * tube does not have to be kept in memory for being saved. Slices are grouped
+   * into records; an index of the records is written periodically, so that
+   * a TubeReader does not have to scan the whole file.
+   *
+   * Each record is written with a checksum and synchronized with the storage
+   * device (fsync) before the header is updated: after a crash of the writer
+   * or of the system, the file can be reopened in recovery mode, the last
+   * incomplete record being discarded. See TubeReader for the binary structure of the file.
+   */
+  class TubeWriter
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a tube log file
+       *
+       * \param file_name path to the log file
+       * \param recover if true, slices are appended to the valid records of an existing file
+       * \param nb_slices_per_record optional number of slices grouped in a record
+       * \param nb_records_per_checkpoint optional number of records between two indexes
+       */
+      explicit TubeWriter(const std::string& file_name, bool recover = false,
+        int nb_slices_per_record = 256, int nb_records_per_checkpoint = 64);
+
+      /**
+       * \brief TubeWriter destructor, writes the remaining slices and an index
+       */
+      ~TubeWriter();
+
+      TubeWriter(const TubeWriter&) = delete;
+      TubeWriter& operator=(const TubeWriter&) = delete;
+
+      /**
+       * \brief Returns the number of slices written, possibly not yet flushed
+       *
+       * \return the number of slices
+       */
+      std::int64_t nb_slices() const;
+
+      /**
+       * \brief Returns the tdomain covered by the written slices
+       *
+       * \return an Interval object, empty if no slice has been written
+       */
+      const Interval tdomain() const;
+
+      /// @}
+      /// \name Writing slices
+      /// @{
+
+      /**
+       * \brief Appends a slice
+       *
+       * \param s the slice, starting at the end of the previous one
+       */
+      void write(const Slice& s);
+
+      /**
+       * \brief Appends the slices of a tube that have not been written yet
+       *
+       * \param x the tube, its slicing being consistent with the written slices
+       * \param t optional time up to which the slices are final
+       * \return the number of appended slices
+       */
+      int write(const Tube& x, double t = POS_INFINITY);
+
+      /**
+       * \brief Writes the pending slices into a new record, synchronized with the storage device
+       */
+      void flush();
+
+      /**
+       * \brief Writes the pending slices and an index of the last records
+       */
+      void checkpoint();
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Appends a record to the file and synchronizes it with the storage device
+       *
+       * \param type the type of the record
+       * \param payload the payload of the record
+       */
+      void write_record(std::uint32_t type, const std::vector<char>& payload);
+
+      /**
+       * \brief Flushes the written bytes and waits for them to reach the storage device
+       */
+      void sync();
+
+      std::fstream m_file; //!< log file
+      int m_fd = -1; //!< descriptor of the log file, for synchronizing it with the storage device
+      std::vector<double> m_v_buffer; //!< pending slices, not yet written
+      std::vector<TubeReader::RecordEntry> m_v_unindexed_records; //!< records written since the last index
+      std::int64_t m_end_offset; //!< position after the last record
+      std::int64_t m_last_index_offset = -1; //!< position of the last index record
+      std::int64_t m_nb_slices = 0; //!< number of written slices
+      Interval m_tdomain = Interval::EMPTY_SET; //!< tdomain of the written slices
+      const int m_nb_slices_per_record; //!< number of slices grouped in a record
+      const int m_nb_records_per_checkpoint; //!< number of records between two indexes
+  };
+}
+
+#endif
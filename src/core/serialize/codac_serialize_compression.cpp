@@ -0,0 +1,193 @@
+/**
+ *  Serialization tools (compressed blocks of values)
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include "codac_serialize_compression.h"
+#include "codac_Exception.h"
+
+using namespace std;
+
+namespace codac
+{
+  streamoff remaining_file_size(ifstream& bin_file)
+  {
+    streamoff pos = bin_file.tellg();
+    bin_file.seekg(0, ios::end);
+    streamoff end = bin_file.tellg();
+    bin_file.seekg(pos, ios::beg);
+
+    if(pos < 0 || end < 0)
+      throw Exception(__func__, "unable to get the position in the file");
+
+    return end - pos;
+  }
+
+  static uint64_t double_to_bits(double x)
+  {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(double));
+    return bits;
+  }
+
+  static double bits_to_double(uint64_t bits)
+  {
+    double x;
+    memcpy(&x, &bits, sizeof(double));
+    return x;
+  }
+
+  // CompressedBlockWriter
+
+  CompressedBlockWriter::CompressedBlockWriter(ofstream& bin_file, int nb_streams)
+    : m_bin_file(bin_file), m_v_prev_values(nb_streams, 0)
+  {
+    assert(nb_streams >= 0);
+    if(!bin_file.is_open())
+      throw Exception(__func__, "ofstream& bin_file not open");
+  }
+
+  void CompressedBlockWriter::add_time(double t)
+  {
+    uint64_t bits = double_to_bits(t);
+    uint64_t delta = bits - m_prev_time; // modular arithmetic: no loss
+    uint64_t delta_var = delta - m_prev_delta;
+    m_prev_time = bits;
+    m_prev_delta = delta;
+
+    // Small variations of any sign are coded on few bytes (zigzag, then 7 bits per byte)
+    uint64_t z = (delta_var << 1) ^ (0 - (delta_var >> 63));
+    while(z >= 0x80)
+    {
+      m_buffer.push_back((char)((z & 0x7F) | 0x80));
+      z >>= 7;
+    }
+    m_buffer.push_back((char)z);
+  }
+
+  void CompressedBlockWriter::add_value(double x, int stream_id)
+  {
+    assert(stream_id >= 0 && stream_id < (int)m_v_prev_values.size());
+
+    uint64_t bits = double_to_bits(x);
+    uint64_t diff = bits ^ m_v_prev_values[stream_id];
+    m_v_prev_values[stream_id] = bits;
+
+    // Control byte: numbers of leading and trailing zero bytes
+    int lead = 0, trail = 0;
+    while(lead < 8 && ((diff >> (56 - 8*lead)) & 0xFF) == 0)
+      lead++;
+    if(lead < 8)
+      while(((diff >> (8*trail)) & 0xFF) == 0)
+        trail++;
+
+    m_buffer.push_back((char)((lead << 4) | trail));
+    for(int b = 7 - lead ; b >= trail ; b--)
+      m_buffer.push_back((char)((diff >> (8*b)) & 0xFF));
+  }
+
+  void CompressedBlockWriter::flush()
+  {
+    if(m_buffer.empty())
+      return;
+
+    uint32_t nb_bytes = m_buffer.size();
+    m_bin_file.write((const char*)&nb_bytes, sizeof(uint32_t));
+    m_bin_file.write(m_buffer.data(), m_buffer.size());
+
+    m_buffer.clear();
+    m_prev_time = 0;
+    m_prev_delta = 0;
+    fill(m_v_prev_values.begin(), m_v_prev_values.end(), 0);
+  }
+
+  // CompressedBlockReader
+
+  CompressedBlockReader::CompressedBlockReader(ifstream& bin_file, int nb_streams)
+    : m_bin_file(bin_file), m_v_prev_values(nb_streams, 0)
+  {
+    assert(nb_streams >= 0);
+    if(!bin_file.is_open())
+      throw Exception(__func__, "ifstream& bin_file not open");
+  }
+
+  void CompressedBlockReader::next_block()
+  {
+    end_block();
+
+    uint32_t nb_bytes = 0;
+    m_bin_file.read((char*)&nb_bytes, sizeof(uint32_t));
+
+    if(!m_bin_file || remaining_file_size(m_bin_file) < (streamoff)nb_bytes)
+      throw Exception(__func__, "unexpected end of file");
+
+    m_buffer.resize(nb_bytes);
+    m_bin_file.read(m_buffer.data(), nb_bytes);
+
+    if(!m_bin_file)
+      throw Exception(__func__, "unexpected end of file");
+
+    m_pos = 0;
+    m_prev_time = 0;
+    m_prev_delta = 0;
+    fill(m_v_prev_values.begin(), m_v_prev_values.end(), 0);
+  }
+
+  void CompressedBlockReader::end_block() const
+  {
+    if(m_pos != m_buffer.size())
+      throw Exception(__func__, "corrupted block of values");
+  }
+
+  double CompressedBlockReader::next_time()
+  {
+    uint64_t z = 0;
+    for(int shift = 0 ; ; shift += 7)
+    {
+      if(shift > 63)
+        throw Exception(__func__, "corrupted block of values");
+
+      uint8_t byte = next_byte();
+      z |= (uint64_t)(byte & 0x7F) << shift;
+      if(!(byte & 0x80))
+        break;
+    }
+
+    uint64_t delta_var = (z >> 1) ^ (0 - (z & 1));
+    m_prev_delta += delta_var;
+    m_prev_time += m_prev_delta;
+    return bits_to_double(m_prev_time);
+  }
+
+  double CompressedBlockReader::next_value(int stream_id)
+  {
+    assert(stream_id >= 0 && stream_id < (int)m_v_prev_values.size());
+
+    uint8_t control = next_byte();
+    int lead = control >> 4, trail = control & 0x0F;
+    if(lead + trail > 8 || (lead == 8 && trail != 0))
+      throw Exception(__func__, "corrupted block of values");
+
+    uint64_t diff = 0;
+    for(int b = 7 - lead ; b >= trail ; b--)
+      diff |= (uint64_t)next_byte() << (8*b);
+
+    m_v_prev_values[stream_id] ^= diff;
+    return bits_to_double(m_v_prev_values[stream_id]);
+  }
+
+  uint8_t CompressedBlockReader::next_byte()
+  {
+    if(m_pos >= m_buffer.size())
+      throw Exception(__func__, "corrupted block of values");
+    return (uint8_t)m_buffer[m_pos++];
+  }
+}
@@ -0,0 +1,157 @@
+/**
+ *  \file
+ *  Serialization tools (compressed blocks of values)
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_SERIALIZ_COMPRESSION_H__
+#define __CODAC_SERIALIZ_COMPRESSION_H__
+
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+namespace codac
+{
+  /**
+   * \brief Number of slices (or samples) per block of a compressed serialization
+   */
+  constexpr int COMPRESSED_BLOCK_SIZE = 1024;
+
+  /**
+   * \brief Returns the number of bytes from the current position to the end of a file
+   *
+   * \note Used to check the numbers of values read from a file before allocating them
+   *
+   * \param bin_file binary file (ifstream object)
+   * \return the number of remaining bytes
+   */
+  std::streamoff remaining_file_size(std::ifstream& bin_file);
+
+  /**
+   * \class CompressedBlockWriter
+   * \brief Writes sequences of doubles by blocks of compressed bytes
+   *
+   * Times are expected to be monotone: they are coded by the variation of
+   * the difference between two successive times (exact integer arithmetic
+   * on the binary representation), which is small for regular samplings.
+   * The other values are coded by the XOR with the previous value of
+   * the same stream, only the non-zero bytes of the result being written.
+   *
+   * Blocks are independent: the coding restarts at each block.
+   *
+   * Block binary structure: <br>
+   *   [uint32_nb_bytes] <br>
+   *   [bytes] // coded values
+   */
+  class CompressedBlockWriter
+  {
+    public:
+
+      /**
+       * \brief Creates a writer of compressed blocks
+       *
+       * \param bin_file binary file (ofstream object)
+       * \param nb_streams number of sequences of values, coded separately
+       */
+      CompressedBlockWriter(std::ofstream& bin_file, int nb_streams);
+
+      /**
+       * \brief Appends a time to the current block
+       *
+       * \param t the time, greater than the previous one
+       */
+      void add_time(double t);
+
+      /**
+       * \brief Appends a value of a stream to the current block
+       *
+       * \param x the value, possibly unbounded or NaN
+       * \param stream_id the index of the stream
+       */
+      void add_value(double x, int stream_id);
+
+      /**
+       * \brief Writes the current block into the file, and starts a new one
+       */
+      void flush();
+
+    protected:
+
+      std::ofstream& m_bin_file; //!< binary file
+      std::vector<char> m_buffer; //!< bytes of the current block
+      std::uint64_t m_prev_time = 0; //!< binary representation of the previous time
+      std::uint64_t m_prev_delta = 0; //!< previous difference between two times
+      std::vector<std::uint64_t> m_v_prev_values; //!< binary representation of the previous value of each stream
+  };
+
+  /**
+   * \class CompressedBlockReader
+   * \brief Reads sequences of doubles written by a CompressedBlockWriter
+   *
+   * Values are read in the same order as they have been written,
+   * one block being loaded at once.
+   */
+  class CompressedBlockReader
+  {
+    public:
+
+      /**
+       * \brief Creates a reader of compressed blocks
+       *
+       * \param bin_file binary file (ifstream object)
+       * \param nb_streams number of sequences of values, coded separately
+       */
+      CompressedBlockReader(std::ifstream& bin_file, int nb_streams);
+
+      /**
+       * \brief Loads the next block from the file
+       *
+       * \note An exception is thrown if the current block has not been entirely read
+       */
+      void next_block();
+
+      /**
+       * \brief Checks that the current block has been entirely read
+       */
+      void end_block() const;
+
+      /**
+       * \brief Reads the next time of the current block
+       *
+       * \return the time
+       */
+      double next_time();
+
+      /**
+       * \brief Reads the next value of a stream in the current block
+       *
+       * \param stream_id the index of the stream
+       * \return the value
+       */
+      double next_value(int stream_id);
+
+    protected:
+
+      /**
+       * \brief Reads the next byte of the current block
+       *
+       * \return the byte
+       */
+      std::uint8_t next_byte();
+
+      std::ifstream& m_bin_file; //!< binary file
+      std::vector<char> m_buffer; //!< bytes of the current block
+      size_t m_pos = 0; //!< position of the next byte to be read in the block
+      std::uint64_t m_prev_time = 0; //!< binary representation of the previous time
+      std::uint64_t m_prev_delta = 0; //!< previous difference between two times
+      std::vector<std::uint64_t> m_v_prev_values; //!< binary representation of the previous value of each stream
+  };
+}
+
+#endif
@@ -8,6 +8,8 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
+#include <limits>
 #include "codac_serialize_intervals.h"
 #include "codac_Exception.h"
 
@@ -90,6 +92,26 @@ namespace codac
     }
   }
 
+  void serialize_Interval(double *bounds, const Interval& intv)
+  {
+    if(intv.is_empty())
+      bounds[0] = bounds[1] = numeric_limits<double>::quiet_NaN();
+
+    else
+    {
+      bounds[0] = intv.lb();
+      bounds[1] = intv.ub();
+    }
+  }
+
+  void deserialize_Interval(const double *bounds, Interval& intv)
+  {
+    if(std::isnan(bounds[0]))
+      intv = Interval::EMPTY_SET;
+    else
+      intv = Interval(bounds[0], bounds[1]);
+  }
+
   void serialize_IntervalVector(ofstream& bin_file, const IntervalVector& box)
   {
     if(!bin_file.is_open())
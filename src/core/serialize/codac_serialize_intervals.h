@@ -49,6 +49,28 @@ namespace codac
    */
   void deserialize_Interval(std::ifstream& bin_file, Interval& intv);
 
+  /**
+   * \brief Writes the bounds of an Interval object into an array
+   *
+   * Unlike the binary structure of serialize_Interval(), the two bounds
+   * are always written, so that intervals have a fixed size.
+   * An empty set is represented by two NaN values.
+   *
+   * \param bounds array of two doubles
+   * \param intv Interval object to be serialized
+   */
+  void serialize_Interval(double *bounds, const Interval& intv);
+
+  /**
+   * \brief Creates an Interval object from an array of bounds.
+   *
+   * The array has to be written by the serialize_Interval(double*,const Interval&) function.
+   *
+   * \param bounds array of two doubles
+   * \param intv Interval object to be deserialized
+   */
+  void deserialize_Interval(const double *bounds, Interval& intv);
+
   /// @}
   /// \name IntervalVector
   /// @{
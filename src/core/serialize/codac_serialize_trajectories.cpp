@@ -11,12 +11,80 @@
 #include "codac_Vector.h"
 #include "codac_Exception.h"
 #include "codac_serialize_trajectories.h"
+#include "codac_serialize_compression.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  /**
+   * \brief Writes trajectories sharing the same times, with the version 4
+   *
+   * \param v_x pointers to the first values of each trajectory
+   * \param stride distance between two successive values of a trajectory
+   */
+  static void serialize_compressed_Trajectories(ofstream& bin_file, int pts_number, const double *t,
+    const vector<const double*>& v_x, int stride)
+  {
+    short int version_number = 4;
+    bin_file.write((const char*)&version_number, sizeof(short int));
+
+    int dim = v_x.size();
+    if(dim < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    bin_file.write((const char*)&dim, sizeof(int));
+    bin_file.write((const char*)&pts_number, sizeof(int));
+
+    CompressedBlockWriter writer(bin_file, dim);
+    for(int k = 0 ; k < pts_number ; k++)
+    {
+      writer.add_time(t[k]); // times written once
+      for(int i = 0 ; i < dim ; i++)
+        writer.add_value(v_x[i][k*stride], i);
+
+      if((k+1) % COMPRESSED_BLOCK_SIZE == 0 || k == pts_number - 1)
+        writer.flush();
+    }
+  }
+
+  /**
+   * \brief Reads trajectories written with the version 4, once the version number
+   *        and the number of trajectories have been read
+   *
+   * \param v_t times of the points
+   * \param v_x values of the points, stored point after point
+   */
+  static void deserialize_compressed_Trajectories(ifstream& bin_file, int dim, vector<double>& v_t, vector<double>& v_x)
+  {
+    if(dim < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    int pts_number;
+    bin_file.read((char*)&pts_number, sizeof(int));
+
+    // Each point is coded on at least one byte for its time and for each of its values
+    if(!bin_file || pts_number < 0
+      || remaining_file_size(bin_file) < (streamoff)pts_number * (1 + dim))
+      throw Exception(__func__, "wrong points number");
+
+    v_t.resize(pts_number);
+    v_x.resize((size_t)pts_number * dim);
+
+    CompressedBlockReader reader(bin_file, dim);
+    for(int k = 0 ; k < pts_number ; k++)
+    {
+      if(k % COMPRESSED_BLOCK_SIZE == 0)
+        reader.next_block();
+
+      v_t[k] = reader.next_time();
+      for(int i = 0 ; i < dim ; i++)
+        v_x[(size_t)k*dim + i] = reader.next_value(i);
+    }
+    reader.end_block();
+  }
+
   void serialize_Trajectory(ofstream& bin_file, const Trajectory& traj, int version_number)
   {
     if(!bin_file.is_open())
@@ -25,6 +93,13 @@ namespace codac
     if(traj.definition_type() == TrajDefnType::ANALYTIC_FNC)
       throw Exception(__func__, "Fnc serialization not implemented");
 
+    if(version_number == 4)
+    {
+      serialize_compressed_Trajectories(bin_file, traj.sampled_times().size(),
+        traj.sampled_times().data(), { traj.sampled_values().data() }, 1);
+      return;
+    }
+
     // Version number for compliance purposes
     bin_file.write((const char*)&version_number, sizeof(short int));
 
@@ -35,16 +110,16 @@ namespace codac
         break;
 
       case 2:
+      case 3: // same structure for trajectories
       {
         // Points number
-        int pts_number = traj.sampled_map().size();
+        int pts_number = traj.sampled_times().size();
         bin_file.write((const char*)&pts_number, sizeof(int));
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = traj.sampled_map().begin() ; it_map != traj.sampled_map().end() ; it_map++)
+        for(int i = 0 ; i < pts_number ; i++)
         {
-          bin_file.write((const char*)&it_map->first, sizeof(double));
-          bin_file.write((const char*)&it_map->second, sizeof(double));
+          bin_file.write((const char*)&traj.sampled_times()[i], sizeof(double));
+          bin_file.write((const char*)&traj.sampled_values()[i], sizeof(double));
         }
 
         break;
@@ -71,6 +146,7 @@ namespace codac
         break;
 
       case 2:
+      case 3: // same structure for trajectories
       {
         traj = new Trajectory();
 
@@ -89,6 +165,22 @@ namespace codac
         break;
       }
 
+      case 4:
+      {
+        int dim;
+        bin_file.read((char*)&dim, sizeof(int));
+        if(dim != 1)
+          throw Exception(__func__, "trajectory vector to be deserialized by deserialize_TrajectoryVector()");
+
+        vector<double> v_t, v_x;
+        deserialize_compressed_Trajectories(bin_file, 1, v_t, v_x);
+
+        traj = new Trajectory();
+        for(size_t k = 0 ; k < v_t.size() ; k++)
+          traj->set(v_x[k], v_t[k]);
+        break;
+      }
+
       default:
         throw Exception(__func__, "deserialization version number not supported");
     }
@@ -101,6 +193,34 @@ namespace codac
 
     short int size = traj.size();
     bin_file.write((const char*)&size, sizeof(short int));
+
+    if(version_number == 4 && size > 0)
+    {
+      // The times are written once if they are shared by the components
+      if(traj.shared_timebase())
+      {
+        vector<const double*> v_x(size);
+        for(int i = 0 ; i < size ; i++)
+          v_x[i] = traj.sampled_values().data() + i;
+        serialize_compressed_Trajectories(bin_file, traj.sampled_times().size(), traj.sampled_times().data(), v_x, size);
+        return;
+      }
+
+      bool same_times = true;
+      for(int i = 0 ; i < size && same_times ; i++)
+        same_times = traj[i].definition_type() == TrajDefnType::MAP_OF_VALUES
+                  && traj[i].sampled_times() == traj[0].sampled_times();
+
+      if(same_times)
+      {
+        vector<const double*> v_x(size);
+        for(int i = 0 ; i < size ; i++)
+          v_x[i] = traj[i].sampled_values().data();
+        serialize_compressed_Trajectories(bin_file, traj[0].sampled_times().size(), traj[0].sampled_times().data(), v_x, 1);
+        return;
+      }
+    }
+
     for(int i = 0 ; i < size ; i++)
       serialize_Trajectory(bin_file, traj[i], version_number);
   }
@@ -110,10 +230,43 @@ namespace codac
     if(!bin_file.is_open())
       throw Exception(__func__, "ifstream& bin_file not open");
 
-    traj = new TrajectoryVector();
-
     short int size;
     bin_file.read((char*)&size, sizeof(short int));
+
+    if(!bin_file || size < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    traj = new TrajectoryVector();
+
+    // Components sharing the same times, written with the version 4
+    short int version_number;
+    int dim = 0;
+    bin_file.read((char*)&version_number, sizeof(short int));
+    if(version_number == 4)
+      bin_file.read((char*)&dim, sizeof(int));
+
+    if(version_number == 4 && dim == size)
+    {
+      vector<double> v_t, v_x;
+      deserialize_compressed_Trajectories(bin_file, size, v_t, v_x);
+
+      if(!v_t.empty())
+      {
+        // Values already stored point after point, as for a shared time base
+        delete traj;
+        traj = new TrajectoryVector(Eigen::Map<const Eigen::VectorXd>(v_t.data(), v_t.size()),
+                                    Eigen::Map<const Eigen::MatrixXd>(v_x.data(), size, v_t.size()));
+        return;
+      }
+
+      traj->m_n = size;
+      traj->m_v_trajs = new Trajectory[size];
+      return;
+    }
+
+    // Otherwise, components written independently
+    bin_file.seekg(-(streamoff)(sizeof(short int) + (version_number == 4 ? sizeof(int) : 0)), ios::cur);
+
     traj->m_n = size;
     traj->m_v_trajs = new Trajectory[size];
     
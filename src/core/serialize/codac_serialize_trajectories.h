@@ -35,6 +35,13 @@ namespace codac
    *   [double_t_pt3] <br>
    *   ...
    *
+   * Trajectory binary structure, version 4 (compressed blocks, see CompressedBlockWriter): <br>
+   *   [short_int_version_number] <br>
+   *   [int_dim] // 1 for a Trajectory <br>
+   *   [int_nb_points] <br>
+   *   [block_1] // COMPRESSED_BLOCK_SIZE points <br>
+   *   ...
+   *
    * \note Only map valued trajectories are serializable
    *
    * \param bin_file binary file (ofstream object)
@@ -66,6 +73,15 @@ namespace codac
    *   ... <br>
    *   [Trajectory_n]
    *
+   * With the version 4, components sampled at the same times are written
+   * together, the times being stored once: <br>
+   *   [short_int_size] <br>
+   *   [short_int_version_number] <br>
+   *   [int_dim] // equals size <br>
+   *   [int_nb_points] <br>
+   *   [block_1] // for each point: t_k, then the value of each component <br>
+   *   ...
+   *
    * \param bin_file binary file (ofstream object)
    * \param traj TrajectoryVector object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
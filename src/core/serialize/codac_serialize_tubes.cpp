@@ -8,8 +8,14 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <vector>
+#include <string>
+#include <limits>
+#include <memory>
+#include <utility>
 #include "codac_serialize_tubes.h"
 #include "codac_serialize_intervals.h"
+#include "codac_serialize_compression.h"
 #include "codac_Exception.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
@@ -20,6 +26,136 @@ using namespace ibex;
 
 namespace codac
 {
+  /**
+   * \brief Writes null bytes, so that the next field is 8-byte aligned in the file
+   */
+  static void write_padding(ofstream& bin_file)
+  {
+    streamoff pos = bin_file.tellp();
+    if(pos < 0)
+      throw Exception(__func__, "unable to get the position in the file");
+
+    char padding[8] = { 0 };
+    bin_file.write(padding, (8 - pos % 8) % 8);
+  }
+
+  /**
+   * \brief Skips the bytes written by write_padding()
+   */
+  static void read_padding(ifstream& bin_file)
+  {
+    streamoff pos = bin_file.tellg();
+    if(pos < 0)
+      throw Exception(__func__, "unable to get the position in the file");
+
+    bin_file.seekg((8 - pos % 8) % 8, ios::cur);
+  }
+
+  /**
+   * \brief Writes tubes sharing the same slicing, with the version 4
+   */
+  static void serialize_compressed_Tubes(ofstream& bin_file, const vector<const Tube*>& v_tubes)
+  {
+    short int version_number = 4;
+    bin_file.write((const char*)&version_number, sizeof(short int));
+
+    int dim = v_tubes.size();
+    if(dim < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    bin_file.write((const char*)&dim, sizeof(int));
+    int slices_number = v_tubes[0]->nb_slices();
+    bin_file.write((const char*)&slices_number, sizeof(int));
+
+    // Streams of each tube: gates and codomains bounds
+    CompressedBlockWriter writer(bin_file, 4*dim);
+    vector<const Slice*> v_s(dim);
+    for(int i = 0 ; i < dim ; i++)
+      v_s[i] = v_tubes[i]->first_slice();
+
+    double bounds[2];
+    for(int k = 0 ; k < slices_number ; k++)
+    {
+      writer.add_time(v_s[0]->tdomain().lb()); // slicing written once
+      for(int i = 0 ; i < dim ; i++)
+      {
+        serialize_Interval(bounds, v_s[i]->input_gate());
+        writer.add_value(bounds[0], 4*i); writer.add_value(bounds[1], 4*i+1);
+        serialize_Interval(bounds, v_s[i]->codomain());
+        writer.add_value(bounds[0], 4*i+2); writer.add_value(bounds[1], 4*i+3);
+      }
+
+      if(k == slices_number - 1) // last gates, in the last block
+      {
+        writer.add_time(v_s[0]->tdomain().ub());
+        for(int i = 0 ; i < dim ; i++)
+        {
+          serialize_Interval(bounds, v_s[i]->output_gate());
+          writer.add_value(bounds[0], 4*i); writer.add_value(bounds[1], 4*i+1);
+        }
+      }
+
+      else
+        for(int i = 0 ; i < dim ; i++)
+          v_s[i] = v_s[i]->next_slice();
+
+      if((k+1) % COMPRESSED_BLOCK_SIZE == 0 || k == slices_number - 1)
+        writer.flush();
+    }
+  }
+
+  /**
+   * \brief Reads tubes written with the version 4, once the version number
+   *        and the number of tubes have been read
+   */
+  static void deserialize_compressed_Tubes(ifstream& bin_file, vector<unique_ptr<Tube> >& v_tubes)
+  {
+    int dim = v_tubes.size();
+    if(dim < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    int slices_number;
+    bin_file.read((char*)&slices_number, sizeof(int));
+
+    // Each slice is coded on at least one byte for its time and for each of its values
+    if(!bin_file || slices_number < 1
+      || remaining_file_size(bin_file) < (streamoff)slices_number * (1 + 4*dim))
+      throw Exception(__func__, "wrong slices number");
+
+    // Arrays of the version 3, filled block after block
+    size_t n = slices_number;
+    vector<double> v_t(n+1);
+    vector<vector<double> > v_codomains(dim, vector<double>(2*n)), v_gates(dim, vector<double>(2*(n+1)));
+
+    CompressedBlockReader reader(bin_file, 4*dim);
+    for(size_t k = 0 ; k < n ; k++)
+    {
+      if(k % COMPRESSED_BLOCK_SIZE == 0)
+        reader.next_block();
+
+      v_t[k] = reader.next_time();
+      for(int i = 0 ; i < dim ; i++)
+      {
+        v_gates[i][2*k] = reader.next_value(4*i); v_gates[i][2*k+1] = reader.next_value(4*i+1);
+        v_codomains[i][2*k] = reader.next_value(4*i+2); v_codomains[i][2*k+1] = reader.next_value(4*i+3);
+      }
+    }
+
+    v_t[n] = reader.next_time();
+    for(int i = 0 ; i < dim ; i++)
+    {
+      v_gates[i][2*n] = reader.next_value(4*i); v_gates[i][2*n+1] = reader.next_value(4*i+1);
+    }
+    reader.end_block();
+
+    for(int i = 0 ; i < dim ; i++)
+    {
+      Tube *ptr;
+      deserialize_Tube(v_t.data(), v_codomains[i].data(), v_gates[i].data(), n, ptr);
+      v_tubes[i].reset(ptr);
+    }
+  }
+
   void serialize_Tube(ofstream& bin_file, const Tube& tube, int version_number)
   {
     if(!bin_file.is_open())
@@ -62,6 +198,41 @@ namespace codac
         break;
       }
 
+      case 3:
+      {
+        // Version number for compliance purposes
+        bin_file.write((const char*)&version_number, sizeof(short int));
+        write_padding(bin_file);
+
+        TubeBinaryHeader header = { { 'c','o','d','a','c','t','u','b' }, tube.nb_slices() };
+        bin_file.write((const char*)&header, sizeof(TubeBinaryHeader));
+
+        // Arrays of values, each written at once
+        size_t n = tube.nb_slices();
+        vector<double> v_t(n+1), v_codomains(2*n), v_gates(2*(n+1));
+
+        size_t k = 0;
+        serialize_Interval(&v_gates[0], tube.first_slice()->input_gate());
+        for(const Slice *s = tube.first_slice() ; s ; s = s->next_slice(), k++)
+        {
+          v_t[k] = s->tdomain().lb();
+          serialize_Interval(&v_codomains[2*k], s->codomain());
+          serialize_Interval(&v_gates[2*(k+1)], s->output_gate());
+        }
+        v_t[n] = tube.tdomain().ub();
+
+        bin_file.write((const char*)v_t.data(), v_t.size()*sizeof(double));
+        bin_file.write((const char*)v_codomains.data(), v_codomains.size()*sizeof(double));
+        bin_file.write((const char*)v_gates.data(), v_gates.size()*sizeof(double));
+        break;
+      }
+
+      case 4:
+      {
+        serialize_compressed_Tubes(bin_file, { &tube });
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -119,7 +290,7 @@ namespace codac
 
           if(prev_slice)
           {
-            delete slice->m_input_gate;
+            Slice::delete_gate(slice->m_input_gate);
             slice->m_input_gate = nullptr;
             Slice::chain_slices(prev_slice, slice);
           }
@@ -128,6 +299,8 @@ namespace codac
           lb = ub;
         }
 
+        tube->update_slices_index();
+
         // Codomains
         for(Slice *s = tube->first_slice() ; s ; s = s->next_slice())
         {
@@ -153,11 +326,87 @@ namespace codac
         break;
       }
 
+      case 3:
+      {
+        read_padding(bin_file);
+
+        TubeBinaryHeader header;
+        bin_file.read((char*)&header, sizeof(TubeBinaryHeader));
+
+        if(!bin_file || string(header.magic, 8) != "codactub")
+          throw Exception(__func__, "wrong file format");
+
+        // Arrays: t[n+1], codomains[2n], gates[2(n+1)]
+        if(header.nb_slices < 1 || header.nb_slices > numeric_limits<int>::max()
+          || remaining_file_size(bin_file) < (5 * header.nb_slices + 3) * (streamoff)sizeof(double))
+          throw Exception(__func__, "wrong slices number");
+
+        // Arrays of values, each read at once
+        size_t n = header.nb_slices;
+        vector<double> v_t(n+1), v_codomains(2*n), v_gates(2*(n+1));
+        bin_file.read((char*)v_t.data(), v_t.size()*sizeof(double));
+        bin_file.read((char*)v_codomains.data(), v_codomains.size()*sizeof(double));
+        bin_file.read((char*)v_gates.data(), v_gates.size()*sizeof(double));
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        deserialize_Tube(v_t.data(), v_codomains.data(), v_gates.data(), n, tube);
+        break;
+      }
+
+      case 4:
+      {
+        int dim;
+        bin_file.read((char*)&dim, sizeof(int));
+        if(dim != 1)
+          throw Exception(__func__, "tube vector to be deserialized by deserialize_TubeVector()");
+
+        vector<unique_ptr<Tube> > v_tubes(1);
+        deserialize_compressed_Tubes(bin_file, v_tubes);
+        tube = v_tubes[0].release();
+        break;
+      }
+
       default:
         throw Exception(__func__, "deserialization version number not supported");
     }
   }
 
+  void deserialize_Tube(const double *t, const double *codomains, const double *gates, int nb_slices, Tube *&tube)
+  {
+    assert(nb_slices > 0);
+    tube = new Tube();
+
+    // Creating slices, their values are already consistent
+    Slice *prev_slice = nullptr;
+    for(int k = 0 ; k < nb_slices ; k++)
+    {
+      Interval codomain;
+      deserialize_Interval(&codomains[2*k], codomain);
+      Slice *slice = new Slice(Interval(t[k], t[k+1]), codomain);
+
+      if(prev_slice)
+      {
+        Slice::delete_gate(slice->m_input_gate);
+        slice->m_input_gate = nullptr;
+        Slice::chain_slices(prev_slice, slice);
+      }
+
+      else
+      {
+        tube->m_first_slice = slice;
+        deserialize_Interval(&gates[0], *slice->m_input_gate);
+      }
+
+      deserialize_Interval(&gates[2*(k+1)], *slice->m_output_gate);
+      prev_slice = slice;
+    }
+
+    tube->update_slices_index();
+    tube->m_tdomain = Interval(t[0], t[nb_slices]); // redundant information for fast access
+  }
+
   void serialize_TubeVector(ofstream& bin_file, const TubeVector& tube, int version_number)
   {
     if(!bin_file.is_open())
@@ -165,8 +414,19 @@ namespace codac
 
     short int size = tube.size();
     bin_file.write((const char*)&size, sizeof(short int));
-    for(int i = 0 ; i < size ; i++)
-      serialize_Tube(bin_file, tube[i], version_number);
+
+    if(version_number == 4 && size > 0 && TubeVector::same_slicing(tube, tube[0]))
+    {
+      // The slicing is written once for all the components
+      vector<const Tube*> v_tubes(size);
+      for(int i = 0 ; i < size ; i++)
+        v_tubes[i] = &tube[i];
+      serialize_compressed_Tubes(bin_file, v_tubes);
+    }
+
+    else
+      for(int i = 0 ; i < size ; i++)
+        serialize_Tube(bin_file, tube[i], version_number);
   }
 
   void deserialize_TubeVector(ifstream& bin_file, TubeVector *&tube)
@@ -174,20 +434,50 @@ namespace codac
     if(!bin_file.is_open())
       throw Exception(__func__, "ifstream& bin_file not open");
 
-    tube = new TubeVector();
-
     short int size;
     bin_file.read((char*)&size, sizeof(short int));
-    
-    tube->m_n = size;
-    tube->m_v_tubes = new Tube[size];
-    
+
+    if(!bin_file || size < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    // Components are owned here until the end, in case of a wrong file
+    vector<unique_ptr<Tube> > v_tubes(size);
+
+    // Components sharing the same slicing, written with the version 4
+    short int version_number;
+    int dim = 0;
+    bin_file.read((char*)&version_number, sizeof(short int));
+    if(version_number == 4)
+      bin_file.read((char*)&dim, sizeof(int));
+
+    if(version_number == 4 && dim == size)
+      deserialize_compressed_Tubes(bin_file, v_tubes);
+
+    else // components written independently
+    {
+      bin_file.seekg(-(streamoff)(sizeof(short int) + (version_number == 4 ? sizeof(int) : 0)), ios::cur);
+
+      for(int i = 0 ; i < size ; i++)
+      {
+        Tube *ptr;
+        deserialize_Tube(bin_file, ptr);
+        v_tubes[i].reset(ptr);
+      }
+    }
+
+    unique_ptr<TubeVector> tube_vector(new TubeVector());
+    tube_vector->m_n = size;
+    tube_vector->m_v_tubes = new Tube[size];
+
+    // The slices are moved into the components, without copy
     for(int i = 0 ; i < size ; i++)
     {
-      Tube *ptr;
-      deserialize_Tube(bin_file, ptr);
-      (*tube)[i] = *ptr;
-      delete ptr;
+      Tube& x = tube_vector->m_v_tubes[i];
+      swap(x.m_first_slice, v_tubes[i]->m_first_slice);
+      x.m_tdomain = v_tubes[i]->m_tdomain;
+      x.update_slices_index(); // as for the deserialized tube
     }
+
+    tube = tube_vector.release();
   }
 }
\ No newline at end of file
@@ -13,21 +13,34 @@
 #define __CODAC_SERIALIZ_TUBES_H__
 
 #include <fstream>
+#include <cstdint>
 
 namespace codac
 {
   #define SERIALIZATION_VERSION 2
+  #define MAPPED_SERIALIZATION_VERSION 3
+  #define COMPRESSED_SERIALIZATION_VERSION 4
 
   class Tube;
   class TubeVector;
 
+  /**
+   * \brief Header of a Tube serialized with the version 3,
+   *        preceding the arrays of values
+   */
+  struct TubeBinaryHeader
+  {
+    char magic[8]; //!< identifier of the format: "codactub"
+    std::int64_t nb_slices; //!< number of slices
+  };
+
   /// \name Tube
   /// @{
 
   /**
-   * \brief Writes a Tube object into a binary file (version 2)
+   * \brief Writes a Tube object into a binary file (version 2 by default)
    * 
-   * Tube binary structure: <br>
+   * Tube binary structure, version 2: <br>
    *   [short_int_version_number] <br>
    *   [int_nb_slices] <br>
    *   [double_t0] <br>
@@ -41,6 +54,29 @@ namespace codac
    *   [gate_t1] <br>
    *   ...
    *
+   * Tube binary structure, version 3 (arrays of fixed-size values): <br>
+   *   [short_int_version_number] <br>
+   *   [padding] // 0 to 7 bytes, so that the next fields are 8-byte aligned in the file <br>
+   *   [TubeBinaryHeader] <br>
+   *   [double_t0] ... [double_tn] // bounds of the n slices tdomains <br>
+   *   [double_y0_lb] [double_y0_ub] ... // codomains of the n slices <br>
+   *   [double_g0_lb] [double_g0_ub] ... // n+1 gates
+   *
+   * Empty intervals are represented by NaN bounds. The version 3 can be
+   * memory-mapped without copy, see MappedTube. It is not written by default,
+   * for files to remain readable by previous releases: it is requested with
+   * MAPPED_SERIALIZATION_VERSION.
+   *
+   * Tube binary structure, version 4 (compressed blocks, see CompressedBlockWriter): <br>
+   *   [short_int_version_number] <br>
+   *   [int_dim] // 1 for a Tube <br>
+   *   [int_nb_slices] <br>
+   *   [block_1] // values of COMPRESSED_BLOCK_SIZE slices: t_k, gate_k, codomain_k <br>
+   *   ... <br>
+   *   [block_m] // last slices, followed by t_n and the last gate
+   *
+   * The version 4 is lossless and smaller on disk, but cannot be memory-mapped.
+   *
    * \param bin_file binary file (ofstream object)
    * \param tube Tube object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
@@ -57,6 +93,17 @@ namespace codac
    */
   void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
 
+  /**
+   * \brief Creates a Tube object from the arrays of the version 3 binary structure
+   *
+   * \param t array of the nb_slices+1 bounds of the slices tdomains
+   * \param codomains array of the 2*nb_slices bounds of the codomains
+   * \param gates array of the 2*(nb_slices+1) bounds of the gates
+   * \param nb_slices number of slices
+   * \param tube Tube object to be deserialized
+   */
+  void deserialize_Tube(const double *t, const double *codomains, const double *gates, int nb_slices, Tube *&tube);
+
   /// @}
   /// \name TubeVector
   /// @{
@@ -70,6 +117,16 @@ namespace codac
    *   ... <br>
    *   [Tube_n]
    *
+   * With the version 4, components sharing the same slicing are written
+   * together, the slicing being stored once: <br>
+   *   [short_int_size] <br>
+   *   [short_int_version_number] <br>
+   *   [int_dim] // equals size <br>
+   *   [int_nb_slices] <br>
+   *   [block_1] // for each slice: t_k, then gate_k and codomain_k of each component <br>
+   *   ... <br>
+   *   [block_m]
+   *
    * \param bin_file binary file (ofstream object)
    * \param tube TubeVector object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
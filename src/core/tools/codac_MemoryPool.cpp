@@ -0,0 +1,193 @@
+/** 
+ *  MemoryPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "codac_MemoryPool.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif // _WIN32
+
+using namespace std;
+
+namespace codac
+{
+  MemoryPool::MemoryPool(size_t block_size, size_t block_align)
+  {
+    assert(block_align > 0 && (block_align & (block_align - 1)) == 0 && "alignment must be a power of 2");
+
+    // A released block stores the address of the next free block
+    block_size = std::max(block_size, sizeof(void*));
+    block_align = std::max(block_align, alignof(void*));
+
+    m_block_size = (block_size + block_align - 1) & ~(block_align - 1);
+    m_blocks_offset = (sizeof(Chunk) + block_align - 1) & ~(block_align - 1);
+    m_chunk_capacity = (CHUNK_SIZE - m_blocks_offset) / m_block_size;
+    assert(m_chunk_capacity > 1 && "block size too large for the pool");
+  }
+
+  MemoryPool::~MemoryPool()
+  {
+    assert(m_nb_allocated == 0 && "blocks are still in use");
+
+    while(m_available)
+    {
+      Chunk *chunk = m_available;
+      unlink_available(chunk);
+      destroy_chunk(chunk);
+    }
+  }
+
+  void* MemoryPool::allocate()
+  {
+    lock_guard<mutex> lock(m_mutex);
+
+    Chunk *chunk = m_available;
+    if(chunk == nullptr)
+      chunk = create_chunk();
+
+    void *ptr;
+
+    if(chunk->free_list) // reusing a released block
+    {
+      ptr = chunk->free_list;
+      chunk->free_list = *static_cast<void**>(ptr);
+    }
+
+    else // next untouched block: successive allocations are contiguous
+    {
+      ptr = blocks(chunk) + chunk->nb_bumped * m_block_size;
+      chunk->nb_bumped++;
+    }
+
+    chunk->nb_used++;
+    m_nb_allocated++;
+
+    if(chunk->nb_used == m_chunk_capacity)
+      unlink_available(chunk); // full chunk
+
+    return ptr;
+  }
+
+  void MemoryPool::deallocate(void *ptr)
+  {
+    if(ptr == nullptr)
+      return;
+
+    lock_guard<mutex> lock(m_mutex);
+
+    Chunk *chunk = reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t)(CHUNK_SIZE - 1));
+    assert(chunk->nb_used > 0);
+
+    *static_cast<void**>(ptr) = chunk->free_list;
+    chunk->free_list = ptr;
+    chunk->nb_used--;
+    m_nb_allocated--;
+
+    if(!chunk->available)
+      link_available(chunk);
+
+    if(chunk->nb_used == 0)
+    {
+      if(m_nb_available > 1) // the chunk is given back to the system
+      {
+        unlink_available(chunk);
+        destroy_chunk(chunk);
+      }
+
+      else // last chunk kept: restarting from an untouched area
+      {
+        chunk->free_list = nullptr;
+        chunk->nb_bumped = 0;
+      }
+    }
+  }
+
+  size_t MemoryPool::chunk_capacity() const
+  {
+    return m_chunk_capacity;
+  }
+
+  size_t MemoryPool::nb_allocated_blocks() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_nb_allocated;
+  }
+
+  MemoryPool::Chunk* MemoryPool::create_chunk()
+  {
+    // Chunks are aligned on their size, so that the chunk of a block
+    // is found by masking its address (see deallocate())
+    #ifdef _WIN32
+      void *mem = _aligned_malloc(CHUNK_SIZE, CHUNK_SIZE); // no aligned_alloc on MSVC
+    #else
+      void *mem = aligned_alloc(CHUNK_SIZE, CHUNK_SIZE);
+    #endif // _WIN32
+    if(mem == nullptr)
+      throw bad_alloc();
+
+    Chunk *chunk = new(mem) Chunk();
+    link_available(chunk);
+    return chunk;
+  }
+
+  void MemoryPool::destroy_chunk(Chunk *chunk)
+  {
+    assert(!chunk->available);
+    chunk->~Chunk();
+
+    #ifdef _WIN32
+      _aligned_free(chunk); // memory from _aligned_malloc cannot be released by free()
+    #else
+      free(chunk);
+    #endif // _WIN32
+  }
+
+  void MemoryPool::link_available(Chunk *chunk)
+  {
+    assert(!chunk->available);
+
+    chunk->prev = nullptr;
+    chunk->next = m_available;
+    if(m_available)
+      m_available->prev = chunk;
+    m_available = chunk;
+
+    chunk->available = true;
+    m_nb_available++;
+  }
+
+  void MemoryPool::unlink_available(Chunk *chunk)
+  {
+    assert(chunk->available);
+
+    if(chunk->prev)
+      chunk->prev->next = chunk->next;
+    else
+      m_available = chunk->next;
+
+    if(chunk->next)
+      chunk->next->prev = chunk->prev;
+
+    chunk->prev = nullptr;
+    chunk->next = nullptr;
+    chunk->available = false;
+    m_nb_available--;
+  }
+
+  char* MemoryPool::blocks(Chunk *chunk) const
+  {
+    return reinterpret_cast<char*>(chunk) + m_blocks_offset;
+  }
+}
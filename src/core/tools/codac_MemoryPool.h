@@ -0,0 +1,149 @@
+/**
+ *  \file
+ *  MemoryPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_MEMORYPOOL_H__
+#define __CODAC_MEMORYPOOL_H__
+
+#include <cstddef>
+#include <mutex>
+
+namespace codac
+{
+  /**
+   * \class MemoryPool
+   * \brief Fixed-size blocks allocator, carving objects out of large contiguous chunks
+   *
+   * Objects that are allocated one after the other (for instance the slices of
+   * a tube being built) are stored side by side in memory. Loops over such objects
+   * then stream through memory linearly instead of chasing heap pointers.
+   *
+   * \note Chunks are aligned on their own size, so that the chunk owning a block
+   *       is retrieved in constant time at deallocation.
+   * \note Allocations and deallocations are thread-safe.
+   */
+  class MemoryPool
+  {
+    public:
+
+      /**
+       * \brief Creates a pool of blocks of the given size
+       *
+       * \param block_size size in bytes of the objects to be allocated
+       * \param block_align alignment requirement of these objects
+       */
+      MemoryPool(std::size_t block_size, std::size_t block_align = alignof(std::max_align_t));
+
+      /**
+       * \brief MemoryPool destructor
+       *
+       * \note All the blocks must have been deallocated beforehand
+       */
+      ~MemoryPool();
+
+      /**
+       * \brief Returns a pointer to an uninitialized block of memory
+       *
+       * \return the address of the block
+       */
+      void* allocate();
+
+      /**
+       * \brief Gives back a block previously obtained from allocate()
+       *
+       * \note A chunk is released as soon as all its blocks are free,
+       *       unless it is the last chunk of the pool
+       *
+       * \param ptr the address of the block (nullptr is accepted)
+       */
+      void deallocate(void *ptr);
+
+      /**
+       * \brief Returns the number of blocks that can be stored in one chunk
+       *
+       * \return the capacity of a chunk
+       */
+      std::size_t chunk_capacity() const;
+
+      /**
+       * \brief Returns the number of blocks currently allocated from this pool
+       *
+       * \return the number of blocks in use
+       */
+      std::size_t nb_allocated_blocks() const;
+
+      static const std::size_t CHUNK_SIZE = 1 << 16; //!< size in bytes of each chunk (64 KiB)
+
+    protected:
+
+      MemoryPool(const MemoryPool&) = delete;
+      MemoryPool& operator=(const MemoryPool&) = delete;
+
+      /**
+       * \brief Header of a chunk, stored at its beginning
+       */
+      struct Chunk
+      {
+        Chunk *prev = nullptr, *next = nullptr; //!< links to other chunks with free blocks
+        void *free_list = nullptr; //!< single linked list of released blocks
+        std::size_t nb_used = 0; //!< number of blocks currently allocated in this chunk
+        std::size_t nb_bumped = 0; //!< number of blocks already handed out from the untouched area
+        bool available = false; //!< true if the chunk is referenced in the list of available chunks
+      };
+
+      /**
+       * \brief Allocates a new chunk and references it as available
+       *
+       * \return a pointer to the chunk header
+       */
+      Chunk* create_chunk();
+
+      /**
+       * \brief Gives back to the system a chunk that is no longer referenced
+       *
+       * \param chunk a pointer to the chunk header
+       */
+      void destroy_chunk(Chunk *chunk);
+
+      /**
+       * \brief Adds a chunk to the list of chunks having free blocks
+       *
+       * \param chunk a pointer to the chunk header
+       */
+      void link_available(Chunk *chunk);
+
+      /**
+       * \brief Removes a chunk from the list of chunks having free blocks
+       *
+       * \param chunk a pointer to the chunk header
+       */
+      void unlink_available(Chunk *chunk);
+
+      /**
+       * \brief Returns the address of the first block of a chunk
+       *
+       * \param chunk a pointer to the chunk header
+       * \return the address of the storage area of the chunk
+       */
+      char* blocks(Chunk *chunk) const;
+
+      // Class variables:
+
+        std::size_t m_block_size; //!< size in bytes of one block, including padding
+        std::size_t m_blocks_offset; //!< offset of the first block from the chunk header
+        std::size_t m_chunk_capacity; //!< number of blocks per chunk
+        Chunk *m_available = nullptr; //!< list of chunks that still have free blocks
+        std::size_t m_nb_available = 0; //!< length of the list of available chunks
+        std::size_t m_nb_allocated = 0; //!< number of blocks in use
+        mutable std::mutex m_mutex; //!< lock for concurrent allocations
+  };
+}
+
+#endif
@@ -0,0 +1,189 @@
+/**
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include "codac_ThreadPool.h"
+
+using namespace std;
+
+namespace codac
+{
+  ThreadPool::ThreadPool(int nb_threads)
+    : m_failed(false)
+  {
+    assert(nb_threads >= 0);
+
+    if(nb_threads == 0)
+      nb_threads = hardware_concurrency();
+
+    m_ranges = unique_ptr<TaskRange[]>(new TaskRange[nb_threads]);
+
+    for(int i = 1 ; i < nb_threads ; i++)
+      m_workers.push_back(thread(&ThreadPool::worker_loop, this, i));
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_stop = true;
+    }
+
+    m_cv_job.notify_all();
+    for(auto& w : m_workers)
+      w.join();
+  }
+
+  int ThreadPool::nb_threads() const
+  {
+    return m_workers.size() + 1;
+  }
+
+  void ThreadPool::run(int nb_tasks, const function<void(int,int)>& f)
+  {
+    assert(nb_tasks >= 0);
+    lock_guard<mutex> run_lock(m_run_mutex);
+
+    if(m_workers.empty() || nb_tasks == 1)
+    {
+      for(int k = 0 ; k < nb_tasks ; k++)
+        f(k, 0);
+      return;
+    }
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_task = &f;
+      m_nb_busy = m_workers.size();
+      m_exception = nullptr;
+      m_failed = false;
+      m_job_id++;
+
+      // Initial distribution of the tasks in ranges of equal sizes
+      int n = nb_threads();
+      for(int i = 0 ; i < n ; i++)
+      {
+        lock_guard<mutex> range_lock(m_ranges[i].mutex);
+        m_ranges[i].begin = (long)nb_tasks * i / n;
+        m_ranges[i].end = (long)nb_tasks * (i+1) / n;
+      }
+    }
+
+    m_cv_job.notify_all();
+    process_tasks(0);
+
+    exception_ptr e;
+
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv_done.wait(lock, [this] { return m_nb_busy == 0; });
+      m_task = nullptr;
+      swap(e, m_exception);
+    }
+
+    if(e)
+      rethrow_exception(e);
+  }
+
+  int ThreadPool::hardware_concurrency()
+  {
+    unsigned int n = thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+
+  void ThreadPool::worker_loop(int thread_id)
+  {
+    unsigned long last_job_id = 0;
+
+    while(true)
+    {
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_cv_job.wait(lock, [&] { return m_stop || m_job_id != last_job_id; });
+
+        if(m_stop)
+          return;
+
+        last_job_id = m_job_id;
+      }
+
+      process_tasks(thread_id);
+
+      {
+        lock_guard<mutex> lock(m_mutex);
+        if(--m_nb_busy == 0)
+          m_cv_done.notify_one();
+      }
+    }
+  }
+
+  void ThreadPool::process_tasks(int thread_id)
+  {
+    int k;
+
+    while(!m_failed && (pop_task(thread_id, k) || (steal_tasks(thread_id) && pop_task(thread_id, k))))
+    {
+      try
+      {
+        (*m_task)(k, thread_id);
+      }
+
+      catch(...)
+      {
+        lock_guard<mutex> lock(m_mutex);
+        if(!m_exception)
+          m_exception = current_exception();
+        m_failed = true;
+      }
+    }
+  }
+
+  bool ThreadPool::pop_task(int thread_id, int& task_id)
+  {
+    TaskRange& r = m_ranges[thread_id];
+    lock_guard<mutex> lock(r.mutex);
+
+    if(r.begin >= r.end)
+      return false;
+
+    task_id = r.begin++;
+    return true;
+  }
+
+  bool ThreadPool::steal_tasks(int thread_id)
+  {
+    int n = nb_threads();
+
+    for(int i = 1 ; i < n ; i++)
+    {
+      TaskRange& victim = m_ranges[(thread_id + i) % n];
+      int begin, end;
+
+      {
+        lock_guard<mutex> lock(victim.mutex);
+        if(victim.begin >= victim.end)
+          continue;
+
+        // The upper half is stolen (the whole range if only one task is left)
+        begin = victim.begin + (victim.end - victim.begin) / 2;
+        end = victim.end;
+        victim.end = begin;
+      }
+
+      TaskRange& r = m_ranges[thread_id];
+      lock_guard<mutex> lock(r.mutex);
+      r.begin = begin;
+      r.end = end;
+      return true;
+    }
+
+    return false;
+  }
+}
@@ -0,0 +1,154 @@
+/**
+ *  \file
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_THREADPOOL_H__
+#define __CODAC_THREADPOOL_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <atomic>
+
+namespace codac
+{
+  /**
+   * \class ThreadPool
+   * \brief Set of persistent worker threads executing independent tasks
+   *
+   * The calling thread takes part in the computations: a pool of
+   * \f$n\f$ threads only creates \f$n-1\f$ workers.
+   *
+   * Tasks are scheduled by work stealing: each thread is first given a range
+   * of consecutive tasks. A thread that runs out of tasks steals the upper
+   * half of the remaining range of another thread.
+   */
+  class ThreadPool
+  {
+    public:
+
+      /**
+       * \brief Creates a pool of threads
+       *
+       * \param nb_threads number of threads, including the calling one
+       *        (if 0, the number of hardware threads is used)
+       */
+      explicit ThreadPool(int nb_threads = 0);
+
+      /**
+       * \brief ThreadPool destructor
+       *
+       * Waits for the end of the workers.
+       */
+      ~ThreadPool();
+
+      /**
+       * \brief Returns the number of threads, including the calling one
+       *
+       * \return the number of threads
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Runs the tasks \f$0,\dots,n-1\f$ and returns once they are all done
+       *
+       * Each thread is identified by an id in \f$[0,\textrm{nb\_threads}-1]\f$,
+       * the calling thread being 0: resources can be attached to threads this way.
+       * The order of execution of the tasks is not specified.
+       *
+       * \note If a task throws an exception, the remaining tasks are not started
+       *       and the first exception is rethrown in the calling thread.
+       *
+       * \param nb_tasks number \f$n\f$ of tasks
+       * \param f the task function, called as `f(task_id, thread_id)`
+       */
+      void run(int nb_tasks, const std::function<void(int,int)>& f);
+
+      /**
+       * \brief Returns the number of hardware threads
+       *
+       * \return the number of concurrent threads supported (at least 1)
+       */
+      static int hardware_concurrency();
+
+      // Block decomposition of the slices of tubes processed in parallel
+      // (static contractors, evaluations of tube functions):
+
+        static const int SLICES_PER_TASK = 512; //!< number of consecutive slices processed by a thread at once
+        static const int TASKS_PER_THREAD = 4; //!< number of tasks per thread in a block of slices, for load balancing
+
+    protected:
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      /**
+       * \brief Main loop of a worker
+       *
+       * \param thread_id id of the worker
+       */
+      void worker_loop(int thread_id);
+
+      /**
+       * \brief Executes tasks of the current job until there is none left
+       *
+       * \param thread_id id of the calling thread
+       */
+      void process_tasks(int thread_id);
+
+      /**
+       * \brief Takes the next task of the range of a thread
+       *
+       * \param thread_id id of the thread
+       * \param task_id the task to be executed, if any
+       * \return `true` if a task has been taken
+       */
+      bool pop_task(int thread_id, int& task_id);
+
+      /**
+       * \brief Moves the upper half of the tasks of another thread to a thread
+       *
+       * \param thread_id id of the thread out of tasks
+       * \return `true` if tasks have been stolen
+       */
+      bool steal_tasks(int thread_id);
+
+      /**
+       * \brief Range of tasks assigned to a thread
+       */
+      struct TaskRange
+      {
+        std::mutex mutex; //!< lock on the range
+        int begin = 0, end = 0; //!< remaining tasks \f$[\textrm{begin},\textrm{end})\f$
+      };
+
+      // Class variables:
+
+        std::vector<std::thread> m_workers; //!< worker threads (the calling thread excluded)
+        std::mutex m_mutex; //!< lock on the job state
+        std::condition_variable m_cv_job; //!< notifies workers of a new job or of the end of the pool
+        std::condition_variable m_cv_done; //!< notifies the caller of the end of a job
+        std::mutex m_run_mutex; //!< serializes concurrent calls to run()
+
+        const std::function<void(int,int)> *m_task = nullptr; //!< function of the current job
+        std::unique_ptr<TaskRange[]> m_ranges; //!< remaining tasks of each thread
+        int m_nb_busy = 0; //!< number of workers still engaged in the current job
+        unsigned long m_job_id = 0; //!< identifies the current job
+        bool m_stop = false; //!< set when the pool is destroyed
+        std::exception_ptr m_exception; //!< first exception raised by a task
+        std::atomic<bool> m_failed; //!< set as soon as a task has raised an exception
+  };
+}
+
+#endif
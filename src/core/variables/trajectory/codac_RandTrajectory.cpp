@@ -34,8 +34,7 @@ namespace codac
       for(t = tdomain.lb() ; t < tdomain.ub()+timestep ; t+=timestep)
       {
         double y = Tools::rand_in_bounds(bounds);
-        m_map_values[std::min(t,tdomain.ub())] = y;
-        m_codomain |= y;
+        set(y, std::min(t,tdomain.ub()));
       }
       m_tdomain = tdomain;
 
@@ -9,6 +9,7 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include "codac_Trajectory.h"
 
 using namespace std;
@@ -16,6 +17,16 @@ using namespace ibex;
 
 namespace codac
 {
+  /**
+   * \brief Linear interpolation at t between the samples i and i+1 (or the sample i alone if last)
+   */
+  static inline double interpolate(const double *v_t, const double *v_x, size_t i, size_t j, double t)
+  {
+    double dt = v_t[j] - v_t[i];
+    // Without branching, dt = 0 leads to the value x(t_i), since t = t_i
+    return v_x[i] + (t - v_t[i]) * (v_x[j] - v_x[i]) / (dt > 0. ? dt : 1.);
+  }
+
   // Public methods
 
     // Definition
@@ -23,7 +34,7 @@ namespace codac
     Trajectory::Trajectory()
       : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
-      m_map_values = map<double,double>();
+
     }
 
     Trajectory::Trajectory(const Trajectory& traj)
@@ -50,17 +61,24 @@ namespace codac
     }
 
     Trajectory::Trajectory(const map<double,double>& map_values)
-      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_map_values(map_values)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
       // todo: restore this? assert(!map_values.empty());
       // todo: check that empty traj are allowed for all methods
 
+      m_v_t.reserve(map_values.size());
+      m_v_x.reserve(map_values.size());
+
+      for(const auto& it : map_values)
+      {
+        m_v_t.push_back(it.first);
+        m_v_x.push_back(it.second);
+      }
+
       if(!map_values.empty())
       {
         // Temporal domain:
-        map<double,double>::const_iterator
-          last_it = map_values.end(); last_it--; // accessing last value
-        m_tdomain = Interval(map_values.begin()->first, last_it->first);
+        m_tdomain = Interval(m_v_t.front(), m_v_t.back());
 
         // Codomain:
         compute_codomain();
@@ -76,10 +94,7 @@ namespace codac
       for(list<double>::const_iterator it_t = list_t.begin(), it_x = list_x.begin() ;
           it_t != list_t.end() && it_x != list_x.end();
           ++it_t, ++it_x)
-      {
-        m_map_values[*it_t] = *it_x;
-        m_tdomain |= *it_t;
-      }
+        set(*it_x, *it_t);
     }
 
     Trajectory::~Trajectory()
@@ -90,19 +105,31 @@ namespace codac
 
     const Trajectory& Trajectory::operator=(const Trajectory& x)
     {
+      if(this == &x)
+        return *this;
+
+      if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
+      {
+        delete m_function;
+        m_function = nullptr;
+      }
+
       m_tdomain = x.m_tdomain;
       m_codomain = x.m_codomain;
       m_traj_def_type = x.m_traj_def_type;
+      invalidate_samples_cache();
 
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
-          delete m_function;
           m_function = new TFunction(*x.m_function);
+          m_v_t.clear();
+          m_v_x.clear();
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          m_map_values = x.m_map_values;
+          m_v_t = x.m_v_t;
+          m_v_x = x.m_v_x;
           break;
 
         default:
@@ -132,9 +159,34 @@ namespace codac
     const map<double,double>& Trajectory::sampled_map() const
     {
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+
+      if(!m_map_synced)
+      {
+        lock_guard<mutex> lock(m_cache_mutex);
+        if(!m_map_synced) // the map may have been built by another thread meanwhile
+        {
+          m_map_values.clear();
+          for(size_t i = 0 ; i < m_v_t.size() ; i++)
+            m_map_values.emplace_hint(m_map_values.end(), m_v_t[i], m_v_x[i]);
+          m_map_synced = true;
+        }
+      }
+
       return m_map_values;
     }
 
+    const vector<double>& Trajectory::sampled_times() const
+    {
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      return m_v_t;
+    }
+
+    const vector<double>& Trajectory::sampled_values() const
+    {
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      return m_v_x;
+    }
+
     const TFunction* Trajectory::tfunction() const
     {
       assert(m_traj_def_type == TrajDefnType::ANALYTIC_FNC);
@@ -156,22 +208,10 @@ namespace codac
           return m_function->eval(t).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(m_map_values.find(t) != m_map_values.end()) // key exists
-            return m_map_values.at(t);
-            // todo: optimize this to avoid double reading of the map?
-
-          else
-          {
-            typename map<double,double>::const_iterator it_lower, it_upper;
-            it_lower = m_map_values.lower_bound(t);
-            it_upper = it_lower;
-            it_lower--;
-
-            // Linear interpolation
-            return it_lower->second +
-                   (t - it_lower->first) * (it_upper->second - it_lower->second) /
-                   (it_upper->first - it_lower->first);
-          }
+        {
+          size_t i = sample_index(t);
+          return interpolate(m_v_t.data(), m_v_x.data(), i, std::min(i+1, m_v_t.size()-1), t);
+        }
 
         default:
           assert(false && "unhandled case");
@@ -195,13 +235,15 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
+        {
           eval |= (*this)(t.lb());
           eval |= (*this)(t.ub());
 
-          for(map<double,double>::const_iterator it = m_map_values.lower_bound(t.lb()) ;
-              it != m_map_values.upper_bound(t.ub()) ; it++)
-            eval |= it->second;
+          size_t first = lower_bound(m_v_t.begin(), m_v_t.end(), t.lb()) - m_v_t.begin();
+          size_t last = upper_bound(m_v_t.begin()+first, m_v_t.end(), t.ub()) - m_v_t.begin();
+          eval |= samples_hull(first, last);
           break;
+        }
 
         default:
           assert(false && "unhandled case");
@@ -209,6 +251,57 @@ namespace codac
 
       return eval;
     }
+
+    void Trajectory::eval(const double *v_t, double *v_x, size_t n) const
+    {
+      switch(m_traj_def_type)
+      {
+        case TrajDefnType::ANALYTIC_FNC:
+          for(size_t k = 0 ; k < n ; k++)
+            v_x[k] = (*this)(v_t[k]);
+          break;
+
+        case TrajDefnType::MAP_OF_VALUES:
+        {
+          assert(!m_v_t.empty());
+
+          const size_t block_size = 256, last = m_v_t.size()-1;
+          const double *t_ = m_v_t.data(), *x_ = m_v_x.data();
+          size_t v_i[block_size], v_j[block_size];
+          size_t i = 0;
+
+          for(size_t b = 0 ; b < n ; b += block_size)
+          {
+            const size_t nb = std::min(block_size, n-b);
+
+            // Searching the samples (each search starts from the previous sample)
+            for(size_t k = 0 ; k < nb ; k++)
+            {
+              assert(tdomain().contains(v_t[b+k]));
+              i = sample_index(v_t[b+k], i);
+              v_i[k] = i;
+              v_j[k] = std::min(i+1, last);
+            }
+
+            // Linear interpolations, as a loop without branching
+            // over contiguous arrays, that can be vectorized
+            for(size_t k = 0 ; k < nb ; k++)
+              v_x[b+k] = interpolate(t_, x_, v_i[k], v_j[k], v_t[b+k]);
+          }
+          break;
+        }
+
+        default:
+          assert(false && "unhandled case");
+      }
+    }
+
+    const vector<double> Trajectory::eval(const vector<double>& v_t) const
+    {
+      vector<double> v_x(v_t.size());
+      eval(v_t.data(), v_x.data(), v_t.size());
+      return v_x;
+    }
     
     double Trajectory::first_value() const
     {
@@ -218,7 +311,7 @@ namespace codac
           return m_function->eval(m_tdomain.lb()).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.begin()->second;
+          return m_v_x.front();
 
         default:
           assert(false && "unhandled case");
@@ -234,7 +327,7 @@ namespace codac
           return m_function->eval(m_tdomain.ub()).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.rbegin()->second;
+          return m_v_x.back();
 
         default:
           assert(false && "unhandled case");
@@ -252,7 +345,7 @@ namespace codac
           return m_function == nullptr;
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.empty();
+          return m_v_t.empty();
 
         default:
           assert(false && "unhandled case");
@@ -270,13 +363,15 @@ namespace codac
         if(m_tdomain != x.tdomain() || m_codomain != x.codomain())
           return false;
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = m_map_values.begin() ; it_map != m_map_values.end() ; it_map++)
+        size_t j = 0;
+        for(size_t i = 0 ; i < m_v_t.size() ; i++)
         {
-          if(x.sampled_map().find(it_map->first) == x.sampled_map().end())
+          j = lower_bound(x.m_v_t.begin()+j, x.m_v_t.end(), m_v_t[i]) - x.m_v_t.begin();
+
+          if(j == x.m_v_t.size() || x.m_v_t[j] != m_v_t[i])
             return false;
 
-          if(it_map->second != x.sampled_map().at(it_map->first))
+          if(m_v_x[i] != x.m_v_x[j])
             return false;
         }
 
@@ -303,11 +398,30 @@ namespace codac
       
       m_tdomain |= t;
 
-      bool update_codomain = m_map_values.find(t) != m_map_values.end() // key already exists
-            && m_codomain.contains(m_map_values.at(t)); // and new value inside codomain hull
+      if(m_v_t.empty() || t > m_v_t.back()) // values mostly set by increasing times
+      {
+        m_v_t.push_back(t);
+        m_v_x.push_back(y);
+        m_codomain |= y;
+        invalidate_samples_cache(true);
+        return;
+      }
+
+      invalidate_samples_cache();
+
+      size_t i = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+      // The codomain may shrink only if an existing value that bounds it is replaced
+      bool update_codomain = m_v_t[i] == t
+            && (m_v_x[i] == m_codomain.lb() || m_v_x[i] == m_codomain.ub());
+
+      if(m_v_t[i] == t)
+        m_v_x[i] = y;
 
-      m_map_values.erase(t);
-      m_map_values.emplace(t, y);
+      else
+      {
+        m_v_t.insert(m_v_t.begin()+i, t);
+        m_v_x.insert(m_v_x.begin()+i, y);
+      }
 
       if(update_codomain) // the new codomain may be a subset of the old one
         compute_codomain();
@@ -326,15 +440,24 @@ namespace codac
         double y_lb = (*this)(t.lb());
         double y_ub = (*this)(t.ub());
 
-        map<double,double>::iterator it = m_map_values.begin();
-        while(it != m_map_values.end())
+        size_t first = upper_bound(m_v_t.begin(), m_v_t.end(), t.lb()) - m_v_t.begin();
+        size_t last = lower_bound(m_v_t.begin()+first, m_v_t.end(), t.ub()) - m_v_t.begin();
+
+        vector<double> v_t, v_x;
+        v_t.reserve(last - first + 2);
+        v_x.reserve(last - first + 2);
+
+        v_t.push_back(t.lb()); v_x.push_back(y_lb); // clean truncation
+        v_t.insert(v_t.end(), m_v_t.begin()+first, m_v_t.begin()+last);
+        v_x.insert(v_x.end(), m_v_x.begin()+first, m_v_x.begin()+last);
+        if(t.ub() != t.lb())
         {
-          if(!t.contains(it->first)) it = m_map_values.erase(it);
-          else ++it;
+          v_t.push_back(t.ub()); v_x.push_back(y_ub);
         }
 
-        m_map_values[t.lb()] = y_lb; // clean truncation
-        m_map_values[t.ub()] = y_ub;
+        m_v_t.swap(v_t);
+        m_v_x.swap(v_x);
+        invalidate_samples_cache();
       }
 
       m_tdomain &= t;
@@ -346,11 +469,9 @@ namespace codac
     {
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
       {
-        map<double,double> map_temp = m_map_values;
-        m_map_values.clear();
-
-        for(map<double,double>::iterator it = map_temp.begin() ; it != map_temp.end() ; it++)
-          m_map_values.emplace(it->first + shift_ref, it->second);
+        for(auto& t : m_v_t)
+          t += shift_ref;
+        invalidate_samples_cache();
       }
 
       m_tdomain += shift_ref;
@@ -360,12 +481,11 @@ namespace codac
 
     bool Trajectory::constant_timestep(double& h) const
     {
-      assert(m_map_values.size() > 2);
-      h = next(m_map_values.begin())->first - m_map_values.begin()->first;
+      assert(m_v_t.size() > 2);
+      h = m_v_t[1] - m_v_t[0];
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ;
-        next(it) != m_map_values.end() ; it++)
-        if((it->first + h) != next(it)->first)
+      for(size_t i = 0 ; i+1 < m_v_t.size() ; i++)
+        if((m_v_t[i] + h) != m_v_t[i+1])
           return false;
         
       return true;
@@ -375,24 +495,20 @@ namespace codac
     {
       assert(dt > 0.);
 
-      map<double,double> new_map;
-      
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
-
-      double t;
-      for(t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
-        if(new_map.find(t) == new_map.end()) // if key does not exist already
-          new_map[t] = (*this)(t); // evaluation/interpolation
-      new_map[m_tdomain.ub()] = (*this)(m_tdomain.ub());
+      vector<double> v_t;
+      for(double t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
+        v_t.push_back(t);
+      v_t.push_back(m_tdomain.ub());
+      vector<double> v_x = eval(v_t); // evaluation/interpolation
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
         m_traj_def_type = TrajDefnType::MAP_OF_VALUES;
         delete m_function;
+        m_function = nullptr;
       }
 
-      m_map_values = new_map;
+      merge_samples(v_t, v_x); // existing keys are preserved
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -402,22 +518,16 @@ namespace codac
       assert(tdomain() == x.tdomain());
       assert(x.m_traj_def_type == TrajDefnType::MAP_OF_VALUES && "trajectory x has to be sampled");
       
-      map<double,double> new_map;
-
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
-
-      for(auto const& it : x.sampled_map())
-        if(new_map.find(it.first) == new_map.end()) // if key does not exist already
-          new_map[it.first] = (*this)(it.first); // evaluation/interpolation
+      vector<double> v_x = eval(x.m_v_t); // evaluation/interpolation
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
         m_traj_def_type = TrajDefnType::MAP_OF_VALUES;
         delete m_function;
+        m_function = nullptr;
       }
 
-      m_map_values = new_map;
+      merge_samples(x.m_v_t, v_x); // existing keys are preserved
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -431,24 +541,23 @@ namespace codac
       m_codomain = Interval::EMPTY_SET;
 
       double prev_value = 0., value_mod = 0.;
-      map<double,double> m_continuous_values;
 
-      for(const auto& it : m_map_values)
+      for(size_t i = 0 ; i < m_v_x.size() ; i++)
       {
-        if(!m_continuous_values.empty())
+        if(i != 0)
         {
-          if(prev_value - it.second > periodicity.diam()*0.9)
+          if(prev_value - m_v_x[i] > periodicity.diam()*0.9)
             value_mod += periodicity.diam();
-          else if(prev_value - it.second < -periodicity.diam()*0.9)
+          else if(prev_value - m_v_x[i] < -periodicity.diam()*0.9)
             value_mod -= periodicity.diam();
         }
 
-        prev_value = it.second;
-        m_continuous_values[it.first] = m_map_values[it.first] + value_mod;
-        m_codomain |= m_continuous_values[it.first];
+        prev_value = m_v_x[i];
+        m_v_x[i] += value_mod;
+        m_codomain |= m_v_x[i];
       }
 
-      m_map_values = m_continuous_values;
+      invalidate_samples_cache();
       return *this;
     }
 
@@ -462,15 +571,15 @@ namespace codac
       double val;
       Trajectory x;
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
+      for(size_t i = 0 ; i < m_v_t.size() ; i++)
       {
-        if(it == m_map_values.begin())
+        if(i == 0)
           val = c;
 
         else
-          val += (prev(it)->second + it->second) * (it->first - prev(it)->first) / 2.;
+          val += (m_v_x[i-1] + m_v_x[i]) * (m_v_t[i] - m_v_t[i-1]) / 2.;
 
-        x.set(val, it->first);
+        x.set(val, m_v_t[i]);
       }
 
       return x;
@@ -512,17 +621,16 @@ namespace codac
 
         case TrajDefnType::MAP_OF_VALUES: // finite difference computation
         {
-          assert(m_map_values.size() > 2);
+          assert(m_v_t.size() > 2);
 
           double h;
           if(!constant_timestep(h))
           {
             // Mean timestep
             double mean_h = 0.;
-            for(map<double,double>::const_iterator it = m_map_values.begin() ;
-              next(it) != m_map_values.end() ; it++)
-              mean_h += next(it)->first - it->first;
-            mean_h /= m_map_values.size()-1;
+            for(size_t i = 0 ; i+1 < m_v_t.size() ; i++)
+              mean_h += m_v_t[i+1] - m_v_t[i];
+            mean_h /= m_v_t.size()-1;
             
             // Equivalent traj with mean timestep
             Trajectory d_cst_h;
@@ -538,9 +646,9 @@ namespace codac
           else
           {
             // h is already constant at this point:
-            double h = next(m_map_values.begin())->first - m_map_values.begin()->first;
-            for(const auto& v : m_map_values)
-              d.set(finite_diff(v.first, h), v.first);
+            double h = m_v_t[1] - m_v_t[0];
+            for(const auto& t : m_v_t)
+              d.set(finite_diff(t, h), t);
           }
 
           assert(d.tdomain() == tdomain());
@@ -558,34 +666,18 @@ namespace codac
     {
       // todo: improve this with h not symmetric?
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
-      assert(m_map_values.find(t) != m_map_values.end()); // key exists
-      assert(m_map_values.size() > 2);
+      assert(m_v_t.size() > 2);
+      size_t i = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+      assert(i < m_v_t.size() && m_v_t[i] == t); // key exists
+      double x = m_v_x[i];
 
       vector<double> fwd;
-      map<double,double>::const_iterator it_fwd = m_map_values.find(t);
-      double x = it_fwd->second;
-
-      it_fwd++;
-      while(fwd.size() < 4 && it_fwd != m_map_values.end())
-      {
-        fwd.push_back(it_fwd->second);
-        it_fwd++;
-      }
+      for(size_t j = i+1 ; fwd.size() < 4 && j < m_v_x.size() ; j++)
+        fwd.push_back(m_v_x[j]);
 
       vector<double> bwd;
-      map<double,double>::const_iterator it_bwd = m_map_values.find(t);
-
-      if(it_bwd != m_map_values.begin())
-      {
-        it_bwd--;
-        while(bwd.size() < 4)
-        {
-          bwd.push_back(it_bwd->second);
-          if(it_bwd == m_map_values.begin())
-            break;
-          it_bwd--;
-        }
-      }
+      for(size_t j = i ; bwd.size() < 4 && j > 0 ; j--)
+        bwd.push_back(m_v_x[j-1]);
 
       if(fwd.size() == bwd.size()) // central finite difference
         switch(fwd.size())
@@ -649,16 +741,16 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(x.m_map_values.size() < 10)
+          if(x.m_v_t.size() < 10)
           {
-            str << ", " << x.m_map_values.size() << " pts: { ";
-            for(map<double,double>::const_iterator it = x.m_map_values.begin() ; it != x.m_map_values.end() ; it++)
-              str << "(" << it->first << "," << it->second << ") ";
+            str << ", " << x.m_v_t.size() << " pts: { ";
+            for(size_t i = 0 ; i < x.m_v_t.size() ; i++)
+              str << "(" << x.m_v_t[i] << "," << x.m_v_x[i] << ") ";
             str << "} ";
           }
 
           else
-            str << ", " << x.m_map_values.size() << " points";
+            str << ", " << x.m_v_t.size() << " points";
 
           break;
 
@@ -687,13 +779,117 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
+        {
           m_codomain = Interval::EMPTY_SET;
-          for(map<double,double>::iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
-            m_codomain |= it->second;
+          if(m_v_x.empty())
+            break;
+
+          double lb = m_v_x[0], ub = m_v_x[0];
+          for(const auto& x : m_v_x)
+          {
+            lb = std::min(lb, x);
+            ub = std::max(ub, x);
+          }
+          m_codomain = Interval(lb, ub);
           break;
+        }
 
         default:
           assert(false && "unhandled case");
       }
     }
+
+    size_t Trajectory::sample_index(double t, size_t hint) const
+    {
+      assert(!m_v_t.empty());
+
+      if(hint < m_v_t.size() && m_v_t[hint] <= t)
+      {
+        // Short forward search: successive queries are often close in time
+        for(size_t k = 0 ; k < 8 ; k++, hint++)
+          if(hint+1 == m_v_t.size() || m_v_t[hint+1] > t)
+            return hint;
+
+        return upper_bound(m_v_t.begin()+hint, m_v_t.end(), t) - m_v_t.begin() - 1;
+      }
+
+      size_t i = upper_bound(m_v_t.begin(), m_v_t.begin()+std::min(hint, m_v_t.size()), t) - m_v_t.begin();
+      return i == 0 ? 0 : i-1;
+    }
+
+    void Trajectory::merge_samples(const vector<double>& v_t, const vector<double>& v_x)
+    {
+      assert(v_t.size() == v_x.size());
+      assert(is_sorted(v_t.begin(), v_t.end()));
+
+      vector<double> new_v_t, new_v_x;
+      new_v_t.reserve(m_v_t.size() + v_t.size());
+      new_v_x.reserve(m_v_t.size() + v_t.size());
+
+      size_t i = 0, j = 0;
+      while(i < m_v_t.size() || j < v_t.size())
+      {
+        if(j == v_t.size() || (i < m_v_t.size() && m_v_t[i] <= v_t[j]))
+        {
+          if(j < v_t.size() && m_v_t[i] == v_t[j]) // key already exists
+            j++;
+          new_v_t.push_back(m_v_t[i]);
+          new_v_x.push_back(m_v_x[i]);
+          i++;
+        }
+
+        else
+        {
+          if(new_v_t.empty() || new_v_t.back() != v_t[j])
+          {
+            new_v_t.push_back(v_t[j]);
+            new_v_x.push_back(v_x[j]);
+          }
+          j++;
+        }
+      }
+
+      m_v_t.swap(new_v_t);
+      m_v_x.swap(new_v_x);
+      invalidate_samples_cache();
+    }
+
+    const Interval Trajectory::samples_hull(size_t first, size_t last) const
+    {
+      if(last - first < 4 * TrajectoryRangeIndex::BLOCK_SIZE) // short ranges: linear scan
+        return TrajectoryRangeIndex::scan(m_v_x, first, last);
+
+      if(!m_range_index_built)
+      {
+        lock_guard<mutex> lock(m_cache_mutex);
+        if(!m_range_index_built) // the index may have been built by another thread meanwhile
+        {
+          m_range_index.reset(new TrajectoryRangeIndex(m_v_x));
+          m_range_index_built = true;
+        }
+      }
+
+      return m_range_index->hull(m_v_x, first, last);
+    }
+
+    void Trajectory::invalidate_samples_cache(bool appended)
+    {
+      if(m_map_synced)
+      {
+        m_map_values.clear();
+        m_map_synced = false;
+      }
+
+      if(m_range_index_built)
+      {
+        if(appended)
+          m_range_index->push_back(m_v_x);
+
+        else
+        {
+          m_range_index.reset();
+          m_range_index_built = false;
+        }
+      }
+    }
 }
\ No newline at end of file
@@ -14,8 +14,13 @@
 
 #include <map>
 #include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include "codac_DynamicalItem.h"
 #include "codac_TFunction.h"
+#include "codac_TrajectoryRangeIndex.h"
 #include "codac_traj_arithmetic.h"
 
 namespace codac
@@ -29,6 +34,9 @@ namespace codac
    * \class Trajectory
    * \brief One dimensional trajectory \f$x(\cdot)\f$, defined as a temporal map of values
    *
+   * Sampled values are stored in two contiguous arrays of temporal keys and values,
+   * sorted by increasing time. The map of values is only built on demand.
+   *
    * \note Use TrajectoryVector for the multi-dimensional case
    */
   class Trajectory : public DynamicalItem
@@ -128,10 +136,29 @@ namespace codac
       /**
        * \brief Returns the map of values, if the object is defined as a map
        *
+       * \note Only kept for compatibility: the map is a copy of the sorted arrays of values,
+       *       built at the first call following an update of the trajectory. References
+       *       to the map remain valid, but are updated only by a new call to this method.
+       *       Prefer sampled_times() and sampled_values(), that do not require any copy.
+       *
        * \return a map<t,y> of values, or an empty map
        */
       const std::map<double,double>& sampled_map() const;
 
+      /**
+       * \brief Returns the sorted temporal keys, if the object is defined as a map
+       *
+       * \return a vector of increasing times \f$t_i\f$
+       */
+      const std::vector<double>& sampled_times() const;
+
+      /**
+       * \brief Returns the values associated with the temporal keys, if the object is defined as a map
+       *
+       * \return a vector of values \f$x(t_i)\f$
+       */
+      const std::vector<double>& sampled_values() const;
+
       /**
        * \brief Returns the temporal function, if the object is an analytic trajectory
        *
@@ -167,6 +194,26 @@ namespace codac
        */
       const Interval operator()(const Interval& t) const;
 
+      /**
+       * \brief Evaluates this trajectory at several times (batched evaluation)
+       *
+       * \note Evaluations are faster when the times are sorted, as each
+       *       sample is then searched from the previous one.
+       *
+       * \param v_t array of n temporal keys (each of them must belong to the trajectory's tdomain)
+       * \param v_x array of n values in which the evaluations \f$x(t_i)\f$ are stored
+       * \param n number of evaluations
+       */
+      void eval(const double *v_t, double *v_x, size_t n) const;
+
+      /**
+       * \brief Evaluates this trajectory at several times (batched evaluation)
+       *
+       * \param v_t vector of temporal keys (each of them must belong to the trajectory's tdomain)
+       * \return the vector of values \f$x(t_i)\f$
+       */
+      const std::vector<double> eval(const std::vector<double>& v_t) const;
+
       /**
        * \brief Returns the value \f$x(t_0)\f$
        *
@@ -218,6 +265,8 @@ namespace codac
        *
        * \note The trajectory must not be defined from an analytic function
        *
+       * \note Values set by increasing times are appended in amortized constant time
+       *
        * \param y local value of the trajectory
        * \param t the temporal key (double, must belong to the trajectory's tdomain)
        */
@@ -451,6 +500,44 @@ namespace codac
        */
       void compute_codomain();
 
+      /**
+       * \brief Returns the index of the last sample whose temporal key is less than or equal to \f$t\f$
+       *
+       * \param t the temporal key (double, must belong to the trajectory's tdomain)
+       * \param hint index from which the search starts, if \f$t\f$ is not before this sample
+       * \return the index \f$i\f$ such that \f$t_i\leqslant t<t_{i+1}\f$
+       */
+      size_t sample_index(double t, size_t hint = 0) const;
+
+      /**
+       * \brief Adds sorted samples to this trajectory, except those of already existing temporal keys
+       *
+       * \param v_t sorted vector of temporal keys
+       * \param v_x vector of values
+       */
+      void merge_samples(const std::vector<double>& v_t, const std::vector<double>& v_x);
+
+      /**
+       * \brief Returns the hull of the sampled values of indices \f$[first,last)\f$
+       *
+       * \note Long ranges are evaluated from a TrajectoryRangeIndex,
+       *       built at the first request.
+       *
+       * \param first index of the first value
+       * \param last index following the last value
+       * \return the hull of the values
+       */
+      const Interval samples_hull(size_t first, size_t last) const;
+
+      /**
+       * \brief Clears the structures built on demand from the samples
+       *        (map of values, range index), after an update of the samples
+       *
+       * \param appended true if the update only consists in a value appended
+       *        at the end, in which case the range index is updated instead
+       */
+      void invalidate_samples_cache(bool appended = false);
+
       // Class variables:
 
         Interval m_tdomain = Interval::EMPTY_SET; //!< temporal domain \f$[t_0,t_f]\f$ of the trajectory
@@ -462,9 +549,16 @@ namespace codac
         //union
         //{
           TFunction *m_function = nullptr; //!< optional pointer to the analytic expression of this trajectory
-          std::map<double,double> m_map_values; //!< optional map of values <t,y>: \f$x(t)=y\f$
+          std::vector<double> m_v_t; //!< optional sorted temporal keys \f$t_i\f$ of the values
+          std::vector<double> m_v_x; //!< optional values \f$x(t_i)\f$
         //};
 
+        mutable std::map<double,double> m_map_values; //!< map of values <t,y>, built on demand from the arrays
+        mutable std::atomic<bool> m_map_synced{false}; //!< true if the map of values is up to date
+        mutable std::unique_ptr<TrajectoryRangeIndex> m_range_index; //!< index of the values, built on demand
+        mutable std::atomic<bool> m_range_index_built{false}; //!< true if the range index is up to date
+        mutable std::mutex m_cache_mutex; //!< protects the constructions of the map of values and of the range index
+
       friend void deserialize_Trajectory(std::ifstream& bin_file, Trajectory *&traj);
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
   };
@@ -0,0 +1,126 @@
+/**
+ *  TrajectoryRangeIndex class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <algorithm>
+#include "codac_TrajectoryRangeIndex.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  TrajectoryRangeIndex::TrajectoryRangeIndex(const vector<double>& v_x)
+  {
+    build(v_x, (v_x.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  }
+
+  void TrajectoryRangeIndex::push_back(const vector<double>& v_x)
+  {
+    assert(v_x.size() == m_nb_values + 1);
+    size_t b = m_nb_values / BLOCK_SIZE;
+
+    if(b >= m_nb_leaves) // full tree: capacity is doubled
+    {
+      build(v_x, 2 * m_nb_leaves);
+      return;
+    }
+
+    m_nb_values++;
+    double x = v_x.back();
+
+    // Updating the leaf and its ancestors, until a node already encloses x
+    for(size_t i = m_nb_leaves + b ; i >= 1 ; i /= 2)
+    {
+      if(m_lb[i] <= x && x <= m_ub[i])
+        break;
+
+      m_lb[i] = std::min(m_lb[i], x);
+      m_ub[i] = std::max(m_ub[i], x);
+    }
+  }
+
+  const Interval TrajectoryRangeIndex::hull(const vector<double>& v_x, size_t first, size_t last) const
+  {
+    assert(v_x.size() == m_nb_values);
+    assert(first <= last && last <= m_nb_values);
+
+    // Complete blocks of the range: [first_block,last_block)
+    size_t first_block = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    size_t last_block = last / BLOCK_SIZE;
+
+    if(first_block >= last_block)
+      return scan(v_x, first, last);
+
+    double lb = POS_INFINITY, ub = NEG_INFINITY;
+
+    for(size_t l = m_nb_leaves + first_block, r = m_nb_leaves + last_block ; l < r ; l /= 2, r /= 2)
+    {
+      if(l & 1)
+      {
+        lb = std::min(lb, m_lb[l]); ub = std::max(ub, m_ub[l]);
+        l++;
+      }
+
+      if(r & 1)
+      {
+        r--;
+        lb = std::min(lb, m_lb[r]); ub = std::max(ub, m_ub[r]);
+      }
+    }
+
+    Interval h(lb, ub);
+    h |= scan(v_x, first, first_block * BLOCK_SIZE);
+    h |= scan(v_x, last_block * BLOCK_SIZE, last);
+    return h;
+  }
+
+  const Interval TrajectoryRangeIndex::scan(const vector<double>& v_x, size_t first, size_t last)
+  {
+    assert(first <= last && last <= v_x.size());
+
+    if(first == last)
+      return Interval::EMPTY_SET;
+
+    double lb = v_x[first], ub = v_x[first];
+    for(size_t i = first + 1 ; i < last ; i++)
+    {
+      lb = std::min(lb, v_x[i]);
+      ub = std::max(ub, v_x[i]);
+    }
+
+    return Interval(lb, ub);
+  }
+
+  void TrajectoryRangeIndex::build(const vector<double>& v_x, size_t nb_blocks)
+  {
+    m_nb_values = v_x.size();
+    m_nb_leaves = 1;
+    while(m_nb_leaves < nb_blocks)
+      m_nb_leaves *= 2;
+
+    // Unused leaves are empty
+    m_lb.assign(2 * m_nb_leaves, POS_INFINITY);
+    m_ub.assign(2 * m_nb_leaves, NEG_INFINITY);
+
+    for(size_t b = 0 ; b * BLOCK_SIZE < m_nb_values ; b++)
+    {
+      Interval h = scan(v_x, b * BLOCK_SIZE, std::min(m_nb_values, (b+1) * BLOCK_SIZE));
+      m_lb[m_nb_leaves + b] = h.lb();
+      m_ub[m_nb_leaves + b] = h.ub();
+    }
+
+    for(size_t i = m_nb_leaves - 1 ; i >= 1 ; i--)
+    {
+      m_lb[i] = std::min(m_lb[2*i], m_lb[2*i+1]);
+      m_ub[i] = std::max(m_ub[2*i], m_ub[2*i+1]);
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/**
+ *  \file
+ *  TrajectoryRangeIndex class
+ * ----------------------------------------------------------------------------
+ *  \date       2026
+ *  \author     Codac Team
+ *  \copyright  Copyright 2026 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TRAJECTORYRANGEINDEX_H__
+#define __CODAC_TRAJECTORYRANGEINDEX_H__
+
+#include <vector>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  /**
+   * \class TrajectoryRangeIndex
+   * \brief Index of the extrema of the sampled values of a trajectory,
+   *        for fast hull queries over ranges of samples
+   *
+   * Values are grouped into blocks of BLOCK_SIZE samples. The bounds of the
+   * blocks are stored in a segment tree, so that the hull of any range
+   * of values is obtained in \f$\mathcal{O}(\log n)\f$, plus the linear
+   * scan of the incomplete blocks at the ends of the range.
+   *
+   * The index only refers to the values, that are not stored here:
+   * the same vector of values has to be provided to each method.
+   */
+  class TrajectoryRangeIndex
+  {
+    public:
+
+      /**
+       * \brief Creates the index of a vector of values
+       *
+       * \param v_x vector of values
+       */
+      explicit TrajectoryRangeIndex(const std::vector<double>& v_x);
+
+      /**
+       * \brief Updates the index after a value has been appended to the vector
+       *
+       * \note Amortized complexity is \f$\mathcal{O}(1)\f$ in most cases,
+       *       as the update stops at the first node already enclosing the value.
+       *
+       * \param v_x vector of values, whose last element is the new one
+       */
+      void push_back(const std::vector<double>& v_x);
+
+      /**
+       * \brief Returns the hull of the values of indices \f$[first,last)\f$
+       *
+       * \param v_x vector of values
+       * \param first index of the first value
+       * \param last index following the last value
+       * \return the hull, or an empty interval if the range is empty
+       */
+      const Interval hull(const std::vector<double>& v_x, size_t first, size_t last) const;
+
+      /**
+       * \brief Returns the hull of the values of indices \f$[first,last)\f$, by a linear scan
+       *
+       * \param v_x vector of values
+       * \param first index of the first value
+       * \param last index following the last value
+       * \return the hull, or an empty interval if the range is empty
+       */
+      static const Interval scan(const std::vector<double>& v_x, size_t first, size_t last);
+
+      static const size_t BLOCK_SIZE = 32; //!< number of values per leaf of the segment tree
+
+    protected:
+
+      /**
+       * \brief Builds the segment tree, with at least nb_blocks leaves
+       *
+       * \param v_x vector of values
+       * \param nb_blocks number of blocks to be indexed
+       */
+      void build(const std::vector<double>& v_x, size_t nb_blocks);
+
+      size_t m_nb_values = 0; //!< number of indexed values
+      size_t m_nb_leaves = 1; //!< capacity of the segment tree (power of 2)
+      std::vector<double> m_lb, m_ub; //!< bounds of the nodes (root at 1, leaves from m_nb_leaves)
+  };
+}
+
+#endif
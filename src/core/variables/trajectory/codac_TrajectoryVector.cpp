@@ -9,7 +9,10 @@
  */
 
 #include <sstream>
+#include <algorithm>
+#include <functional>
 #include "codac_TrajectoryVector.h"
+#include "codac_Exception.h"
 
 using namespace std;
 using namespace ibex;
@@ -108,6 +111,32 @@ namespace codac
       std::copy(list.begin(), list.end(), m_v_trajs);
     }
 
+    TrajectoryVector::TrajectoryVector(const Eigen::VectorXd& t, const Eigen::MatrixXd& x, bool view)
+      : TrajectoryVector(x.rows())
+    {
+      assert(x.cols() == t.size());
+      assert(adjacent_find(t.data(), t.data()+t.size(), greater_equal<double>()) == t.data()+t.size()
+        && "times must be strictly increasing");
+
+      m_shared_timebase = true;
+      m_nb_samples = t.size();
+
+      if(view)
+      {
+        m_t_view = t.data();
+        m_x_view = x.data();
+      }
+
+      else
+      {
+        m_v_t.assign(t.data(), t.data()+t.size());
+        m_v_x.assign(x.data(), x.data()+x.size()); // column-major n×N: sample after sample
+      }
+
+      compute_shared_codomain();
+      invalidate_components();
+    }
+
     TrajectoryVector::TrajectoryVector(const TrajectoryVector& traj)
     {
       *this = traj;
@@ -121,16 +150,33 @@ namespace codac
 
     const TrajectoryVector& TrajectoryVector::operator=(const TrajectoryVector& x)
     {
+      if(this == &x)
+        return *this;
+
       { // Destroying already existing components
         if(m_v_trajs)
           delete[] m_v_trajs;
       }
 
       m_n = x.size();
-      
       m_v_trajs = new Trajectory[m_n];
-      for(int i = 0 ; i < size() ; i++)
-        (*this)[i] = x[i]; // copy of each component
+      m_v_synced.reset();
+
+      m_shared_timebase = x.m_shared_timebase;
+      m_nb_samples = x.m_nb_samples;
+      // The copy owns its data, as the viewed matrices may not outlive it
+      m_v_t.assign(x.shared_times(), x.shared_times() + (m_shared_timebase ? m_nb_samples : 0));
+      m_v_x.assign(x.shared_values(), x.shared_values() + (m_shared_timebase ? m_nb_samples*m_n : 0));
+      m_t_view = nullptr;
+      m_x_view = nullptr;
+      m_v_codomain = x.m_v_codomain;
+
+      if(m_shared_timebase)
+        invalidate_components();
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          m_v_trajs[i] = x[i]; // copy of each component
 
       return *this;
     }
@@ -147,6 +193,7 @@ namespace codac
       if(n == size())
         return;
 
+      unshare_timebase();
       Trajectory *new_vec = new Trajectory[n];
 
       int i = 0;
@@ -178,14 +225,63 @@ namespace codac
     {
       assert(start_index >= 0);
       assert(start_index + subvec.size() <= size());
+      unshare_timebase();
       for(int i = 0 ; i < subvec.size() ; i++)
         (*this)[i + start_index] = subvec[i];
     }
 
+    TrajectoryVector& TrajectoryVector::share_timebase()
+    {
+      if(m_shared_timebase)
+        return *this;
+
+      assert(same_tdomain_forall_components());
+
+      // Union of the times of the components
+      vector<double> v_t;
+      for(int j = 0 ; j < size() ; j++)
+      {
+        assert(m_v_trajs[j].definition_type() == TrajDefnType::MAP_OF_VALUES);
+        const vector<double>& v_tj = m_v_trajs[j].sampled_times();
+        vector<double> v_union;
+        v_union.reserve(v_t.size() + v_tj.size());
+        set_union(v_t.begin(), v_t.end(), v_tj.begin(), v_tj.end(), back_inserter(v_union));
+        v_t.swap(v_union);
+      }
+
+      m_v_x.resize(v_t.size() * size());
+      if(!v_t.empty())
+        for(int j = 0 ; j < size() ; j++)
+        {
+          vector<double> v_xj = m_v_trajs[j].eval(v_t); // evaluation/interpolation
+          for(size_t i = 0 ; i < v_t.size() ; i++)
+            m_v_x[i*size()+j] = v_xj[i];
+        }
+
+      m_v_t.swap(v_t);
+      m_nb_samples = m_v_t.size();
+      m_shared_timebase = true;
+      compute_shared_codomain();
+
+      for(int j = 0 ; j < size() ; j++)
+        m_v_trajs[j] = Trajectory(); // components will be built on demand
+      invalidate_components();
+      return *this;
+    }
+
+    bool TrajectoryVector::shared_timebase() const
+    {
+      return m_shared_timebase;
+    }
+
     // Accessing values
 
     const Interval TrajectoryVector::tdomain() const
     {
+      if(m_shared_timebase)
+        return m_nb_samples == 0 ? Interval::EMPTY_SET
+          : Interval(shared_times()[0], shared_times()[m_nb_samples-1]);
+
       return (*this)[0].tdomain();
     }
 
@@ -194,15 +290,32 @@ namespace codac
       return codomain_box();
     }
 
+    Eigen::Map<const Eigen::VectorXd> TrajectoryVector::sampled_times() const
+    {
+      assert(m_shared_timebase);
+      return Eigen::Map<const Eigen::VectorXd>(shared_times(), m_nb_samples);
+    }
+
+    Eigen::Map<const Eigen::MatrixXd> TrajectoryVector::sampled_values() const
+    {
+      assert(m_shared_timebase);
+      return Eigen::Map<const Eigen::MatrixXd>(shared_values(), size(), m_nb_samples);
+    }
+
     Trajectory& TrajectoryVector::operator[](int index)
     {
       assert(index >= 0 && index < size());
+
+      if(m_shared_timebase) // the component may be modified, while the values are shared
+        throw Exception(__func__, "components of a shared time base cannot be modified, see unshare_timebase()");
+
       return const_cast<Trajectory&>(static_cast<const TrajectoryVector&>(*this).operator[](index));
     }
 
     const Trajectory& TrajectoryVector::operator[](int index) const
     {
       assert(index >= 0 && index < size());
+      synchronize_component(index); // only the accessed component is built
       return m_v_trajs[index];
     }
 
@@ -210,6 +323,21 @@ namespace codac
     {
       assert(tdomain().contains(t));
       Vector v(size());
+
+      if(m_shared_timebase) // one search for all the components
+      {
+        const double *v_t = shared_times(), *v_x = shared_values();
+        size_t i = upper_bound(v_t, v_t+m_nb_samples, t) - v_t;
+        i = (i == 0 ? 0 : i-1);
+        size_t k = std::min(i+1, m_nb_samples-1);
+
+        // Linear interpolation, as done by Trajectory
+        double dt = v_t[k] - v_t[i];
+        for(int j = 0 ; j < size() ; j++)
+          v[j] = v_x[i*size()+j] + (t - v_t[i]) * (v_x[k*size()+j] - v_x[i*size()+j]) / (dt > 0. ? dt : 1.);
+        return v;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i](t);
       return v;
@@ -219,6 +347,35 @@ namespace codac
     {
       assert(tdomain().is_superset(t));
       IntervalVector v(size());
+
+      if(m_shared_timebase)
+      {
+        const double *v_t = shared_times(), *v_x = shared_values();
+        size_t first = lower_bound(v_t, v_t+m_nb_samples, t.lb()) - v_t;
+        size_t last = upper_bound(v_t+first, v_t+m_nb_samples, t.ub()) - v_t;
+
+        // Extrema of each column over the samples of the range,
+        // the values being contiguous sample after sample
+        Vector lb((*this)(t.lb())), ub(lb);
+        const Vector x_ub = (*this)(t.ub());
+        for(int j = 0 ; j < size() ; j++)
+        {
+          lb[j] = std::min(lb[j], x_ub[j]);
+          ub[j] = std::max(ub[j], x_ub[j]);
+        }
+
+        for(size_t i = first ; i < last ; i++)
+          for(int j = 0 ; j < size() ; j++)
+          {
+            lb[j] = std::min(lb[j], v_x[i*size()+j]);
+            ub[j] = std::max(ub[j], v_x[i*size()+j]);
+          }
+
+        for(int j = 0 ; j < size() ; j++)
+          v[j] = Interval(lb[j], ub[j]);
+        return v;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i](t);
       return v;
@@ -226,6 +383,12 @@ namespace codac
     
     const Vector TrajectoryVector::first_value() const
     {
+      if(m_shared_timebase)
+      {
+        assert(m_nb_samples > 0);
+        return Vector(size(), const_cast<double*>(shared_values()));
+      }
+
       Vector v(size());
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i].first_value();
@@ -234,6 +397,12 @@ namespace codac
 
     const Vector TrajectoryVector::last_value() const
     {
+      if(m_shared_timebase)
+      {
+        assert(m_nb_samples > 0);
+        return Vector(size(), const_cast<double*>(shared_values() + (m_nb_samples-1)*size()));
+      }
+
       Vector v(size());
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i].last_value();
@@ -244,6 +413,9 @@ namespace codac
 
     bool TrajectoryVector::not_defined() const
     {
+      if(m_shared_timebase)
+        return m_nb_samples == 0;
+
       for(int i = 0 ; i < size() ; i++)
         if((*this)[i].not_defined())
           return true;
@@ -281,6 +453,41 @@ namespace codac
       }
 
       assert(size() == y.size());
+
+      if(m_shared_timebase)
+      {
+        own_shared_data();
+        invalidate_components();
+        const size_t n = size();
+
+        if(m_v_t.empty() || t > m_v_t.back()) // values mostly set by increasing times
+        {
+          m_v_t.push_back(t);
+          for(size_t j = 0 ; j < n ; j++)
+          {
+            m_v_x.push_back(y[j]);
+            m_v_codomain[j] |= y[j];
+          }
+        }
+
+        else
+        {
+          size_t i = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+          if(m_v_t[i] != t)
+          {
+            m_v_t.insert(m_v_t.begin()+i, t);
+            m_v_x.insert(m_v_x.begin()+i*n, n, 0.);
+          }
+
+          for(size_t j = 0 ; j < n ; j++)
+            m_v_x[i*n+j] = y[j];
+          compute_shared_codomain(); // the new codomain may be a subset of the old one
+        }
+
+        m_nb_samples = m_v_t.size();
+        return;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].set(y[i], t);
     }
@@ -289,6 +496,7 @@ namespace codac
     {
       assert(valid_tdomain(t));
       assert(tdomain().is_superset(t));
+      unshare_timebase();
       for(int i = 0 ; i < size() ; i++)
         if(!(*this)[i].not_defined())
           (*this)[i].truncate_tdomain(t);
@@ -297,6 +505,15 @@ namespace codac
 
     TrajectoryVector& TrajectoryVector::shift_tdomain(double shift_ref)
     {
+      if(m_shared_timebase) // the single time axis is shifted
+      {
+        own_shared_data();
+        invalidate_components();
+        for(auto& t : m_v_t)
+          t += shift_ref;
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].shift_tdomain(shift_ref);
       return *this;
@@ -304,6 +521,9 @@ namespace codac
     
     bool TrajectoryVector::same_tdomain_forall_components() const
     {
+      if(m_shared_timebase)
+        return true;
+
       for(int i = 1 ; i < size() ; i++)
         if((*this)[i].tdomain() != (*this)[0].tdomain())
           return false;
@@ -312,6 +532,7 @@ namespace codac
 
     TrajectoryVector& TrajectoryVector::sample(double dt)
     {
+      unshare_timebase();
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(dt);
       return *this;
@@ -319,6 +540,7 @@ namespace codac
 
     TrajectoryVector& TrajectoryVector::sample(const Trajectory& x)
     {
+      unshare_timebase();
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x);
       return *this;
@@ -327,6 +549,7 @@ namespace codac
     TrajectoryVector& TrajectoryVector::sample(const TrajectoryVector& x)
     {
       assert(size() == x.size());
+      unshare_timebase();
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x[i]);
       return *this;
@@ -334,6 +557,7 @@ namespace codac
 
     TrajectoryVector& TrajectoryVector::make_continuous()
     {
+      unshare_timebase();
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].make_continuous();
       return *this;
@@ -389,7 +613,94 @@ namespace codac
     {
       IntervalVector box(size(), Interval::EMPTY_SET);
       for(int i = 0 ; i < size() ; i++)
-        box[i] |= (*this)[i].codomain();
+        box[i] |= m_shared_timebase ? m_v_codomain[i] : (*this)[i].codomain();
       return box;
     }
+
+    const double* TrajectoryVector::shared_times() const
+    {
+      return m_t_view ? m_t_view : m_v_t.data();
+    }
+
+    const double* TrajectoryVector::shared_values() const
+    {
+      return m_x_view ? m_x_view : m_v_x.data();
+    }
+
+    void TrajectoryVector::own_shared_data()
+    {
+      if(m_t_view)
+      {
+        m_v_t.assign(m_t_view, m_t_view + m_nb_samples);
+        m_v_x.assign(m_x_view, m_x_view + m_nb_samples*size());
+        m_t_view = nullptr;
+        m_x_view = nullptr;
+      }
+    }
+
+    void TrajectoryVector::compute_shared_codomain()
+    {
+      const double *v_x = shared_values();
+      m_v_codomain.assign(size(), Interval::EMPTY_SET);
+      for(size_t i = 0 ; i < m_nb_samples ; i++)
+        for(int j = 0 ; j < size() ; j++)
+          m_v_codomain[j] |= v_x[i*size()+j];
+    }
+
+    void TrajectoryVector::synchronize_component(int index) const
+    {
+      if(!m_shared_timebase || m_v_synced[index])
+        return;
+
+      lock_guard<mutex> lock(m_components_mutex);
+      if(m_v_synced[index]) // the component may have been built by another thread meanwhile
+        return;
+
+      const double *v_t = shared_times(), *v_x = shared_values();
+      m_v_trajs[index] = Trajectory();
+      for(size_t i = 0 ; i < m_nb_samples ; i++)
+        m_v_trajs[index].set(v_x[i*size()+index], v_t[i]); // values appended by increasing times
+
+      m_v_synced[index] = true;
+    }
+
+    void TrajectoryVector::invalidate_components()
+    {
+      if(!m_v_synced)
+      {
+        m_v_synced.reset(new atomic<bool>[size()]());
+        return;
+      }
+
+      for(int j = 0 ; j < size() ; j++)
+        if(m_v_synced[j])
+        {
+          m_v_trajs[j] = Trajectory(); // memory is released
+          m_v_synced[j] = false;
+        }
+    }
+
+    bool TrajectoryVector::same_shared_times(const double *v_t, size_t n) const
+    {
+      assert(m_shared_timebase);
+      return n == m_nb_samples && equal(v_t, v_t+n, shared_times());
+    }
+
+    void TrajectoryVector::unshare_timebase()
+    {
+      if(!m_shared_timebase)
+        return;
+
+      for(int j = 0 ; j < size() ; j++)
+        synchronize_component(j);
+      m_shared_timebase = false;
+      m_v_synced.reset();
+
+      m_nb_samples = 0;
+      m_v_t = vector<double>();
+      m_v_x = vector<double>();
+      m_t_view = nullptr;
+      m_x_view = nullptr;
+      m_v_codomain.clear();
+    }
 }
\ No newline at end of file
@@ -14,7 +14,12 @@
 
 #include <map>
 #include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include <initializer_list>
+#include <Eigen/Core>
 #include "codac_Vector.h"
 #include "codac_Interval.h"
 #include "codac_TFunction.h"
@@ -32,6 +37,11 @@ namespace codac
    * \class TrajectoryVector
    * \brief n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$, defined as a temporal map of vector values
    *
+   * Components are either independent Trajectory objects, or share a single
+   * time axis (shared time base). In the latter case, the vector values are
+   * stored contiguously sample after sample, and the components are only
+   * built on demand.
+   *
    * \note Use Trajectory for the one-dimensional case
    */
   class TrajectoryVector : public DynamicalItem
@@ -97,6 +107,37 @@ namespace codac
        */
       TrajectoryVector(std::initializer_list<Trajectory> list);
 
+      /**
+       * \brief Creates a n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$ sharing a single time axis,
+       *        from the values of an Eigen matrix
+       *
+       * \note If the values are viewed, no copy is made: the matrices must then outlive
+       *       this trajectory, and must not be resized meanwhile. Copies of this trajectory,
+       *       and the trajectory itself as soon as its values are set, own a copy of the data.
+       *       The codomain is computed at construction, and is not updated if the
+       *       matrices are modified afterwards.
+       *
+       * \param t vector of N sorted times \f$t_i\f$
+       * \param x matrix of size n×N, the ith column being the vector value \f$\mathbf{x}(t_i)\f$
+       * \param view if true, the data of the matrices is used directly (false by default)
+       */
+      TrajectoryVector(const Eigen::VectorXd& t, const Eigen::MatrixXd& x, bool view = false);
+
+      /**
+       * \brief Temporary matrices cannot be viewed, as they would not outlive the trajectory
+       */
+      TrajectoryVector(Eigen::VectorXd&& t, Eigen::MatrixXd&& x, bool view) = delete;
+
+      /**
+       * \brief Temporary matrices cannot be viewed, as they would not outlive the trajectory
+       */
+      TrajectoryVector(const Eigen::VectorXd& t, Eigen::MatrixXd&& x, bool view) = delete;
+
+      /**
+       * \brief Temporary matrices cannot be viewed, as they would not outlive the trajectory
+       */
+      TrajectoryVector(Eigen::VectorXd&& t, const Eigen::MatrixXd& x, bool view) = delete;
+
       /**
        * \brief Creates a copy of a n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$
        *
@@ -145,6 +186,8 @@ namespace codac
        * \note If the size is increased, the existing components are not
        *       modified and the new ones are set to empty trajectories
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \param n the new size to be set
        */
       void resize(int n);
@@ -161,11 +204,44 @@ namespace codac
       /**
        * \brief Puts a subvector into this TrajectoryVector at a given position
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \param start_index position where the subvector will be put
        * \param subvec the TrajectoryVector to put from start_index
        */
       void put(int start_index, const TrajectoryVector& subvec);
 
+      /**
+       * \brief Makes all the components share a single time axis
+       *
+       * \note Each component is sampled at the times of the other components,
+       *       if the samplings are different.
+       *
+       * \note The components must be defined as maps of values, over the same tdomain
+       *
+       * \return a reference to this trajectory
+       */
+      TrajectoryVector& share_timebase();
+
+      /**
+       * \brief Tests whether the components share a single time axis
+       *
+       * \return true in case of a shared time base
+       */
+      bool shared_timebase() const;
+
+      /**
+       * \brief Turns a shared time base into independent components
+       *
+       * \note This has to be called before modifying the components through
+       *       the non-const operator[]. Methods that modify all the components
+       *       (resize, put, truncate_tdomain, sample, make_continuous) also
+       *       call it. shift_tdomain, and the assignment operators involving
+       *       scalars, vectors or trajectories of same sampling, are processed
+       *       on the shared values.
+       */
+      void unshare_timebase();
+
       /// @}
       /// \name Accessing values
       /// @{
@@ -177,9 +253,31 @@ namespace codac
        */
       const IntervalVector codomain() const;
 
+      /**
+       * \brief Returns the sorted times of the samples, in case of a shared time base
+       *
+       * \note No copy is made
+       *
+       * \return a read-only Eigen view of the N times \f$t_i\f$
+       */
+      Eigen::Map<const Eigen::VectorXd> sampled_times() const;
+
+      /**
+       * \brief Returns the values of the samples, in case of a shared time base
+       *
+       * \note No copy is made
+       *
+       * \return a read-only Eigen view of size n×N, the ith column being \f$\mathbf{x}(t_i)\f$
+       */
+      Eigen::Map<const Eigen::MatrixXd> sampled_values() const;
+
       /**
        * \brief Returns the ith Trajectory of this TrajectoryVector
        *
+       * \note In case of a shared time base, an exception is thrown since the
+       *       returned component may be modified: call unshare_timebase() first,
+       *       or use the const operator[] for read-only accesses.
+       *
        * \param index the index of this ith component
        * \return a reference to the ith component
        */
@@ -188,6 +286,9 @@ namespace codac
       /**
        * \brief Returns a const reference to the ith Trajectory of this TrajectoryVector
        *
+       * \note In case of a shared time base, the ith component is built at its first
+       *       access, and kept until the values are updated
+       *
        * \param index the index of this ith component
        * \return a const reference to the ith component
        */
@@ -271,6 +372,8 @@ namespace codac
       /**
        * \brief Truncates the tdomain of \f$\mathbf{x}(\cdot)\f$
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \note The new tdomain must be a subset of the old one
        *
        * \param tdomain new temporal domain \f$[t_0,t_f]\f$
@@ -300,6 +403,8 @@ namespace codac
       /**
        * \brief Transforms an analytic trajectory as a map of values
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \note Sampling only available for trajectories firstly defined as analytic functions
        *
        * \param timestep sampling value \f$\delta\f$ for the temporal discretization (double)
@@ -310,6 +415,8 @@ namespace codac
       /**
        * \brief Samples this trajectory so that it will share the same sampling of \f$x(\cdot)\f$
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \note If the trajectory is defined as an analytic function, then the object is
        *       transformed into a map of values and the TFunction object is deleted.
        *
@@ -323,6 +430,8 @@ namespace codac
       /**
        * \brief Samples this trajectory so that it will share the same sampling of \f$\mathbf{x}(\cdot)\f$
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \note If the trajectory is defined as an analytic function, then the object is
        *       transformed into a map of values and the TFunction object is deleted.
        *
@@ -336,6 +445,8 @@ namespace codac
       /**
        * \brief Makes a trajectory continuous by avoiding infinite slopes
        *
+       * \note In case of a shared time base, the components become independent
+       *
        * \note This is mainly used when angles are expressed between \f$[-\pi,\pi]\f$,
        *       which produces troublesome discontinuities. For instance, a tube directly
        *       built from such discontinuous trajectory will be made of very large slices,
@@ -525,11 +636,87 @@ namespace codac
        */
       const IntervalVector codomain_box() const;
 
+      /**
+       * \brief Returns a pointer to the N shared times
+       *
+       * \return the viewed data, or the data owned by this object
+       */
+      const double* shared_times() const;
+
+      /**
+       * \brief Returns a pointer to the n×N shared values, stored sample after sample
+       *
+       * \return the viewed data, or the data owned by this object
+       */
+      const double* shared_values() const;
+
+      /**
+       * \brief Copies the viewed data, before a modification of the values
+       */
+      void own_shared_data();
+
+      /**
+       * \brief Computes the codomains of the components from the shared values
+       */
+      void compute_shared_codomain();
+
+      /**
+       * \brief Builds a component from the shared values, if it is not up to date
+       *
+       * \param index the index of the component
+       */
+      void synchronize_component(int index) const;
+
+      /**
+       * \brief Clears the components built from the shared values, after their update
+       */
+      void invalidate_components();
+
+      /**
+       * \brief Tests whether the shared time axis is also the one of a given sampling
+       *
+       * \param v_t pointer to the sorted times of the sampling
+       * \param n number of times
+       * \return true in case of identical times
+       */
+      bool same_shared_times(const double *v_t, size_t n) const;
+
+      /**
+       * \brief Applies an operation to each shared value
+       *
+       * \param f function of the value \f$x_j(t_i)\f$ and of the indexes \f$(i,j)\f$,
+       *        returning the new value
+       */
+      template<typename F>
+      void transform_shared_values(const F& f)
+      {
+        assert(m_shared_timebase);
+        own_shared_data();
+        invalidate_components();
+        const size_t n = size();
+        for(size_t i = 0 ; i < m_nb_samples ; i++)
+          for(size_t j = 0 ; j < n ; j++)
+            m_v_x[i*n+j] = f(m_v_x[i*n+j], i, j);
+        compute_shared_codomain();
+      }
+
       // Class variables:
 
         int m_n = 0; //!< dimension of this trajectory
         Trajectory *m_v_trajs = nullptr; //!< array of components (scalar trajectories)
 
+        // Shared time base:
+
+        bool m_shared_timebase = false; //!< true if the components share a single time axis
+        size_t m_nb_samples = 0; //!< number N of shared times
+        std::vector<double> m_v_t; //!< shared times, if owned
+        std::vector<double> m_v_x; //!< shared values, if owned: \f$x_j(t_i)\f$ stored at index \f$i\cdot n+j\f$
+        const double *m_t_view = nullptr; //!< viewed times, if not owned
+        const double *m_x_view = nullptr; //!< viewed values, if not owned
+        std::vector<Interval> m_v_codomain; //!< codomains of the components
+        mutable std::unique_ptr<std::atomic<bool>[]> m_v_synced; //!< for each component, true if it is built from the shared values
+        mutable std::mutex m_components_mutex; //!< protects the construction of the components
+
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
       friend class TubeVector; // for TubeVector::deserialize method
   };
@@ -17,12 +17,18 @@ using namespace ibex;
 
 namespace codac
 {
-  #define macro_assign_vect_vect(f) \
+  #define macro_assign_vect_vect(f, op) \
     \
     const TrajectoryVector& TrajectoryVector::f(const Vector& x) \
     { \
       assert(size() == x.size()); \
       \
+      if(m_shared_timebase) /* processed on the shared values */ \
+      { \
+        transform_shared_values([&x](double v, size_t, size_t j) { return v op x[j]; }); \
+        return *this; \
+      } \
+      \
       for(int i = 0 ; i < size() ; i++) \
         (*this)[i].f(x[i]); \
       return *this; \
@@ -33,16 +39,32 @@ namespace codac
       assert(size() == x.size()); \
       assert(tdomain() == x.tdomain()); \
       \
+      if(m_shared_timebase && x.m_shared_timebase \
+        && same_shared_times(x.shared_times(), x.m_nb_samples)) /* processed on the shared values */ \
+      { \
+        const double *v_x = x.shared_values(); \
+        const size_t n = size(); \
+        transform_shared_values([v_x,n](double v, size_t i, size_t j) { return v op v_x[i*n+j]; }); \
+        return *this; \
+      } \
+      \
+      unshare_timebase(); /* the samplings may be different */ \
       for(int i = 0 ; i < size() ; i++) \
         (*this)[i].f(x[i]); \
       return *this; \
     } \
     \
 
-  #define macro_assign_vect_scal(f) \
+  #define macro_assign_vect_scal(f, op) \
     \
     const TrajectoryVector& TrajectoryVector::f(double x) \
     { \
+      if(m_shared_timebase) /* processed on the shared values */ \
+      { \
+        transform_shared_values([x](double v, size_t, size_t) { return v op x; }); \
+        return *this; \
+      } \
+      \
       for(int i = 0 ; i < size() ; i++) \
         (*this)[i].f(x); \
       return *this; \
@@ -52,16 +74,25 @@ namespace codac
     { \
       assert(tdomain() == x.tdomain()); \
       \
+      if(m_shared_timebase && x.definition_type() == TrajDefnType::MAP_OF_VALUES \
+        && same_shared_times(x.sampled_times().data(), x.sampled_times().size())) /* processed on the shared values */ \
+      { \
+        const double *v_x = x.sampled_values().data(); \
+        transform_shared_values([v_x](double v, size_t i, size_t) { return v op v_x[i]; }); \
+        return *this; \
+      } \
+      \
+      unshare_timebase(); /* the samplings may be different */ \
       for(int i = 0 ; i < size() ; i++) \
         (*this)[i].f(x); \
       return *this; \
     } \
     \
 
-  macro_assign_vect_vect(operator+=);
-  macro_assign_vect_vect(operator-=);
-  macro_assign_vect_scal(operator+=);
-  macro_assign_vect_scal(operator-=);
-  macro_assign_vect_scal(operator*=);
-  macro_assign_vect_scal(operator/=);
-}
\ No newline at end of file
+  macro_assign_vect_vect(operator+=, +);
+  macro_assign_vect_vect(operator-=, -);
+  macro_assign_vect_scal(operator+=, +);
+  macro_assign_vect_scal(operator-=, -);
+  macro_assign_vect_scal(operator*=, *);
+  macro_assign_vect_scal(operator/=, /);
+}
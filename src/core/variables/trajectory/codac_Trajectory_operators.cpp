@@ -22,8 +22,9 @@ namespace codac
       assert(definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      for(auto& kv : m_map_values) \
-        m_map_values[kv.first] = kv.second f x; \
+      for(auto& v : m_v_x) \
+        v = v f x; \
+      invalidate_samples_cache(); \
       m_codomain.fdef(x); \
       return *this; \
     } \
@@ -38,11 +39,13 @@ namespace codac
       if(definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x_sampled.sample(*this); \
       \
-      map<double,double> new_map; \
-      for(auto const& it : x_sampled.sampled_map()) \
-        new_map[it.first] = (*this)(it.first) f it.second; \
+      vector<double> v_x = eval(x_sampled.m_v_t); \
+      for(size_t i = 0 ; i < v_x.size() ; i++) \
+        v_x[i] = v_x[i] f x_sampled.m_v_x[i]; \
       \
-      m_map_values = new_map; \
+      m_v_t = x_sampled.m_v_t; \
+      m_v_x.swap(v_x); \
+      invalidate_samples_cache(); \
       compute_codomain(); \
       return *this; \
     } \
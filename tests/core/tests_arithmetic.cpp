@@ -1,6 +1,9 @@
 #include "catch_interval.hpp"
 #include "codac_tube_arithmetic.h"
 #include "codac_traj_arithmetic.h"
+#include "codac_tube_expr.h"
+#include "codac_interval_kernels.h"
+#include "codac_TFunction.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -530,6 +533,89 @@ TEST_CASE("Arithmetic on tubes")
     CHECK(ApproxIntv(z[0].codomain()) == Interval::EMPTY_SET); CHECK(ApproxIntv(z[1].codomain()) == a1); CHECK(ApproxIntv(z[2].codomain()) == a2); 
 
   }
+
+  SECTION("Tests lazy expressions")
+  {
+    Tube x(Interval(0.,10.), 0.1, TFunction("cos(t)"));
+    Tube y(Interval(0.,10.), 0.1, TFunction("sin(t)"));
+
+    Tube z = sqrt(sqr(lazy(x)) + sqr(lazy(y)));
+    CHECK(z == sqrt(sqr(x) + sqr(y)));
+    CHECK(z.codomain().is_superset(Interval(1.)));
+
+    Tube w = atan2(lazy(y), x) * 2. - Interval(1.);
+    CHECK(w == atan2(y, x) * 2. - Interval(1.));
+
+    w = -pow(lazy(x), 2) + min(lazy(y), 0.5) | lazy(x) & Interval(0.,1.);
+    CHECK(w == ((-pow(x, 2) + min(y, Interval(0.5))) | (x & Interval(0.,1.))));
+
+    Tube z_copy(z);
+    z = lazy(z) * 2. + lazy(x); // in place, z is involved in the expression
+    CHECK(z == z_copy * 2. + x);
+    CHECK(Tube::same_slicing(z, x));
+
+    Tube u(Interval(0.,10.), 1.); // other slicing, replaced
+    u = exp(lazy(x));
+    CHECK(u == exp(x));
+
+    Tube v(Interval(0.,10.), 1.);
+    CHECK_THROWS(u = lazy(x) + lazy(v));
+  }
+
+  SECTION("Tests bulk interval operations")
+  {
+    vector<Interval> v_x = { Interval(-0.1,1./3.), Interval(1./7.,2.3), Interval(-5.7,-1./3.),
+      Interval(0.), Interval(1e308,1.7e308), Interval(-1.,0.), Interval(0.,1.),
+      Interval::EMPTY_SET, Interval::ALL_REALS, Interval(-1.,POS_INFINITY), Interval(1./3.),
+      Interval(-2.1,-0.7), Interval(3.1,3.3) };
+
+    // All the pairs of intervals, on arrays larger than the SIMD packs
+    size_t n = v_x.size() * v_x.size();
+    IntervalArray x(n), y(n), z;
+    for(size_t i = 0 ; i < n ; i++)
+    {
+      x.set(i, v_x[i % v_x.size()] * (1. + i / 1000.));
+      y.set(i, v_x[i / v_x.size()]);
+    }
+
+    bulk_add(x, y, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) + y.get(i));
+    bulk_sub(x, y, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) - y.get(i));
+    bulk_mul(x, y, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) * y.get(i));
+    bulk_div(x, y, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) / y.get(i));
+    bulk_sqr(x, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == sqr(x.get(i)));
+    bulk_sqrt(x, z);
+    for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == sqrt(x.get(i)));
+
+    IntervalArray w(x); // in place
+    bulk_mul(w, y, w);
+    for(size_t i = 0 ; i < n ; i++) CHECK(w.get(i) == x.get(i) * y.get(i));
+
+    for(const auto& a : v_x) // interval operands
+    {
+      bulk_add(x, a, z);
+      for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) + a);
+      bulk_sub(a, x, z);
+      for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == a - x.get(i));
+      bulk_mul(x, a, z);
+      for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == x.get(i) * a);
+      bulk_div(a, x, z);
+      for(size_t i = 0 ; i < n ; i++) CHECK(z.get(i) == a / x.get(i));
+    }
+
+    Tube a(Interval(0.,10.), 0.1, TFunction("cos(t)")), b(Interval(0.,10.), 0.1, TFunction("t"));
+    Tube c = a * b + Interval(1.);
+    for(const Slice *s = c.first_slice(), *s_a = a.first_slice(), *s_b = b.first_slice() ; s ;
+        s = s->next_slice(), s_a = s_a->next_slice(), s_b = s_b->next_slice())
+    {
+      CHECK(s->codomain() == s_a->codomain() * s_b->codomain() + Interval(1.));
+      CHECK(s->input_gate() == s_a->input_gate() * s_b->input_gate() + Interval(1.));
+    }
+  }
 }
 
 
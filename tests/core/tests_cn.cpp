@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include "catch_interval.hpp"
 #include "codac_Variable.h"
 #include "codac_ContractorNetwork.h"
@@ -166,6 +169,196 @@ TEST_CASE("CN simple")
     cn.contract();
   }
 
+  SECTION("Slices shared by several CNs")
+  {
+    double dt = 5.;
+    Interval domain(0.,20.);
+    Tube x(domain, dt, Interval(-10.,10.)), v(domain, dt, Interval(0.));
+
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_f(Function("x", "xdot", "xdot+sin(x)"));
+
+    ContractorNetwork cn1, cn2;
+    cn1.add(ctc_deriv, {x, v});
+    cn2.add(ctc_deriv, {x, v});
+    cn1.add(ctc_f, {x, v});
+    cn2.add(ctc_f, {x, v});
+    cn1.add(ctc_f, {x, v}); // redundant contractors that should not be added
+    cn2.add(ctc_deriv, {x, v});
+
+    CHECK(cn1.nb_ctc() == 16);
+    CHECK(cn1.nb_dom() == 10);
+    CHECK(cn2.nb_ctc() == 16);
+    CHECK(cn2.nb_dom() == 10);
+
+    {
+      ContractorNetwork cn3;
+      cn3.add(ctc_f, {x, v});
+      CHECK(cn3.nb_dom() == 10);
+    }
+
+    cn1.add(ctc_f, {x, v});
+    CHECK(cn1.nb_ctc() == 16);
+    CHECK(cn1.nb_dom() == 10);
+
+    cn1.contract();
+    cn2.contract();
+  }
+
+  SECTION("Scheduling by expected gain")
+  {
+    double dt = 0.05;
+    Interval tdomain(0.,20.);
+
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_f(Function("x", "xdot", "xdot+sin(x)"));
+
+    vector<TubeVector> v_x;
+    for(auto policy : { ContractorNetwork::SchedulingPolicy::QUEUE, ContractorNetwork::SchedulingPolicy::EXPECTED_GAIN })
+    {
+      TubeVector x(tdomain, dt, 2);
+      x[0].set(Interval(-10.,10.));
+      x[0].set(Interval(1.), 0.);
+
+      ContractorNetwork cn;
+      cn.set_scheduling_policy(policy);
+      cn.set_fixedpoint_ratio(0.); // propagation up to the fixed point
+      CHECK(cn.scheduling_policy() == policy);
+      cn.add(ctc_deriv, {x[0], x[1]});
+      cn.add(ctc_f, {x[0], x[1]});
+
+      cn.contract_during(0.); // contractors remain active
+      CHECK(cn.nb_ctc_in_stack() > 0);
+      cn.contract();
+      CHECK(cn.nb_ctc_in_stack() == 0);
+      v_x.push_back(x);
+    }
+
+    // Same fixed point, whatever the order of the contractions
+    for(int i = 0 ; i < 2 ; i++)
+      CHECK(v_x[1][i] == v_x[0][i]);
+  }
+
+  SECTION("Profiling")
+  {
+    double dt = 0.5;
+    Interval tdomain(0.,20.);
+
+    TubeVector x(tdomain, dt, 2);
+    x[0].set(Interval(-10.,10.));
+    x[0].set(Interval(1.), 0.);
+
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_f(Function("x", "xdot", "xdot+sin(x)"));
+
+    ContractorNetwork cn;
+    CHECK_FALSE(cn.profiling_enabled());
+    cn.enable_profiling();
+    CHECK(cn.profiling_enabled());
+    cn.add(ctc_deriv, {x[0], x[1]});
+    cn.add(ctc_f, {x[0], x[1]});
+    cn.set_name(ctc_f, "f");
+    cn.contract();
+
+    ostringstream os;
+    cn.print_profiling(os, 5);
+    CHECK(os.str().find("Profiling of " + std::to_string(cn.nb_ctc()) + " contractors") == 0);
+
+    string filename = "profiling.csv";
+    cn.export_profiling(filename);
+    ifstream csv_file(filename);
+    string line;
+    getline(csv_file, line);
+    CHECK(line == "id,contractor,nb_calls,time,contraction,nb_triggers");
+    int nb_lines = 0, nb_calls = 0;
+    while(getline(csv_file, line))
+    {
+      nb_lines++;
+      nb_calls += std::stoi(line.substr(line.find("\",") + 2));
+    }
+    csv_file.close();
+    remove(filename.c_str());
+    CHECK(nb_lines == cn.nb_ctc());
+    CHECK(nb_calls > 0);
+
+    filename = "profiling.json";
+    cn.export_profiling(filename);
+    ifstream json_file(filename);
+    getline(json_file, line);
+    CHECK(line == "[");
+    getline(json_file, line);
+    CHECK(line.find("{\"id\": ") != string::npos);
+    json_file.close();
+    remove(filename.c_str());
+
+    CHECK_THROWS(cn.export_profiling("profiling.txt"));
+  }
+
+  SECTION("Parallel propagation")
+  {
+    double dt = 0.05;
+    Interval tdomain(0.,20.);
+
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_f(Function("x", "xdot", "xdot+sin(x)"));
+
+    vector<TubeVector> v_x;
+    for(int nb_threads : { 1, 2, 4 })
+    {
+      TubeVector x(tdomain, dt, 2);
+      x[0].set(Interval(-10.,10.));
+      x[0].set(Interval(1.), 0.);
+
+      ContractorNetwork cn;
+      cn.set_nb_threads(nb_threads);
+      cn.set_fixedpoint_ratio(0.); // propagation up to the fixed point
+      CHECK(cn.nb_threads() == nb_threads);
+      cn.add(ctc_deriv, {x[0], x[1]});
+      cn.add(ctc_f, {x[0], x[1]});
+      cn.contract();
+
+      CHECK(cn.nb_ctc_in_stack() == 0);
+      v_x.push_back(x);
+    }
+
+    // Same fixed point whatever the number of threads,
+    // and the same as the sequential propagation
+    for(int i = 0 ; i < 2 ; i++)
+    {
+      CHECK(v_x[1][i] == v_x[0][i]);
+      CHECK(v_x[2][i] == v_x[0][i]);
+    }
+  }
+
+  SECTION("Parallel propagation with a sampling of tubes")
+  {
+    CtcDeriv ctc_deriv;
+    CtcEval ctc_eval;
+    ctc_eval.preserve_slicing(false);
+
+    vector<Tube> v_x;
+    for(int nb_threads : { 1, 4 })
+    {
+      Tube x(Interval(0.,20.), 1., Interval(-10.,10.)), v(Interval(0.,20.), 1., Interval(-1.,1.));
+      Interval t1(5.5), z1(2.), t2(12.5), z2(-3.); // times between two gates
+
+      ContractorNetwork cn;
+      cn.set_nb_threads(nb_threads);
+      cn.set_fixedpoint_ratio(0.);
+      cn.add(ctc_deriv, {x, v});
+      cn.add(ctc_eval, {t1, z1, x, v});
+      cn.add(ctc_eval, {t2, z2, x, v});
+      cn.contract(); // footprints computed again after the samplings
+
+      CHECK(x.nb_slices() == 22);
+      CHECK(x(5.5) == Interval(2.));
+      CHECK(x(12.5) == Interval(-3.));
+      v_x.push_back(x);
+    }
+
+    CHECK(v_x[1] == v_x[0]);
+  }
+
   SECTION("CtcFunction on scalar or vector cases")
   {
     CtcFunction ctc_add(Function("b", "c", "a", "b+c-a"));
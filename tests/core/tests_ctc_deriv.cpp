@@ -395,4 +395,35 @@ TEST_CASE("CtcDeriv")
     CHECK(x.interpol(Interval(1.), v) == Interval(-1.));
     CHECK(x.interpol(Interval(-1.,3.), v) == Interval(-3.,1.));
   }
-}
\ No newline at end of file
+
+  SECTION("Test fused fwd/bwd sweep")
+  {
+    Tube x(Interval(0.,26.), 1., Interval(-10.,10.));
+    x.set(Interval(2.,3.), 0.);
+    x.set(Interval(1.), 8.);
+    x.set(Interval(5.5), 14.);
+    x.set(Interval(-1.,0.), 26.);
+    Tube v(x);
+    v.set(Interval(-1.,1.));
+    v.set(Interval(-0.75,-0.5), 3);
+    v.set(Interval(0.5,2.), 10);
+    v.set(Interval(NEG_INFINITY,-0.5), 20);
+
+    Tube x_fused(x);
+    CtcDeriv ctc, ctc_fused;
+    ctc_fused.set_fused_sweep();
+    ctc.contract(x, v);
+    ctc_fused.contract(x_fused, v);
+    CHECK(x_fused == x);
+
+    // Components walked in lockstep
+    TubeVector x_vect(2, x_fused), v_vect(2, v);
+    x_vect[1] = Tube(Interval(0.,26.), 1., Interval(-10.,10.));
+    x_vect[1].set(Interval(0.), 0.);
+    Tube x1(x_vect[1]);
+    ctc_fused.contract(x_vect, v_vect);
+    ctc.contract(x1, v);
+    CHECK(x_vect[0] == x);
+    CHECK(x_vect[1] == x1);
+  }
+}
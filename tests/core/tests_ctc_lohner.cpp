@@ -159,6 +159,99 @@ TEST_CASE("CtcLohner")
     }
   }
 
+  SECTION("Test CtcLohner / Tube - dim 1 - higher orders")
+  {
+    Interval domain(0., 1.);
+    double dt = 0.25;
+    Tube x2(domain, dt), x4(domain, dt);
+    x2.set(1., 0.);
+    x4.set(1., 0.);
+
+    Function f("x", "-x");
+    CtcLohner ctc_lohner(f);
+    CHECK(ctc_lohner.order() == 2);
+    ctc_lohner.contract(x2, TimePropag::FORWARD);
+
+    ctc_lohner.set_order(4);
+    CHECK(ctc_lohner.order() == 4);
+    ctc_lohner.contract(x4, TimePropag::FORWARD);
+
+    CHECK_FALSE(x4.codomain().is_unbounded());
+    CHECK(x4.codomain().is_superset(Interval(exp(-domain.lb())) | exp(-domain.ub())));
+    CHECK(x4(1.).is_superset(Interval(exp(-1))));
+    CHECK(x4(1.).diam() < x2(1.).diam());
+
+    Tube x4_bwd(domain, dt);
+    x4_bwd.set(exp(-1), 1.);
+    ctc_lohner.contract(x4_bwd, TimePropag::BACKWARD);
+    CHECK(x4_bwd(0.).is_superset(Interval(exp(-0.))));
+  }
+
+  SECTION("Test CtcLohner / Tube - dim 1 - adaptive step")
+  {
+    Interval domain(0., 1.);
+    Function f("x", "-x");
+
+    // Slices wider than the integration steps
+    Tube x_coarse(domain, 0.5), x_raw(domain, 0.5);
+    x_coarse.set(1., 0.);
+    x_raw.set(1., 0.);
+    CtcLohner ctc_lohner(f);
+    ctc_lohner.contract(x_raw, TimePropag::FORWARD);
+    ctc_lohner.set_adaptive_step(true, 1e-4);
+    ctc_lohner.contract(x_coarse, TimePropag::FORWARD);
+    CHECK(x_coarse.nb_slices() == 2);
+    CHECK(x_coarse.codomain().is_superset(Interval(exp(-domain.lb())) | exp(-domain.ub())));
+    CHECK(x_coarse(1.).is_superset(Interval(exp(-1))));
+    CHECK(x_coarse(1.).diam() < x_raw(1.).diam());
+
+    // Slices thinner than the integration steps
+    Tube x_fine(domain, 0.001);
+    x_fine.set(exp(-1), 1.);
+    ctc_lohner.contract(x_fine, TimePropag::BACKWARD);
+    CHECK(x_fine.nb_slices() == 1000);
+    CHECK_FALSE(x_fine.codomain().is_unbounded());
+    CHECK(x_fine(0.).is_superset(Interval(exp(-0.))));
+    CHECK(x_fine(0.5).is_superset(Interval(exp(-0.5))));
+
+    // Stiff system, no global enclosure over the slices
+    Tube x_stiff(domain, 0.1);
+    x_stiff.set(1., 0.);
+    CtcLohner ctc_lohner_stiff(Function("x", "-50*x"));
+    ctc_lohner_stiff.set_adaptive_step();
+    ctc_lohner_stiff.contract(x_stiff, TimePropag::FORWARD);
+    CHECK_FALSE(x_stiff.codomain().is_unbounded());
+    CHECK(x_stiff(0.1).is_superset(Interval(exp(-5.))));
+  }
+
+  SECTION("Test CtcLohner / TubeVector - dim 2 - several initial conditions")
+  {
+    Interval domain(0., 1.);
+    TubeVector x(domain, 0.1, 2);
+    vector<IntervalVector> v_x0;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        v_x0.push_back(IntervalVector({Interval(0.5 + i / 4., 0.5 + (i + 1) / 4.), Interval(0.5 + j / 4., 0.5 + (j + 1) / 4.)}));
+
+    Function f("x", "y", "(-x ; y)");
+    CtcLohner ctc_lohner(f);
+    vector<TubeVector> v_x;
+    TubeVector hull = ctc_lohner.propagate(x, v_x0, v_x, TimePropag::FORWARD, 4);
+
+    REQUIRE(v_x.size() == v_x0.size());
+    for (size_t i = 0; i < v_x.size(); ++i) {
+      TubeVector xi(x);
+      xi.set(v_x0[i], 0.);
+      ctc_lohner.contract(xi, TimePropag::FORWARD);
+      CHECK(v_x[i] == xi);
+      CHECK(hull.is_superset(xi));
+    }
+
+    CHECK_FALSE(hull.codomain().is_unbounded());
+    CHECK(hull(1.)[0].is_superset(Interval(0.5, 1.5) * exp(-1.)));
+    CHECK(hull(1.)[1].is_superset(Interval(0.5, 1.5) * exp(1.)));
+  }
+
   SECTION("Test CtcLohner in CN")
   {
     Interval domain(0., 1.);
@@ -216,4 +216,77 @@ TEST_CASE("CtcPicard")
       //vibes::endDrawing();
     }
   }
-}
\ No newline at end of file
+
+  SECTION("Test CtcPicard / TubeVector - dim 2 - preserved slicing")
+  {
+    Interval domain(0.,1.);
+    TubeVector x(domain, 1e-4, 2);
+    x.set(IntervalVector(2, 1.), 0.);
+    REQUIRE(x.nb_slices() == 10000);
+
+    // Previous implementation: contraction of a copy that is sampled
+    // if needed, then projected onto the initial slicing
+    TFunction f("x", "y", "(-x ; y)");
+    CtcPicard ctc_picard_sampling(f, 1.1);
+    ctc_picard_sampling.preserve_slicing(false);
+    auto contract_projected = [&](const TubeVector& x0)
+    {
+      TubeVector x_sampled(x0), x_projected(x0);
+      ctc_picard_sampling.contract(x_sampled, TimePropag::FORWARD);
+      x_projected.set_empty();
+      x_projected |= x_sampled;
+      return x_projected;
+    };
+
+    TubeVector x_projected = contract_projected(x);
+    CtcPicard ctc_picard(f, 1.1);
+    ctc_picard.preserve_slicing(true);
+    ctc_picard.contract(x, TimePropag::FORWARD);
+
+    CHECK(x.nb_slices() == 10000);
+    CHECK(x == x_projected);
+    CHECK_FALSE(x.codomain().is_unbounded());
+    CHECK(x(0.5)[0].is_superset(Interval(exp(-0.5))));
+    CHECK(x(1.)[0].is_superset(Interval(exp(-1.))));
+    CHECK(x(1.)[1].is_superset(Interval(exp(1.))));
+
+    // A single slice, refined locally during the contraction
+    TubeVector y(domain, 2);
+    y.set(IntervalVector(2, 1.), 0.);
+    TubeVector y_projected = contract_projected(y);
+    ctc_picard.contract(y, TimePropag::FORWARD);
+    CHECK(y.nb_slices() == 1);
+    CHECK(y == y_projected);
+    CHECK_FALSE(y.codomain().is_unbounded());
+    CHECK(y(1.)[0].is_superset(Interval(exp(-1.))));
+    CHECK(y(1.)[1].is_superset(Interval(exp(1.))));
+  }
+
+  SECTION("Test CtcPicard / TubeVector - dim 1 - several initial conditions")
+  {
+    Interval domain(0.,1.);
+    TubeVector x(domain, 1);
+    vector<IntervalVector> v_x0;
+    for(int i = 0 ; i < 8 ; i++)
+      v_x0.push_back(IntervalVector(1, Interval(0.5+i/8.,0.5+(i+1)/8.)));
+
+    TFunction f("x", "-x");
+    CtcPicard ctc_picard(f, 1.1);
+    vector<TubeVector> v_x;
+    TubeVector hull = ctc_picard.propagate(x, v_x0, v_x, TimePropag::FORWARD, 4);
+
+    REQUIRE(v_x.size() == v_x0.size());
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+    {
+      TubeVector xi(x);
+      xi.set(v_x0[i], 0.);
+      ctc_picard.contract(xi, TimePropag::FORWARD);
+      CHECK(v_x[i] == xi);
+      CHECK(hull.is_superset(xi));
+    }
+
+    CHECK_FALSE(hull.codomain().is_unbounded());
+    CHECK(hull(0.)[0].is_superset(Interval(0.5,1.5)));
+    CHECK(hull(1.)[0].is_superset(Interval(0.5,1.5)*exp(-1.)));
+  }
+}
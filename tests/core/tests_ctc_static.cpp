@@ -43,6 +43,41 @@ TEST_CASE("CtcStatic")
     CHECK(x[0] == expected);
     CHECK(x[1] == expected);
   }
+
+  SECTION("Test CtcStatic, parallel mode")
+  {
+    double dt = 0.0005; // several blocks of slices
+    Interval tdomain(0., 10.);
+
+    CtcFunction ctc_f(Function("t", "x[2]", "(x[0]-sin(t);x[1]-x[0]^2)"));
+
+    TubeVector x_seq(tdomain, dt, 2);
+    x_seq[1].set(Interval(-0.5,0.8));
+    x_seq[1].set(Interval(0.1,0.2), 5.);
+    TubeVector x_par(x_seq);
+
+    CtcStatic ctc_seq(ctc_f, true);
+    CHECK(ctc_seq.nb_threads() == 1);
+    ctc_seq.contract(x_seq);
+
+    CtcStatic ctc_par(ctc_f, true);
+    ctc_par.set_nb_threads(4);
+    CHECK(ctc_par.nb_threads() == 4);
+    ctc_par.contract(x_par);
+
+    CHECK(x_seq == x_par);
+    CHECK(x_par[0](M_PI/2.).contains(1.));
+
+    TubeVector y_seq(tdomain, dt, 2);
+    TubeVector y_par(y_seq);
+    ctc_seq.restrict_tdomain(Interval(2.,7.));
+    ctc_par.restrict_tdomain(Interval(2.,7.));
+    ctc_seq.contract(y_seq);
+    ctc_par.contract(y_par);
+
+    CHECK(y_seq == y_par);
+    CHECK(y_par[0](1.) == Interval::ALL_REALS);
+  }
 }
 
 TEST_CASE("CtcFunction")
@@ -57,4 +92,40 @@ TEST_CASE("CtcFunction")
     ctc_max.contract(tube);
     CHECK(tube[2].codomain() == Interval(4,5));
   }
+
+  SECTION("Test max tubes, parallel mode")
+  {
+    CtcFunction ctc_max(Function("x1", "x2","x3", "max(x1,x2)-x3"));
+    ctc_max.set_nb_threads(3);
+    TubeVector tube(Interval(0,10), 0.001, 3);
+    tube[0].set(Interval(2,3));
+    tube[1].set(Interval(4,5));
+    tube[1].set(Interval(1,2), Interval(4.,6.));
+    tube[2].set(Interval::ALL_REALS);
+
+    TubeVector expected(tube);
+    CtcFunction(Function("x1", "x2","x3", "max(x1,x2)-x3")).contract(expected);
+
+    ctc_max.contract(tube);
+    CHECK(tube == expected);
+    CHECK(tube[2](5.) == Interval(2,3));
+  }
+
+  SECTION("Test copy of a contractor in parallel mode")
+  {
+    CtcFunction ctc_max(Function("x1", "x2","x3", "max(x1,x2)-x3"));
+    ctc_max.set_nb_threads(3);
+    TubeVector tube(Interval(0,10), 0.001, 3);
+    tube[0].set(Interval(2,3));
+    tube[1].set(Interval(4,5));
+    tube[1].set(Interval(1,2), Interval(4.,6.));
+    tube[2].set(Interval::ALL_REALS);
+    TubeVector tube_copy(tube);
+
+    CtcFunction ctc_copy(ctc_max);
+    ctc_copy.contract(tube_copy);
+    ctc_max.contract(tube);
+    CHECK(tube_copy == tube);
+    CHECK(tube_copy[2](5.) == Interval(2,3));
+  }
 }
\ No newline at end of file
@@ -70,4 +70,22 @@ TEST_CASE("Functions")
     CHECK(f.expr(1) == "cos(x2[2])+x1");
     CHECK(f.expr(2) == "x2[1]");
   }
-}
\ No newline at end of file
+
+  SECTION("Parallel evaluation")
+  {
+    TubeVector x(Interval(0.,10.), 0.001, TFunction("(sin(t)+[-0.01,0.01] ; cos(t))"));
+    TFunction f("x1", "x2", "(t/10.+x1*x2 ; sqrt(sqr(x1)+sqr(x2)))");
+    CHECK(f.nb_threads() == 1);
+
+    TubeVector y_seq(f.eval_vector(x));
+    f.set_nb_threads(4);
+    CHECK(f.nb_threads() == 4);
+    TubeVector y_par(f.eval_vector(x));
+    CHECK(y_par.nb_slices() == x.nb_slices());
+    CHECK(y_par == y_seq);
+
+    f.set_nb_threads(1);
+    CHECK(f.nb_threads() == 1);
+    CHECK(f.eval_vector(x) == y_seq);
+  }
+}
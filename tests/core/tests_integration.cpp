@@ -813,4 +813,66 @@ TEST_CASE("Computing partial integration, two interval bounds", "[core]")
 
     if(TEST_COMPUTATION_TIMES) CHECK(COEFF_COMPUTATION_TIME*t[0] < t[1]);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Synthesis tree maintained along samplings", "[core]")
+{
+  SECTION("Test tube1, sampling and merging with tree synthesis")
+  {
+    Tube tube = tube_test_1();
+    tube.set(Interval(-4,2), 14);
+    Tube tube_ref(tube); // without synthesis
+
+    tube.enable_synthesis(SynthesisMode::BINARY_TREE);
+    CHECK(tube.codomain() == tube_ref.codomain()); // tree values computed before samplings
+    CHECK(ApproxIntv(tube.integral(20.)) == tube_ref.integral(20.));
+
+    // Successive samplings in the same area unbalance the tree
+    for(int i = 0 ; i < 200 ; i++)
+    {
+      double t = 14. + 1. / (i + 2.);
+      tube.sample(t);
+      tube_ref.sample(t);
+    }
+
+    tube.sample(30.25, Interval(-2.,3.));
+    tube_ref.sample(30.25, Interval(-2.,3.));
+    tube.set(Interval(-1.,2.5), 31);
+    tube_ref.set(Interval(-1.,2.5), 31);
+
+    CHECK(tube.nb_slices() == tube_ref.nb_slices());
+    CHECK(tube.nb_slices() == 46 + 201);
+    CHECK(tube == tube_ref);
+    CHECK(tube.codomain() == tube_ref.codomain());
+    CHECK(tube(Interval(13.,16.)) == tube_ref(Interval(13.,16.)));
+    CHECK(tube(Interval(30.,31.2)) == tube_ref(Interval(30.,31.2)));
+    CHECK(tube(30.25) == tube_ref(30.25));
+    CHECK(tube.eval(Interval(14.1,14.7)) == tube_ref.eval(Interval(14.1,14.7)));
+    CHECK(tube.invert(Interval(1.5,2.)) == tube_ref.invert(Interval(1.5,2.)));
+
+    for(double t = 0. ; t < 46. ; t += 0.7)
+    {
+      CHECK(ApproxIntv(tube.integral(t)) == tube_ref.integral(t));
+      CHECK(ApproxIntv(tube.integral(Interval(t/2.,t))) == tube_ref.integral(Interval(t/2.,t)));
+    }
+
+    // Merging slices back
+    tube.remove_gate(30.25);
+    tube_ref.remove_gate(30.25);
+    tube.merge_similar_slices(0.1);
+    tube_ref.merge_similar_slices(0.1);
+
+    CHECK(tube.nb_slices() == tube_ref.nb_slices());
+    CHECK(tube == tube_ref);
+    CHECK(tube.codomain() == tube_ref.codomain());
+    CHECK(tube(Interval(13.,16.)) == tube_ref(Interval(13.,16.)));
+    CHECK(tube.invert(Interval(1.5,2.)) == tube_ref.invert(Interval(1.5,2.)));
+    CHECK(tube.nb_slices() == 46); // slices have been merged back
+
+    for(double t = 0. ; t < 46. ; t += 0.7)
+    {
+      CHECK(ApproxIntv(tube.integral(t)) == tube_ref.integral(t));
+      CHECK(ApproxIntv(tube.integral(Interval(t/2.,t))) == tube_ref.integral(Interval(t/2.,t)));
+    }
+  }
+}
@@ -1,6 +1,10 @@
 #include <cstdio>
+#include <cmath>
 #include "codac_serialize_trajectories.h"
 #include "codac_serialize_tubes.h"
+#include "codac_MappedTube.h"
+#include "codac_TubeWriter.h"
+#include "codac_TubeReader.h"
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
 
@@ -295,4 +299,348 @@ TEST_CASE("(de)serializations on unbounded tubes", "[core]")
     tube.set(Interval::EMPTY_SET);
     CHECK(test_serialization(tube));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("(de)serializations with the version 3", "[core]")
+{
+  SECTION("Previous version still readable")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::EMPTY_SET, 46.);
+    tube1.set(Interval::POS_REALS, 3);
+
+    string filename = "test_serialization_v2.tube";
+    tube1.serialize(filename, 2);
+    Tube tube2(filename);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+  }
+
+  SECTION("Version 2 written by default")
+  {
+    string filename = "test_serialization_default.tube";
+    tube_test_1().serialize(filename);
+
+    ifstream bin_file(filename.c_str(), ios::in | ios::binary);
+    short int version_number;
+    bin_file.read((char*)&version_number, sizeof(short int));
+    bin_file.close();
+    remove(filename.c_str());
+    CHECK(version_number == 2);
+  }
+
+  SECTION("Arrays of values")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::EMPTY_SET, 46.);
+    tube1.set(Interval::ALL_REALS, 5);
+    tube1.set(Interval::NEG_REALS | 2., 6);
+
+    string filename = "test_serialization_v3.tube";
+    tube1.serialize(filename, MAPPED_SERIALIZATION_VERSION);
+    Tube tube2(filename);
+    CHECK(tube1 == tube2);
+    CHECK(tube2(46.) == Interval::EMPTY_SET);
+    CHECK(tube2(5) == Interval::ALL_REALS);
+    CHECK(tube2(6) == (Interval::NEG_REALS | 2.));
+
+    MappedTube mapped_tube(filename);
+    CHECK(mapped_tube.nb_slices() == tube1.nb_slices());
+    CHECK(mapped_tube.tdomain() == tube1.tdomain());
+    CHECK(mapped_tube.codomain() == tube1.codomain());
+
+    for(int i = 0 ; i < tube1.nb_slices() ; i++)
+    {
+      CHECK(mapped_tube.slice_tdomain(i) == tube1.slice(i)->tdomain());
+      CHECK(mapped_tube.slice_codomain(i) == tube1(i));
+      CHECK(mapped_tube.gate(i) == tube1.slice(i)->input_gate());
+      CHECK(mapped_tube.time_to_index(tube1.slice(i)->tdomain().mid()) == i);
+    }
+    CHECK(mapped_tube.gate(tube1.nb_slices()) == tube1.last_slice()->output_gate());
+
+    for(double t = -1. ; t < 47. ; t += 0.5)
+      CHECK(mapped_tube(t) == tube1(t));
+
+    CHECK(mapped_tube(Interval(2.5,17.3)) == tube1(Interval(2.5,17.3)));
+    CHECK(mapped_tube(Interval(3.,14.)) == tube1(Interval(3.,14.)));
+    CHECK(mapped_tube(Interval(-1.,14.)) == Interval::ALL_REALS);
+    CHECK(mapped_tube(Interval::EMPTY_SET) == Interval::EMPTY_SET);
+
+    // Loading a part of the tube only
+    Tube *tube3;
+    mapped_tube.load_tube(tube3, Interval(3.,14.));
+    CHECK(tube3->tdomain() == Interval(3.,14.));
+    CHECK(tube3->nb_slices() == 11);
+    for(const Slice *s = tube3->first_slice() ; s ; s = s->next_slice())
+    {
+      const Slice *s1 = tube1.slice(s->tdomain().mid());
+      CHECK(s->tdomain() == s1->tdomain());
+      CHECK(s->codomain() == s1->codomain());
+      CHECK(s->input_gate() == s1->input_gate());
+      CHECK(s->output_gate() == s1->output_gate());
+    }
+    delete tube3;
+
+    Tube *tube4;
+    mapped_tube.load_tube(tube4);
+    CHECK(*tube4 == tube1);
+    delete tube4;
+
+    CHECK_THROWS(mapped_tube.load_tube(tube4, Interval(50.,60.)););
+    remove(filename.c_str());
+  }
+
+  SECTION("Wrong version")
+  {
+    string filename = "test_serialization_v2.tube";
+    tube_test_1().serialize(filename, 2);
+    CHECK_THROWS(MappedTube(filename););
+    remove(filename.c_str());
+  }
+
+  SECTION("Wrong slices number")
+  {
+    string filename = "test_serialization_v3.tube";
+
+    for(int64_t nb_slices : { (int64_t)1 << 40, (int64_t)1000 })
+    {
+      tube_test_1().serialize(filename, 3);
+      {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        file.seekp(16); // version number, padding, magic string
+        file.write((const char*)&nb_slices, sizeof(int64_t));
+      }
+
+      CHECK_THROWS(Tube(filename););
+      CHECK_THROWS(MappedTube(filename););
+    }
+
+    remove(filename.c_str());
+  }
+}
+
+static long file_size(const string& filename)
+{
+  ifstream file(filename.c_str(), ios::in | ios::binary | ios::ate);
+  return file.tellg();
+}
+
+TEST_CASE("compressed (de)serializations", "[core]")
+{
+  SECTION("Tube")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::EMPTY_SET, 46.);
+    tube1.set(Interval::ALL_REALS, 5);
+    tube1.set(Interval::POS_REALS, 6);
+
+    Trajectory traj1;
+    for(int i = 0 ; i < tube1.nb_slices() ; i++)
+      traj1.set(tube1(i).is_unbounded() ? 1. : tube1(i).mid(), tube1.slice(i)->tdomain().mid());
+
+    string filename = "test_serialization_v4.tube";
+    tube1.serialize(filename, traj1, COMPRESSED_SERIALIZATION_VERSION);
+    Trajectory *traj2;
+    Tube tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(traj1 == *traj2);
+    CHECK(tube2(46.) == Interval::EMPTY_SET);
+    delete traj2;
+  }
+
+  SECTION("TubeVector with a shared slicing")
+  {
+    TubeVector tube1(Interval(0.,10.), 0.01, 12);
+    for(int i = 0 ; i < tube1.size() ; i++)
+      for(Slice *s = tube1[i].first_slice() ; s ; s = s->next_slice())
+        s->set(Interval(-1.,1.) * (i+1) + round(64. * cos(s->tdomain().lb())) / 64.); // quantized values
+    tube1.set(IntervalVector(12, Interval::EMPTY_SET), 10.);
+
+    string filename_v3 = "test_serialization_v3.tube", filename_v4 = "test_serialization_v4.tube";
+    tube1.serialize(filename_v3, 3);
+    tube1.serialize(filename_v4, COMPRESSED_SERIALIZATION_VERSION);
+    CHECK(file_size(filename_v4) < file_size(filename_v3) / 2);
+
+    TubeVector tube2(filename_v4);
+    remove(filename_v3.c_str());
+    remove(filename_v4.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(tube2(10.) == IntervalVector(12, Interval::EMPTY_SET));
+  }
+
+  SECTION("TubeVector with different slicings")
+  {
+    TubeVector tube1(Interval(0.,46.), 1., 3);
+    tube1[1].sample(2.5, Interval(-2.,3.));
+    tube1[2].set(Interval(4.,8.));
+
+    string filename = "test_serialization_v4.tube";
+    tube1.serialize(filename, COMPRESSED_SERIALIZATION_VERSION);
+    TubeVector tube2(filename);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(tube2[1].nb_slices() == 47);
+  }
+
+  SECTION("Wrong numbers of values")
+  {
+    string filename = "test_serialization_v4.tube";
+    int nb_slices = 1 << 30;
+    short int size = 0;
+
+    tube_test_1().serialize(filename, COMPRESSED_SERIALIZATION_VERSION);
+    {
+      fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+      file.seekp(sizeof(short int) + sizeof(int)); // version number, dimension
+      file.write((const char*)&nb_slices, sizeof(int));
+    }
+    CHECK_THROWS(Tube(filename););
+
+    TubeVector(Interval(0.,10.), 1., 2).serialize(filename, COMPRESSED_SERIALIZATION_VERSION);
+    {
+      fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+      file.write((const char*)&size, sizeof(short int)); // dimension of the vector
+    }
+    CHECK_THROWS(TubeVector(filename););
+    remove(filename.c_str());
+  }
+
+  SECTION("TrajectoryVector with shared times")
+  {
+    int n = 3, N = 5000;
+    Eigen::VectorXd t(N);
+    Eigen::MatrixXd x(n, N);
+    for(int k = 0 ; k < N ; k++)
+    {
+      t(k) = k * 0.01;
+      x(0,k) = cos(t(k)); x(1,k) = sin(t(k)); x(2,k) = (k % 10) * 1.;
+    }
+
+    TrajectoryVector traj1(t, x);
+    TubeVector tube1(Interval(0.,(N-1)*0.01), 0.1, n);
+
+    string filename = "test_serialization_v4.tube";
+    tube1.serialize(filename, traj1, COMPRESSED_SERIALIZATION_VERSION);
+    TrajectoryVector *traj2;
+    TubeVector tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(traj2->shared_timebase());
+    CHECK(traj1 == *traj2);
+    delete traj2;
+
+    // Components sampled independently, with the same times
+    TrajectoryVector traj3(n);
+    for(int k = 0 ; k < N ; k++)
+      for(int i = 0 ; i < n ; i++)
+        traj3[i].set(x(i,k), t(k));
+
+    tube1.serialize(filename, traj3, COMPRESSED_SERIALIZATION_VERSION);
+    TrajectoryVector *traj4;
+    TubeVector tube3(filename, traj4);
+    remove(filename.c_str());
+    CHECK(traj3 == *traj4);
+    delete traj4;
+  }
+
+  SECTION("TrajectoryVector with different times")
+  {
+    TrajectoryVector traj1(2);
+    traj1[0].set(1., 0.); traj1[0].set(2., 1.); traj1[0].set(-1., 3.);
+    traj1[1].set(4., 0.); traj1[1].set(5., 3.);
+    TubeVector tube1(Interval(0.,3.), 2);
+
+    string filename = "test_serialization_v4.tube";
+    tube1.serialize(filename, traj1, COMPRESSED_SERIALIZATION_VERSION);
+    TrajectoryVector *traj2;
+    TubeVector tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(traj1 == *traj2);
+    delete traj2;
+  }
+}
+
+TEST_CASE("tube log files", "[core]")
+{
+  SECTION("Slices appended during the computation")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::EMPTY_SET, 46.);
+    string filename = "test_tube_log.log";
+
+    {
+      TubeWriter writer(filename, false, 4, 2);
+      CHECK(writer.write(tube1, 10.) == 10);
+      CHECK(writer.nb_slices() == 10);
+      CHECK(writer.tdomain() == Interval(0.,10.));
+
+      TubeReader reader(filename);
+      CHECK(reader.nb_slices() == 8); // two slices not flushed yet
+      CHECK(reader.tdomain() == Interval(0.,8.));
+
+      CHECK(writer.write(tube1, 20.5) == 10);
+      CHECK(reader.update());
+      CHECK(reader.nb_slices() == 20);
+      CHECK_FALSE(reader.update());
+
+      Tube *tube2;
+      reader.load_tube(tube2, Interval(3.,14.));
+      CHECK(tube2->tdomain() == Interval(3.,14.));
+      CHECK(tube2->nb_slices() == 11);
+      for(const Slice *s = tube2->first_slice() ; s ; s = s->next_slice())
+      {
+        CHECK(s->codomain() == tube1(tube1.time_to_index(s->tdomain().mid())));
+        CHECK(s->input_gate() == tube1(s->tdomain().lb()));
+      }
+      delete tube2;
+
+      CHECK_THROWS(writer.write(*tube1.slice(30)););
+      CHECK(writer.write(tube1) == 26);
+    }
+
+    TubeReader reader(filename);
+    CHECK(reader.nb_slices() == 46);
+
+    Tube *tube3;
+    reader.load_tube(tube3);
+    CHECK(*tube3 == tube1);
+    CHECK((*tube3)(46.) == Interval::EMPTY_SET);
+    delete tube3;
+    remove(filename.c_str());
+  }
+
+  SECTION("Recovery after a crash")
+  {
+    Tube tube1 = tube_test_1();
+    string filename = "test_tube_log.log";
+
+    {
+      TubeWriter writer(filename, false, 4, 2);
+      writer.write(tube1, 21.);
+    }
+
+    // Incomplete record at the end of the file
+    {
+      ofstream file(filename.c_str(), ios::out | ios::binary | ios::app);
+      uint32_t header[2] = { 1, 64 };
+      file.write((const char*)header, sizeof(header));
+      file.write("incomplete", 10);
+    }
+
+    CHECK(TubeReader(filename).nb_slices() == 21);
+
+    {
+      TubeWriter writer(filename, true, 4, 2);
+      CHECK(writer.nb_slices() == 21);
+      CHECK(writer.write(tube1) == 25);
+    }
+
+    TubeReader reader(filename);
+    Tube *tube2;
+    reader.load_tube(tube2);
+    CHECK(*tube2 == tube1);
+    delete tube2;
+    remove(filename.c_str());
+  }
+}
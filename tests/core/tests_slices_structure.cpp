@@ -1,5 +1,6 @@
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
+#include "codac_MemoryPool.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -55,6 +56,105 @@ TEST_CASE("time_to_index")
     CHECK(tube.index(tube.first_slice()) == 0);
     CHECK(tube.index(tube.last_slice()) == 45);
   }
+
+  SECTION("index maintained along structural changes")
+  {
+    // Checks the slices index against a walk over the list of slices
+    auto check_index = [](const Tube& x)
+    {
+      int k = 0;
+      for(const Slice *s = x.first_slice() ; s ; s = s->next_slice(), k++)
+      {
+        CHECK(x.slice(k) == s);
+        CHECK(x.index(s) == k);
+        CHECK(x.slice(s->tdomain().lb()) == s);
+        CHECK(x.slice(s->tdomain().mid()) == s);
+        CHECK(x.time_to_index(s->tdomain().mid()) == k);
+        if(s->next_slice() == nullptr)
+          CHECK(x.last_slice() == s);
+      }
+      CHECK(x.nb_slices() == k);
+    };
+
+    Tube x(Interval(0.,10.), 0.1); // uniform sampling, last slice may be smaller
+    int n = x.nb_slices();
+    CHECK(n >= 100);
+    check_index(x);
+    CHECK(x.time_to_index(10.) == n-1);
+    CHECK(x.slice(10.) == x.last_slice());
+
+    x.sample(2.05);
+    x.sample(2.05); // no effect
+    x.sample(7.123);
+    CHECK(x.nb_slices() == n+2);
+    check_index(x);
+    CHECK(x.slice(2.05)->tdomain().lb() == 2.05);
+    CHECK(x.slice(ibex::previous_float(2.05))->tdomain().ub() == 2.05);
+
+    x.remove_gate(2.05);
+    CHECK(x.nb_slices() == n+1);
+    check_index(x);
+
+    x.set(Interval(-1.,1.));
+    x.merge_similar_slices(0.1);
+    CHECK(x.nb_slices() == 1);
+    check_index(x);
+    x.sample(5., Interval(0.));
+    CHECK(x.nb_slices() == 2);
+    check_index(x);
+
+    Tube y(Interval(0.,10.), 0.5);
+    y.truncate_tdomain(Interval(1.2,6.7));
+    CHECK(y.nb_slices() == 12);
+    check_index(y);
+    y.shift_tdomain(-1.2);
+    check_index(y);
+    CHECK(y.time_to_index(0.) == 0);
+    CHECK(y.time_to_index(0.4) == 1);
+
+    Tube z(y);
+    check_index(z);
+    CHECK(z.slice(-1) == nullptr);
+    CHECK(z.slice(z.nb_slices()) == nullptr);
+    CHECK(z.index(y.first_slice()) == -1);
+  }
+
+  SECTION("uniform timestep")
+  {
+    Tube x(Interval(0.,10.), 0.1);
+    CHECK(x.uniform_timestep() == 0.1);
+    for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+    {
+      CHECK(x.slice(s->tdomain().lb()) == s);
+      CHECK(x.slice(ibex::previous_float(s->tdomain().ub())) == s);
+    }
+    CHECK(x.slice(10.) == x.last_slice());
+
+    Tube y(Interval(0.,10.), 0.1, Interval(-1.,1.)), z(x);
+    CHECK(Tube::same_slicing(x, y));
+    CHECK(Tube::same_slicing(x, z));
+    CHECK(z.uniform_timestep() == 0.1);
+    CHECK_FALSE(Tube::same_slicing(x, Tube(Interval(0.,10.), 0.2)));
+    CHECK_FALSE(Tube::same_slicing(x, Tube(Interval(0.,10.5), 0.1)));
+
+    y.sample(2.05);
+    CHECK(y.uniform_timestep() == 0.);
+    CHECK_FALSE(Tube::same_slicing(x, y));
+    CHECK(y.slice(2.05)->tdomain().lb() == 2.05);
+    CHECK(y.slice(ibex::previous_float(2.05))->tdomain().ub() == 2.05);
+    CHECK(y.slice(9.95) == y.last_slice());
+
+    y.remove_gate(2.05);
+    CHECK(y.nb_slices() == x.nb_slices());
+    CHECK(Tube::same_slicing(x, y)); // comparison of the slices
+
+    Tube w(Interval(0.,10.), 0.5);
+    w.shift_tdomain(3.);
+    CHECK(w.uniform_timestep() == 0.5);
+    CHECK(w.time_to_index(3.) == 0);
+    CHECK(w.time_to_index(3.5) == 1);
+    CHECK(w.time_to_index(13.) == 19);
+  }
 }
 
 TEST_CASE("Tube slices structure")
@@ -403,3 +503,65 @@ TEST_CASE("Tube slices structure")
     CHECK(tube[0].slice(0)->tdomain() == Interval(8.2,8.3));
   }
 }
+
+TEST_CASE("Slices memory storage")
+{
+  SECTION("MemoryPool, blocks reuse")
+  {
+    MemoryPool pool(sizeof(double), alignof(double));
+    CHECK(pool.nb_allocated_blocks() == 0);
+
+    vector<double*> v;
+    for(size_t i = 0 ; i < 2*pool.chunk_capacity() + 10 ; i++)
+    {
+      v.push_back(static_cast<double*>(pool.allocate()));
+      *v.back() = i;
+    }
+
+    CHECK(pool.nb_allocated_blocks() == v.size());
+    CHECK(v[1] == v[0] + 1); // contiguous blocks
+    CHECK(v[2] == v[1] + 1);
+    for(size_t i = 0 ; i < v.size() ; i++)
+      CHECK(*v[i] == i);
+
+    void *ptr = v[5];
+    pool.deallocate(v[5]);
+    v[5] = static_cast<double*>(pool.allocate());
+    CHECK(v[5] == ptr); // released block is reused first
+
+    for(size_t i = 0 ; i < v.size() ; i++)
+      pool.deallocate(v[i]);
+    CHECK(pool.nb_allocated_blocks() == 0);
+
+    pool.deallocate(nullptr);
+    CHECK(pool.nb_allocated_blocks() == 0);
+  }
+
+  SECTION("Slices of a tube")
+  {
+    Tube x(Interval(0.,128.), 0.125, Interval(-1.,1.));
+    CHECK(x.nb_slices() == 1024);
+
+    int nb_adjacent = 0;
+    for(const Slice *s = x.first_slice() ; s->next_slice() ; s = s->next_slice())
+      if(s->next_slice() == s + 1)
+        nb_adjacent++;
+    CHECK(nb_adjacent > 1000); // slices built in a row are side by side in memory
+
+    x.sample(5.0625);
+    x.sample(0.0625, Interval(0.5));
+    CHECK(x.nb_slices() == 1026);
+    CHECK(x(0.0625) == Interval(0.5));
+    CHECK(x.slice(1)->input_gate() == Interval(0.5));
+    CHECK(x.slice(0)->output_gate() == Interval(0.5));
+
+    x.merge_similar_slices(0.1);
+    CHECK(x.nb_slices() < 1026);
+    CHECK(x.codomain() == Interval(-1.,1.));
+
+    Tube y(x);
+    CHECK(x == y);
+    y = Tube(Interval(0.,1.), 0.125);
+    CHECK(y.nb_slices() == 8);
+  }
+}
@@ -184,4 +184,242 @@ TEST_CASE("Trajectory base")
     CHECK(test1 == test2);
     CHECK(test1[0] == test2[0]);
   }
-}
\ No newline at end of file
+
+  SECTION("Sorted values and batched evaluation")
+  {
+    Trajectory traj;
+    traj.set(1., 0.);
+    traj.set(-1., 2.);
+    traj.set(4., 8.);
+    traj.set(1., 14.);
+    traj.set(1., 6.); // values not set by increasing times
+    traj.set(2., 7.);
+    traj.set(-2., 11.);
+    traj.set(4., 10.);
+    traj.set(3., 8.); // existing key
+
+    CHECK(traj.sampled_times() == vector<double>({0.,2.,6.,7.,8.,10.,11.,14.}));
+    CHECK(traj.sampled_values() == vector<double>({1.,-1.,1.,2.,3.,4.,-2.,1.}));
+    CHECK(traj.sampled_map().size() == 8);
+    CHECK(traj.sampled_map().at(8.) == 3.);
+    CHECK(traj.codomain() == Interval(-2.,4.));
+
+    traj.set(0., 11.); // replaced lower bound of the codomain
+    CHECK(traj.codomain() == Interval(-1.,4.));
+    traj.set(-2., 11.);
+    traj.set(2.5, 7.); // replaced value inside the codomain
+    CHECK(traj.codomain() == Interval(-2.,4.));
+    traj.set(2., 7.);
+
+    traj.set(5., 12.);
+    CHECK(traj.sampled_map().size() == 9); // map updated from the sorted values
+    CHECK(traj.sampled_map().at(12.) == 5.);
+
+    vector<double> v_t({0.,1.,4.,7.5,9.,13.,14.,3.,0.5});
+    vector<double> v_x = traj.eval(v_t);
+    REQUIRE(v_x.size() == v_t.size());
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+      CHECK(v_x[i] == traj(v_t[i]));
+    CHECK(v_x[1] == 0.);
+    CHECK(v_x[3] == 2.5);
+    CHECK(v_x[6] == 1.);
+
+    Trajectory traj_fnc(Interval(0.,10.), TFunction("t^2"));
+    v_t = vector<double>({0.,5.,10.});
+    v_x = traj_fnc.eval(v_t);
+    CHECK(Approx(v_x[1]) == 25.);
+
+    // Large trajectory, evaluated by sorted and unsorted times
+    Trajectory traj_large;
+    for(int i = 0 ; i <= 10000 ; i++)
+      traj_large.set(std::sin(i*0.01), i*0.01);
+
+    v_t.clear();
+    for(int i = 0 ; i < 20000 ; i++)
+      v_t.push_back(i*0.005);
+    v_t.push_back(100.);
+    v_t.push_back(50.);
+    v_t.push_back(2.);
+    v_x = traj_large.eval(v_t);
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+      CHECK(v_x[i] == traj_large(v_t[i]));
+  }
+
+  SECTION("Range evaluation of a long trajectory")
+  {
+    Trajectory traj;
+    for(int i = 0 ; i <= 5000 ; i++)
+      traj.set(std::cos(i*0.01) + 0.001*(i%7), i*0.01);
+
+    // Reference: linear scan over the samples of the window
+    auto hull = [](const Trajectory& x, const Interval& t)
+    {
+      Interval h = Interval(x(t.lb())) | x(t.ub());
+      for(size_t i = 0 ; i < x.sampled_times().size() ; i++)
+        if(t.contains(x.sampled_times()[i]))
+          h |= x.sampled_values()[i];
+      return h;
+    };
+
+    for(double t = 0. ; t < 49. ; t += 0.37)
+      for(double dt : {0.005, 0.5, 3.3, 20.})
+      {
+        Interval w(t, std::min(50., t+dt));
+        CHECK(traj(w) == hull(traj, w));
+      }
+
+    // Appended values are taken into account by the index
+    for(int i = 5001 ; i <= 6000 ; i++)
+      traj.set(i == 5500 ? 10. : std::cos(i*0.01), i*0.01);
+    CHECK(traj(Interval(40.,58.)) == hull(traj, Interval(40.,58.)));
+    CHECK(traj(Interval(40.,58.)).ub() == 10.);
+    CHECK(traj(Interval(1.,60.)).ub() == 10.);
+
+    // Other updates
+    traj.set(-10., 30.);
+    CHECK(traj(Interval(1.,49.)).lb() == -10.);
+    traj.set(0., 30.);
+    CHECK(traj(Interval(1.,49.)) == hull(traj, Interval(1.,49.)));
+    traj *= 2.;
+    CHECK(traj(Interval(1.,59.)) == hull(traj, Interval(1.,59.)));
+    CHECK(traj(Interval(1.,59.)).ub() == 20.);
+  }
+
+  SECTION("Trajectory vector with a shared time base")
+  {
+    Eigen::VectorXd t(5);
+    t << 0., 1., 2., 4., 5.;
+    Eigen::MatrixXd m(2,5); // one column per sample
+    m << 0., 1., 2., 3., 4.,
+         5., 4., -1., 2., 0.;
+
+    TrajectoryVector x(t, m);
+    CHECK(x.shared_timebase());
+    CHECK(x.size() == 2);
+    CHECK(x.tdomain() == Interval(0.,5.));
+    CHECK(x.codomain() == IntervalVector({Interval(0.,4.),Interval(-1.,5.)}));
+    CHECK(x.first_value() == Vector({0.,5.}));
+    CHECK(x.last_value() == Vector({4.,0.}));
+    CHECK(x(1.5) == Vector({1.5,1.5}));
+    CHECK(x(3.) == Vector({2.5,0.5}));
+    CHECK(x(Interval(0.5,3.)) == IntervalVector({Interval(0.5,2.5),Interval(-1.,4.5)}));
+    CHECK(x.sampled_values()(1,2) == -1.);
+
+    // Components built on demand, with the same evaluations
+    const TrajectoryVector& x_const = x;
+    CHECK(x_const[1].sampled_times() == vector<double>({0.,1.,2.,4.,5.}));
+    CHECK(x_const[1](3.) == x(3.)[1]);
+    CHECK(x.shared_timebase());
+
+    x.set(Vector({6.,6.}), 6.);
+    x.set(Vector({-1.,1.}), 3.);
+    CHECK(x.tdomain() == Interval(0.,6.));
+    CHECK(x.codomain() == IntervalVector({Interval(-1.,6.),Interval(-1.,6.)}));
+    CHECK(x(3.) == Vector({-1.,1.}));
+    CHECK(x_const[0](3.) == -1.);
+
+    // Zero-copy view of the matrices
+    TrajectoryVector x_view(t, m, true);
+    CHECK(x_view.sampled_values().data() == m.data());
+    m(0,4) = 10.;
+    CHECK(x_view.last_value() == Vector({10.,0.}));
+    x_view.set(Vector({1.,1.}), 4.5); // data copied before modification
+    CHECK(x_view.sampled_values().data() != m.data());
+    CHECK(m(0,4) == 10.);
+    CHECK(x_view(4.5) == Vector({1.,1.}));
+
+    // Sharing the time axis of independent components
+    TrajectoryVector y(2);
+    y[0].set(0.,0.); y[0].set(2.,2.);
+    y[1].set(1.,0.); y[1].set(3.,1.); y[1].set(1.,2.);
+    CHECK(!y.shared_timebase());
+    y.share_timebase();
+    CHECK(y.shared_timebase());
+    CHECK(y.sampled_times().size() == 3);
+    CHECK(y(1.) == Vector({1.,3.}));
+    CHECK(y(0.5) == Vector({0.5,2.}));
+
+    // Long ranges, evaluated on the shared values
+    Eigen::VectorXd t_z(1000);
+    Eigen::MatrixXd m_z(2,1000);
+    for(int k = 0 ; k < 1000 ; k++)
+    {
+      t_z(k) = k;
+      m_z(0,k) = k % 7; m_z(1,k) = -(k % 13);
+    }
+    TrajectoryVector z(t_z, m_z);
+    CHECK(z(Interval(10.,900.)) == IntervalVector({Interval(0.,6.),Interval(-12.,0.)}));
+    CHECK(z(Interval(10.5,12.5)) == IntervalVector({Interval(3.5,5.5),Interval(-12.,-6.)}));
+    CHECK(z.shared_timebase());
+
+    // Modifiable components: independent trajectories, explicitly
+    CHECK_THROWS(y[0].set(5.,1.));
+    CHECK(y.shared_timebase());
+    y.unshare_timebase();
+    y[0].set(5.,1.);
+    CHECK(!y.shared_timebase());
+    CHECK(y(1.) == Vector({5.,3.}));
+
+    y.share_timebase();
+    y.shift_tdomain(1.);
+    CHECK(y.shared_timebase());
+    CHECK(y.tdomain() == Interval(1.,3.));
+    CHECK(y(2.) == Vector({5.,3.}));
+  }
+
+  SECTION("Arithmetic on a trajectory vector with a shared time base")
+  {
+    Eigen::VectorXd t(4);
+    t << 0., 1., 2., 3.;
+    Eigen::MatrixXd m(2,4);
+    m << 1., 2., -1., 4.,
+         2., 0., 3., 1.;
+
+    TrajectoryVector x(t, m), x_indep(x);
+    x_indep.unshare_timebase();
+    CHECK(x == x_indep);
+
+    Vector v({1.,-2.});
+    Trajectory a(list<double>({0.,1.,2.,3.}), list<double>({1.,2.,4.,8.})); // same sampling
+    Trajectory b(list<double>({0.,3.}), list<double>({1.,3.})); // other sampling
+
+    // Operators processed on the shared values
+    CHECK((x + v) == (x_indep + v));
+    CHECK((x + v).shared_timebase());
+    CHECK((v - x) == (v - x_indep));
+    CHECK((v - x).shared_timebase());
+    CHECK((x - x) == (x_indep - x_indep));
+    CHECK((x - x).shared_timebase());
+    CHECK((-x) == (-x_indep));
+    CHECK((-x).shared_timebase());
+    CHECK((2.*x) == (2.*x_indep));
+    CHECK((a*x) == (a*x_indep));
+    CHECK((a*x).shared_timebase());
+    CHECK((x/4.) == (x_indep/4.));
+    CHECK((x/a) == (x_indep/a));
+
+    // Operators processed after an unsharing, as the samplings are different
+    CHECK((b*x) == (b*x_indep));
+    CHECK(!(b*x).shared_timebase());
+    CHECK((x + x_indep) == (x_indep + x_indep));
+
+    TrajectoryVector y(x), y_indep(x_indep);
+    y += 1.; y_indep += 1.;
+    y -= v; y_indep -= v;
+    y *= a; y_indep *= a;
+    y /= 2.; y_indep /= 2.;
+    y -= x; y_indep -= x_indep;
+    CHECK(y.shared_timebase());
+    CHECK(y == y_indep);
+    CHECK(y.codomain() == y_indep.codomain());
+    y /= b; y_indep /= b;
+    CHECK(!y.shared_timebase());
+    CHECK(y == y_indep);
+
+    // Copies of a view own their data
+    TrajectoryVector x_view(t, m, true);
+    TrajectoryVector x_copy(x_view);
+    CHECK(x_copy.sampled_values().data() != m.data());
+    CHECK(x_copy == x_view);
+  }
+}
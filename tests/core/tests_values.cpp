@@ -825,6 +825,83 @@ TEST_CASE("Testing volume()")
     CHECK_FALSE(bounded_tube.codomain().is_unbounded());
     CHECK(Approx(bounded_tube.volume()) == 20.);
   }
+
+  SECTION("Tube, incremental updates")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-1.,1.));
+    CHECK(x.volume() == 20.);
+    CHECK(x.gates_volume() == 22.);
+
+    x.slice(3)->set_envelope(Interval(0.,1.));
+    CHECK(x.volume() == 19.);
+    CHECK(x.gates_volume() == 20.);
+
+    x.slice(0)->set_input_gate(Interval(0.));
+    x.slice(9)->set_output_gate(Interval(1.));
+    CHECK(x.gates_volume() == 16.);
+
+    x.slice(5)->set_envelope(Interval::POS_REALS);
+    CHECK(x.volume() == POS_INFINITY);
+    x.slice(5)->set_envelope(Interval(0.,0.5));
+    CHECK(x.volume() == 17.5);
+
+    x.sample(5.5);
+    CHECK(x.nb_slices() == 11);
+    CHECK(x.volume() == 17.5);
+    x.slice(6)->set_envelope(Interval(0.,0.25));
+    CHECK(x.volume() == 17.375);
+
+    x.remove_gate(5.5);
+    CHECK(x.nb_slices() == 10);
+    CHECK(x.volume() == 17.5);
+
+    // Many contractions: the running sums must remain consistent
+    for(int k = 0 ; k < 200 ; k++)
+      x.slice(k%10)->set_envelope(x.slice(k%10)->codomain().mid() + 0.98*(x.slice(k%10)->codomain() - x.slice(k%10)->codomain().mid()));
+
+    double vol = 0., gates_vol = x.first_slice()->input_gate().diam();
+    for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+    {
+      vol += s->volume();
+      gates_vol += s->output_gate().diam();
+    }
+
+    CHECK(x.volume() == Approx(vol));
+    CHECK(x.gates_volume() == Approx(gates_vol));
+  }
+
+  SECTION("Tube, long run of incremental updates")
+  {
+    Tube x(Interval(0.,10.), 1./64., Interval(-1.,1.));
+    CHECK(x.nb_slices() == 640);
+
+    // Many small contractions, between two volume requests or not
+    for(int k = 0 ; k < 100000 ; k++)
+    {
+      Slice *s = x.slice((k*7919)%640);
+      s->set_envelope(Interval(s->codomain().lb() + 1e-6, s->codomain().ub()));
+      if(k%3 == 0)
+        x.volume();
+    }
+
+    double vol = 0.;
+    for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+      vol += s->volume();
+    CHECK(x.volume() == Approx(vol).epsilon(1e-12));
+
+    // Slices set again with the same values: no variation of volume at all,
+    // as expected by fixed-point tests with a ratio of 0
+    double prev_vol = x.volume(), prev_gates_vol = x.gates_volume();
+    bool same_volumes = true;
+    for(int k = 0 ; k < 10000 ; k++)
+    {
+      Slice *s = x.slice(k%640);
+      s->set_envelope(s->codomain());
+      s->set_input_gate(s->input_gate());
+      same_volumes &= x.volume() == prev_vol && x.gates_volume() == prev_gates_vol;
+    }
+    CHECK(same_volumes);
+  }
 }
 
 TEST_CASE("Interpol")